@@ -0,0 +1,478 @@
+//
+// File:        cordic_client.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Pipelined host client for the CORDIC-UART device (see cordic_client.h).
+//
+
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cordic_gref_const.h"
+#include "cordic_gref.h"
+#include "cordic_crc8.h"
+#include "cordic_stream.h"
+#include "cordic_client.h"
+
+typedef std::chrono::steady_clock clk;
+
+static const int    BURST_MAX           = 8;            // largest burst cnt uart_rx_msg is verified for
+static const int    LATENCY_BUCKETS     = 200000;       // 1 us buckets, the last one is overflow
+static const double DRAIN_QUIET_SEC     = 0.05;         // silence needed before a failed batch is over
+static const int    BITS_PER_BYTE       = 11;           // start, 8 data, parity, stop
+static const double SELFTEST_MIN_RATE   = 50e6;         // angles/sec assumed when timing out a self-test
+
+/* One BURST, STREAM or SELFTEST message waiting for its response */
+struct client_pending_t {
+    unsigned char   cmd;
+    int             num_theta;
+    long long*      cos_theta;
+    long long*      sin_theta;
+    clk::time_point sent;
+    double          timeout_sec;
+    unsigned int*   signature;      // SELFTEST results
+    long long*      cycles;
+};
+
+struct cordic_client_t {
+    cordic_client_cfg_t             cfg;
+    int                             fd;
+    std::thread                     rx_thread;
+    std::atomic<bool>               stop;
+
+    std::mutex                      mtx;
+    std::condition_variable         cv;
+    std::deque<client_pending_t>    inflight;
+    bool                            failed;         // current batch lost a response
+    bool                            draining;       // late responses of a failed batch are expected
+    bool                            resync;         // restart the response decoder from a header hunt
+    clk::time_point                 last_rx;
+    cordic_client_stats_t           stats;
+    std::vector<unsigned long long> latency_hist;
+    unsigned char                   mode;           // CMD_STREAM_TRANS mode byte
+    std::vector<unsigned char>      msg;            // request being built
+    clk::time_point                 dev_tx_free;    // when the device's TX FIFO would run empty
+};
+
+void cordic_client_cfg_init(cordic_client_cfg_t* cfg) {
+    cfg->port           = NULL;
+    cfg->baud           = 3000000;
+    cfg->window         = 8;
+    cfg->burst          = BURST_MAX;
+    cfg->timeout_sec    = 1.0;
+    cfg->stream         = 0;
+    cfg->theta_bits     = 48;
+    cfg->result_bits    = 48;
+    cfg->round          = false;
+    cfg->pace           = true;
+    cfg->tx_fifo_depth  = TX_FIFO_DEPTH;
+}
+
+/* CMD_STREAM_TRANS width field for 16/24/32/48 bits, or -1 */
+static int stream_width(int bits) {
+    switch (bits) {
+        case 16:    return STREAM_WIDTH_16;
+        case 24:    return STREAM_WIDTH_24;
+        case 32:    return STREAM_WIDTH_32;
+        case 48:    return STREAM_WIDTH_48;
+        default:    return -1;
+    }
+}
+
+static speed_t baud_to_speed(int baud) {
+    switch (baud) {
+        case 9600:      return B9600;
+        case 115200:    return B115200;
+        case 230400:    return B230400;
+        case 460800:    return B460800;
+        case 921600:    return B921600;
+        case 1000000:   return B1000000;
+        case 2000000:   return B2000000;
+        case 3000000:   return B3000000;
+        default:        return B0;
+    }
+}
+
+/* n little-endian bytes holding the top of a 48-bit value, back to the full sign-extended value */
+static inline long long sign_extend_48(const unsigned char* b, int n = 6) {
+    unsigned long long v = 0;
+    for (int i = n - 1; i >= 0; i--)
+        v = (v << 8) | b[i];
+    return (long long)(v << (64 - 8*n)) >> 16;
+}
+
+/* Matches one response to the oldest message in flight. Called with mtx held. */
+static void on_response(cordic_client_t* c, const cordic_frame_t& frame) {
+    if (c->inflight.empty()) {
+        if (!c->draining)
+            c->stats.bad_responses++;
+        return;
+    }
+    client_pending_t req = c->inflight.front();
+    c->inflight.pop_front();
+
+    if (frame.status == CORDIC_FRAME_CRC_ERR) {
+        c->stats.crc_errors++;
+        c->failed = true;
+    } else if (frame.status != CORDIC_FRAME_OK || frame.cmd != req.cmd
+               || (req.cmd == CMD_STREAM_TRANS && frame.mode != c->mode) || frame.num_theta != req.num_theta) {
+        c->stats.bad_responses++;
+        c->failed = true;
+    } else if (req.cmd == CMD_SELFTEST) {
+        unsigned int sig = 0;
+        long long cyc = 0;
+        for (int i = 3; i >= 0; i--)
+            sig = (sig << 8) | frame.payload[i];
+        for (int i = 5; i >= 0; i--)
+            cyc = (cyc << 8) | frame.payload[4 + i];
+        *req.signature  = sig;
+        *req.cycles     = cyc;
+    } else {
+        int n = c->cfg.stream ? stream_result_bytes(c->mode) : 6;
+        for (int k = 0; k < req.num_theta; k++) {
+            req.cos_theta[k] = sign_extend_48(frame.payload + 2*n*k, n);
+            req.sin_theta[k] = sign_extend_48(frame.payload + 2*n*k + n, n);
+        }
+        long long us = std::chrono::duration_cast<std::chrono::microseconds>(clk::now() - req.sent).count();
+        c->latency_hist[std::min<long long>(us, LATENCY_BUCKETS - 1)]++;
+        c->stats.msgs++;
+        c->stats.angles += req.num_theta;
+    }
+}
+
+static void rx_loop(cordic_client_t* c) {
+    cordic_stream_t stream;
+    cordic_stream_init(&stream, CORDIC_STREAM_TX);
+    unsigned char buf[4096];
+
+    while (!c->stop) {
+        struct pollfd pfd = { c->fd, POLLIN, 0 };
+        if (poll(&pfd, 1, 50) <= 0)
+            continue;
+        ssize_t len = read(c->fd, buf, sizeof(buf));
+        if (len <= 0)
+            continue;
+
+        const unsigned char* p = buf;
+        const unsigned char* end = buf + len;
+        cordic_frame_t frame;
+        std::lock_guard<std::mutex> lock(c->mtx);
+        c->last_rx = clk::now();
+        if (c->resync) {
+            cordic_stream_init(&stream, CORDIC_STREAM_TX);
+            c->resync = false;
+        }
+        while (cordic_stream_next(&stream, &p, end, &frame))
+            on_response(c, frame);
+        c->cv.notify_all();
+    }
+}
+
+cordic_client_t* cordic_client_open(const cordic_client_cfg_t* cfg) {
+    if (cfg->burst < 1 || cfg->burst > BURST_MAX || cfg->window < 1) {
+        fprintf(stderr, "cordic_client: burst must be within [1,%d] and window at least 1\n", BURST_MAX);
+        return NULL;
+    }
+    if (cfg->stream < 0 || cfg->stream > STREAM_MAX_CNT
+        || stream_width(cfg->theta_bits) < 0 || stream_width(cfg->result_bits) < 0) {
+        fprintf(stderr, "cordic_client: stream must be within [0,%d] and widths 16, 24, 32 or 48\n", STREAM_MAX_CNT);
+        return NULL;
+    }
+    int fd = open(cfg->port, O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        perror(cfg->port);
+        return NULL;
+    }
+
+    // Raw 8O1, as the Python client and the RTL UART use
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tio.c_cflag |= CLOCAL | CREAD | PARENB | PARODD;
+        tio.c_cflag &= ~CSTOPB;
+        speed_t speed = baud_to_speed(cfg->baud);
+        if (speed != B0)
+            cfsetspeed(&tio, speed);
+        else
+            fprintf(stderr, "cordic_client: unsupported baud rate %d, keeping the port's\n", cfg->baud);
+        // Linux ptys can refuse high non-standard speeds. A pty has no line rate, so fall back to a
+        // standard one there.
+        int rc = tcsetattr(fd, TCSANOW, &tio);
+        const char* name = ttyname(fd);
+        if (rc && name && !strncmp(name, "/dev/pts/", 9)) {
+            cfsetspeed(&tio, B38400);
+            rc = tcsetattr(fd, TCSANOW, &tio);
+        }
+        if (rc)
+            perror(cfg->port);
+        tcflush(fd, TCIOFLUSH);
+    }
+
+    cordic_client_t* c = new cordic_client_t;
+    c->cfg          = *cfg;
+    c->fd           = fd;
+    c->stop         = false;
+    c->failed       = false;
+    c->draining     = false;
+    c->resync       = false;
+    c->last_rx      = clk::now();
+    memset(&c->stats, 0, sizeof(c->stats));
+    c->latency_hist.assign(LATENCY_BUCKETS, 0);
+    c->mode         = 0;
+    if (cfg->stream)
+        c->mode     = (unsigned char)(stream_width(cfg->result_bits) | (cfg->round ? STREAM_MODE_ROUND : 0)
+                                      | (stream_width(cfg->theta_bits) << STREAM_MODE_THETA_SHIFT));
+    c->msg.resize(cfg->stream ? 5 + 6*cfg->stream + 1 : 3 + 6*BURST_MAX + 1);
+    c->dev_tx_free  = clk::now();
+    c->rx_thread    = std::thread(rx_loop, c);
+    return c;
+}
+
+void cordic_client_close(cordic_client_t* c) {
+    if (!c)
+        return;
+    c->stop = true;
+    c->rx_thread.join();
+    close(c->fd);
+    delete c;
+}
+
+static bool write_all(int fd, const unsigned char* p, size_t len) {
+    while (len) {
+        ssize_t n = write(fd, p, len);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p   += n;
+        len -= n;
+    }
+    return true;
+}
+
+/* Writes one request of m angles without filling the device's TX FIFO. The device queues the
+   response header with the first angle, resp_unit bytes per angle as each one arrives and the
+   crc at the end, and sends them at the line rate, so the request is written in slices that keep
+   the modelled backlog below the level where the pipelines hold (tx_fifo_depth less
+   TX_FIFO_MARGIN). A held pipeline keeps up to TX_SKID_DEPTH more angles waiting and drops
+   the rest. */
+static bool write_paced(cordic_client_t* c, const unsigned char* msg, size_t len, int m,
+                        size_t hdr_len, size_t req_unit, size_t resp_unit) {
+    if (!c->cfg.pace)
+        return write_all(c->fd, msg, len);
+
+    const double byte_sec = BITS_PER_BYTE / (double)c->cfg.baud;
+    const double budget = c->cfg.tx_fifo_depth - TX_FIFO_MARGIN;
+    size_t pos = 0;
+    int k = 0;                  // angles written so far
+    while (pos < len) {
+        clk::time_point now = clk::now();
+        double backlog = std::max(0.0, std::chrono::duration<double>(c->dev_tx_free - now).count()) / byte_sec;
+
+        // Extend the slice angle by angle while the response bytes it triggers still fit
+        size_t end = pos, produced = 0;
+        while (end < len) {
+            size_t next = (k < m) ? hdr_len + req_unit * (k + 1) : len;
+            size_t bytes = (k < m) ? resp_unit + (k == 0 ? hdr_len : 0) : 1;
+            if (backlog + produced + bytes > budget)
+                break;
+            produced += bytes;
+            end = next;
+            k++;
+        }
+        if (end == pos) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(resp_unit * byte_sec));
+            continue;
+        }
+
+        if (!write_all(c->fd, msg + pos, end - pos))
+            return false;
+        c->dev_tx_free = std::max(c->dev_tx_free, now)
+                         + std::chrono::duration_cast<clk::duration>(std::chrono::duration<double>(produced * byte_sec));
+        pos = end;
+    }
+    return true;
+}
+
+/* Waits until at most max_inflight messages are outstanding. Gives up when no response has
+   arrived for timeout_sec. Called with lock held. */
+static bool wait_inflight(cordic_client_t* c, std::unique_lock<std::mutex>& lock, size_t max_inflight) {
+    while (c->inflight.size() > max_inflight && !c->failed) {
+        std::chrono::duration<double> timeout(c->inflight.front().timeout_sec);
+        clk::time_point since = std::max(c->last_rx, c->inflight.front().sent);
+        if (clk::now() - since >= timeout) {
+            c->stats.timeouts++;
+            c->failed = true;
+            break;
+        }
+        c->cv.wait_for(lock, std::chrono::milliseconds(10));
+    }
+    return !c->failed;
+}
+
+/* Forgets the outstanding messages of a failed batch and waits for the line to go quiet, so
+   their late responses are not matched to the next batch */
+static void drain(cordic_client_t* c, std::unique_lock<std::mutex>& lock) {
+    c->inflight.clear();
+    c->draining = true;
+    std::chrono::duration<double> quiet(DRAIN_QUIET_SEC);
+    c->last_rx = clk::now();
+    while (clk::now() - c->last_rx < quiet)
+        c->cv.wait_for(lock, std::chrono::milliseconds(10));
+    c->draining = false;
+    c->failed   = false;
+    c->resync   = true;
+}
+
+int cordic_client_sincos_fixed(cordic_client_t* c, const long long* theta, size_t n,
+                               long long* cos_theta, long long* sin_theta) {
+    clk::time_point t0 = clk::now();
+    unsigned char* msg = c->msg.data();
+    size_t per_msg = c->cfg.stream ? c->cfg.stream : c->cfg.burst;
+    bool ok = true;
+
+    for (size_t off = 0; off < n && ok; off += per_msg) {
+        int m = (int)std::min(per_msg, n - off);
+        size_t len = 0;
+        msg[len++] = BYTE_HEADER;
+        if (c->cfg.stream) {
+            // The top theta_bits of each theta, least significant byte first
+            int drop = 6 - stream_theta_bytes(c->mode);
+            msg[len++] = CMD_STREAM_TRANS;
+            msg[len++] = c->mode;
+            msg[len++] = (unsigned char)m;
+            msg[len++] = (unsigned char)(m >> 8);
+            for (int k = 0; k < m; k++)
+                for (int i = drop; i < 6; i++)
+                    msg[len++] = (unsigned char)(theta[off + k] >> (8*i));
+        } else {
+            msg[len++] = CMD_BURST_TRANS;
+            msg[len++] = (unsigned char)m;
+            for (int k = 0; k < m; k++)
+                for (int i = 0; i < 6; i++)
+                    msg[len++] = (unsigned char)(theta[off + k] >> (8*i));
+        }
+        msg[len] = crc_8_block(0, msg, len);
+        len++;
+
+        {
+            std::unique_lock<std::mutex> lock(c->mtx);
+            ok = wait_inflight(c, lock, c->cfg.window - 1);
+            if (!ok)
+                break;
+            client_pending_t req = { c->cfg.stream ? CMD_STREAM_TRANS : CMD_BURST_TRANS, m, cos_theta + off,
+                                     sin_theta + off, clk::now(), c->cfg.timeout_sec, NULL, NULL };
+            c->inflight.push_back(req);
+        }
+        bool written = c->cfg.stream
+            ? write_paced(c, msg, len, m, 5, stream_theta_bytes(c->mode), 2 * stream_result_bytes(c->mode))
+            : write_paced(c, msg, len, m, 3, 6, 12);
+        if (!written) {
+            perror(c->cfg.port);
+            std::lock_guard<std::mutex> lock(c->mtx);
+            c->failed = true;
+            ok = false;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(c->mtx);
+    ok = wait_inflight(c, lock, 0) && ok;
+    if (!ok)
+        drain(c, lock);
+    c->stats.busy_sec += std::chrono::duration<double>(clk::now() - t0).count();
+    return ok ? 0 : -1;
+}
+
+int cordic_client_selftest(cordic_client_t* c, long long seed, long long count,
+                           unsigned int* signature, long long* cycles) {
+    if (count < 1 || count > SELFTEST_MAX_CNT)
+        return -1;
+    unsigned char msg[SELFTEST_MSG_LEN];
+    size_t len = 0;
+    msg[len++] = BYTE_HEADER;
+    msg[len++] = CMD_SELFTEST;
+    for (int i = 0; i < 6; i++)
+        msg[len++] = (unsigned char)(seed >> (8*i));
+    for (int i = 0; i < 4; i++)
+        msg[len++] = (unsigned char)(count >> (8*i));      // 2^32 goes out as 0
+    msg[len] = crc_8_block(0, msg, len);
+    len++;
+
+    std::unique_lock<std::mutex> lock(c->mtx);
+    bool ok = wait_inflight(c, lock, 0);
+    if (ok) {
+        client_pending_t req = { CMD_SELFTEST, 0, NULL, NULL, clk::now(),
+                                 c->cfg.timeout_sec + count / SELFTEST_MIN_RATE, signature, cycles };
+        c->inflight.push_back(req);
+        lock.unlock();
+        ok = write_all(c->fd, msg, len);
+        if (!ok)
+            perror(c->cfg.port);
+        lock.lock();
+        c->failed = c->failed || !ok;
+        ok = wait_inflight(c, lock, 0) && ok;
+    }
+    if (!ok)
+        drain(c, lock);
+    return ok ? 0 : -1;
+}
+
+int cordic_client_sincos(cordic_client_t* c, const double* theta, size_t n,
+                         double* cos_theta, double* sin_theta) {
+    // Enough angles per chunk to keep the window full of STREAM messages
+    const size_t chunk = std::max<size_t>(4096, (size_t)c->cfg.stream * c->cfg.window);
+    std::vector<long long> t(chunk), x(chunk), y(chunk);
+    int rc = 0;
+    for (size_t off = 0; off < n; off += chunk) {
+        size_t m = std::min(chunk, n - off);
+        for (size_t k = 0; k < m; k++) {
+            t[k] = llround(ldexp(fmod(theta[off + k], 2 * M_PI), 44));
+            t[k] = std::max(-PI_MULT_2, std::min(PI_MULT_2, t[k]));
+        }
+        if (cordic_client_sincos_fixed(c, t.data(), m, x.data(), y.data())) {
+            rc = -1;
+            for (size_t k = 0; k < m; k++)
+                cos_theta[off + k] = sin_theta[off + k] = NAN;
+            continue;
+        }
+        for (size_t k = 0; k < m; k++) {
+            cos_theta[off + k] = ldexp((double)x[k], -46);
+            sin_theta[off + k] = ldexp((double)y[k], -46);
+        }
+    }
+    return rc;
+}
+
+/* Latency at quantile q from the 1 us histogram */
+static double latency_quantile(const std::vector<unsigned long long>& hist, unsigned long long total, double q) {
+    if (!total)
+        return 0.0;
+    unsigned long long rank = (unsigned long long)ceil(q * total), seen = 0;
+    for (size_t us = 0; us < hist.size(); us++) {
+        seen += hist[us];
+        if (seen >= rank)
+            return (double)us;
+    }
+    return (double)(hist.size() - 1);
+}
+
+void cordic_client_stats(cordic_client_t* c, cordic_client_stats_t* stats) {
+    std::lock_guard<std::mutex> lock(c->mtx);
+    (*stats)                = c->stats;
+    stats->latency_p50_us   = latency_quantile(c->latency_hist, c->stats.msgs, 0.50);
+    stats->latency_p99_us   = latency_quantile(c->latency_hist, c->stats.msgs, 0.99);
+}
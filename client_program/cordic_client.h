@@ -0,0 +1,86 @@
+//
+// File:        cordic_client.h
+// Author:      agent
+// Date:        10/2026
+// Description: Pipelined host client for the CORDIC-UART device. Angles are sent as BURST
+//              messages with up to --window messages in flight back to back, so the link and the
+//              CORDIC pipeline never wait on a round trip. A receive thread frames the responses,
+//              checks their CRC-8 and matches them to the requests in order (the device answers
+//              in request order).
+//
+//              With stream set, angles go out as CMD_STREAM_TRANS messages instead, up to 65536
+//              per message with narrower thetas and results. 16-bit results with 32-bit thetas
+//              move 4 bytes per angle each way instead of 12 (3x the angles/sec of BURST).
+//
+//              The device queues a response as soon as each angle arrives but drains it at the
+//              line rate, and results are usually wider than requests. With pace set (default)
+//              requests are written no faster than the device's TX FIFO (top_module
+//              TX_FIFO_DEPTH, 1024 bytes by default) can absorb without holding the pipelines.
+//
+//              cordic_client_selftest() runs the on-chip self-test instead, which feeds the
+//              pipeline one angle per clock and answers with a signature and a cycle count.
+//
+
+#ifndef CORDIC_CLIENT_H
+#define CORDIC_CLIENT_H
+
+#include <stddef.h>
+
+struct cordic_client_cfg_t {
+    const char* port;               // serial device, e.g. /dev/ttyUSB1 or an emulator pty
+    int         baud;               // 3000000 for fpga_top_module
+    int         window;             // BURST messages in flight
+    int         burst;              // angles per BURST message, 1..8
+    double      timeout_sec;        // longest wait for one response
+    int         stream;             // angles per CMD_STREAM_TRANS message, 1..65536; 0 sends BURST
+    int         theta_bits;         // stream theta width: 16, 24, 32 or 48
+    int         result_bits;        // stream cos/sin width: 16, 24, 32 or 48
+    bool        round;              // stream results rounded to nearest instead of truncated
+    bool        pace;               // hold requests back so the device's TX FIFO never fills
+    int         tx_fifo_depth;      // top_module TX_FIFO_DEPTH of the device, for pace
+};
+
+/* Defaults for everything except port */
+void cordic_client_cfg_init(cordic_client_cfg_t* cfg);
+
+struct cordic_client_stats_t {
+    unsigned long long  angles;         // angles answered
+    unsigned long long  msgs;           // BURST/STREAM messages answered
+    unsigned long long  crc_errors;     // responses failing CRC-8
+    unsigned long long  bad_responses;  // CMD_ERR, or cmd/burst cnt not matching the request
+    unsigned long long  timeouts;
+    double              busy_sec;       // time spent inside cordic_client_sincos*()
+    double              latency_p50_us; // request written to response received, per message
+    double              latency_p99_us;
+};
+
+struct cordic_client_t;
+
+/* Opens and configures the port (raw, 8 data bits, odd parity) and starts the receive thread.
+   Returns NULL with a message on stderr on failure. */
+cordic_client_t* cordic_client_open(const cordic_client_cfg_t* cfg);
+void cordic_client_close(cordic_client_t* c);
+
+/* Fixed-point batch: theta in 4.44 (within [-2pi, 2pi]), cos/sin in 2.46. In stream mode theta
+   is truncated to theta_bits and cos/sin come back with their bits below result_bits zero.
+   Returns 0, or -1 if
+   any response was missing, failed its CRC or did not match its request; the port is drained
+   and the client is usable again afterwards. */
+int cordic_client_sincos_fixed(cordic_client_t* c, const long long* theta, size_t n,
+                               long long* cos_theta, long long* sin_theta);
+
+/* Radians batch. Angles are reduced to (-2pi, 2pi) and rounded to 4.44 fixed point. */
+int cordic_client_sincos(cordic_client_t* c, const double* theta, size_t n,
+                         double* cos_theta, double* sin_theta);
+
+/* Runs one CMD_SELFTEST of count angles (1..2^32) from seed on the device and returns its CRC-32
+   signature and cycle count (cordic_gref_selftest() gives the expected values). The response
+   is waited for timeout_sec plus the run time at 50 M angles/sec. Returns 0, or -1 as for
+   cordic_client_sincos_fixed(); a disabled device never answers. */
+int cordic_client_selftest(cordic_client_t* c, long long seed, long long count,
+                           unsigned int* signature, long long* cycles);
+
+/* Counters and latency percentiles since open */
+void cordic_client_stats(cordic_client_t* c, cordic_client_stats_t* stats);
+
+#endif
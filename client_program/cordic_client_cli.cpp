@@ -0,0 +1,179 @@
+//
+// File:        cordic_client_cli.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Command line front end of the pipelined C++ client (cordic_client.h). With angles
+//              (degrees) on the command line it prints their cos/sin; otherwise it streams
+//              --count random angles through the device and reports angles/sec and the p50/p99
+//              message latency. --check compares every result with the C++ reference model.
+//              --selftest N runs the on-chip self-test of N angles instead and reports the
+//              pipeline's angles per clock; --check then also verifies its signature.
+//
+//              Build (from client_program):
+//                  g++ -std=c++14 -O2 -pthread -DCORDIC_GREF_STANDALONE -I../testbench/uvm_tb_hvl/subscriber
+//                      cordic_client_cli.cpp cordic_client.cpp
+//                      ../testbench/uvm_tb_hvl/subscriber/cordic_stream.cpp
+//                      ../testbench/uvm_tb_hvl/subscriber/cordic_gref.cpp
+//                      ../testbench/uvm_tb_hvl/subscriber/cordic_sincos_simd.cpp
+//                      ../testbench/uvm_tb_hvl/subscriber/cordic_crc8.cpp -o cordic_client
+//              Run:    ./cordic_client --port /dev/ttyUSB1 30 45 60
+//                      ./cordic_client --port /tmp/cordic0 [--count N] [--window W] [--burst B]
+//                                      [--baud 3000000] [--timeout SEC] [--check] [--no-pace]
+//                                      [--fifo-depth 1024]
+//                                      [--stream N [--theta-bits B] [--result-bits B] [--round]]
+//                      ./cordic_client --port /dev/ttyUSB1 --selftest 100000000 [--seed S] [--check]
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "cordic_gref_const.h"
+#include "cordic_gref.h"
+#include "cordic_client.h"
+
+static int usage(const char* prog) {
+    fprintf(stderr, "Usage: %s --port DEV [--baud B] [--window W] [--burst B] [--timeout SEC]\n"
+                    "          [--stream N [--theta-bits 16|24|32|48] [--result-bits 16|24|32|48] [--round]]\n"
+                    "          [--count N] [--check] [--no-pace] [--fifo-depth D] [angle_deg ...]\n"
+                    "       %s --port DEV --selftest N [--seed S] [--check]\n", prog, prog);
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    cordic_client_cfg_t cfg;
+    cordic_client_cfg_init(&cfg);
+    long long count = 1 << 16;
+    long long selftest = 0, seed = 1;
+    bool check = false;
+    std::vector<double> angles;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--port") && i + 1 < argc)
+            cfg.port = argv[++i];
+        else if (!strcmp(argv[i], "--baud") && i + 1 < argc)
+            cfg.baud = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--window") && i + 1 < argc)
+            cfg.window = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--burst") && i + 1 < argc)
+            cfg.burst = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--timeout") && i + 1 < argc)
+            cfg.timeout_sec = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--stream") && i + 1 < argc)
+            cfg.stream = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--theta-bits") && i + 1 < argc)
+            cfg.theta_bits = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--result-bits") && i + 1 < argc)
+            cfg.result_bits = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--round"))
+            cfg.round = true;
+        else if (!strcmp(argv[i], "--no-pace"))
+            cfg.pace = false;
+        else if (!strcmp(argv[i], "--fifo-depth") && i + 1 < argc)
+            cfg.tx_fifo_depth = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--count") && i + 1 < argc)
+            count = atoll(argv[++i]);
+        else if (!strcmp(argv[i], "--selftest") && i + 1 < argc)
+            selftest = atoll(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = strtoll(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--check"))
+            check = true;
+        else {
+            char* end;
+            double deg = strtod(argv[i], &end);
+            if (end == argv[i] || *end)
+                return usage(argv[0]);
+            angles.push_back(deg * M_PI / 180.0);
+        }
+    }
+    if (!cfg.port || count < 1 || cfg.tx_fifo_depth <= TX_FIFO_MARGIN || selftest < 0 || selftest > SELFTEST_MAX_CNT)
+        return usage(argv[0]);
+
+    cordic_client_t* c = cordic_client_open(&cfg);
+    if (!c)
+        return 1;
+
+    int rc = 0;
+    if (selftest) {
+        // On-chip run: angles per clock, and the stall cycles over the pipeline latency
+        unsigned int signature = 0, ref_signature = 0;
+        long long cycles = 0, ref_cycles = 0;
+        rc = cordic_client_selftest(c, seed, selftest, &signature, &cycles) ? 1 : 0;
+        if (!rc) {
+            cordic_gref_selftest(0, seed, selftest, &ref_signature, &ref_cycles);
+            printf("angles:         %lld (seed 0x%012llx)\n", selftest, seed & ((1LL << 48) - 1));
+            printf("signature:      0x%08x\n", signature);
+            printf("cycles:         %lld (%lld over count + latency)\n", cycles, cycles - ref_cycles);
+            printf("angles/cycle:   %.4f\n", (double)selftest / cycles);
+            if (check) {
+                printf("expected:       0x%08x %s\n", ref_signature, signature == ref_signature ? "ok" : "MISMATCH");
+                rc = (signature != ref_signature);
+            }
+        }
+    } else if (!angles.empty()) {
+        // Interactive use: print each angle's results
+        std::vector<double> cos_theta(angles.size()), sin_theta(angles.size());
+        rc = cordic_client_sincos(c, angles.data(), angles.size(), cos_theta.data(), sin_theta.data()) ? 1 : 0;
+        for (size_t k = 0; k < angles.size(); k++)
+            printf("%12.6f deg  cos %+.15f  sin %+.15f\n", angles[k] * 180.0 / M_PI, cos_theta[k], sin_theta[k]);
+    } else {
+        // Throughput run over random fixed-point angles in [-2pi, 2pi]
+        const size_t chunk = std::max<size_t>(1 << 14, (size_t)cfg.stream * cfg.window);
+        std::mt19937_64 rng(1);
+        std::vector<long long> theta(chunk), x(chunk), y(chunk), ref_x(chunk), ref_y(chunk);
+        long long mismatches = 0, failed_batches = 0;
+        for (long long done = 0; done < count; done += chunk) {
+            size_t m = (size_t)std::min<long long>(chunk, count - done);
+            for (size_t k = 0; k < m; k++)
+                theta[k] = (long long)(rng() % (2 * PI_MULT_2 + 1)) - PI_MULT_2;
+            if (cordic_client_sincos_fixed(c, theta.data(), m, x.data(), y.data())) {
+                failed_batches++;
+                continue;
+            }
+            if (check) {
+                // In stream mode the device sees the truncated theta and sends reduced results
+                int theta_drop = cfg.stream ? 48 - cfg.theta_bits : 0;
+                int result_drop = cfg.stream ? 48 - cfg.result_bits : 0;
+                long long half = (cfg.round && result_drop) ? 1LL << (result_drop - 1) : 0;
+                for (size_t k = 0; k < m; k++)
+                    theta[k] = (theta[k] >> theta_drop) << theta_drop;
+                for (size_t k = 0; k < m; k += 8) {
+                    int n = (int)std::min<size_t>(8, m - k);
+                    cordic_sincos_burst(&theta[k], &ref_x[k], &ref_y[k], n);
+                }
+                for (size_t k = 0; k < m; k++) {
+                    ref_x[k] = ((ref_x[k] + half) >> result_drop) << result_drop;
+                    ref_y[k] = ((ref_y[k] + half) >> result_drop) << result_drop;
+                }
+                for (size_t k = 0; k < m; k++)
+                    mismatches += (x[k] != ref_x[k] || y[k] != ref_y[k]);
+            }
+        }
+
+        cordic_client_stats_t st;
+        cordic_client_stats(c, &st);
+        if (cfg.stream)
+            printf("angles:         %llu in %llu messages (window %d, stream %d, theta %d bits, results %d bits %s)\n",
+                   st.angles, st.msgs, cfg.window, cfg.stream, cfg.theta_bits, cfg.result_bits,
+                   cfg.round ? "rounded" : "truncated");
+        else
+            printf("angles:         %llu in %llu messages (window %d, burst %d)\n", st.angles, st.msgs, cfg.window, cfg.burst);
+        printf("angles/sec:     %.0f\n", st.busy_sec > 0 ? st.angles / st.busy_sec : 0.0);
+        printf("latency p50:    %.0f us\n", st.latency_p50_us);
+        printf("latency p99:    %.0f us\n", st.latency_p99_us);
+        printf("crc errors:     %llu\n", st.crc_errors);
+        printf("bad responses:  %llu\n", st.bad_responses);
+        printf("timeouts:       %llu\n", st.timeouts);
+        if (check)
+            printf("mismatches:     %lld\n", mismatches);
+        rc = (failed_batches || mismatches) ? 1 : 0;
+    }
+
+    cordic_client_close(c);
+    return rc;
+}
@@ -8,16 +8,24 @@ def twos_complement(hexstr,bits):
          value -= 1 << bits
      return value
 
-def crc_8(bytearr):
-    generator = 0x9b
-    crc = 0
-    for byte in bytearr:
-        crc = crc ^ byte
+def crc_8_table(generator):
+    table = []
+    for byte in range(0, 256):
+        crc = byte
         for i in range(0, 8):
             if ((crc >> 7) & 0xFF):
                 crc = ((crc << 1) & 0xFF) ^ generator
             else:
                 crc = ((crc << 1) & 0xFF)
+        table.append(crc)
+    return table
+
+CRC_8_TABLE = crc_8_table(0x9b)
+
+def crc_8(bytearr):
+    crc = 0
+    for byte in bytearr:
+        crc = CRC_8_TABLE[crc ^ byte]
     return crc
 
 def main():
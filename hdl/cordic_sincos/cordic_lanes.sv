@@ -0,0 +1,186 @@
+//
+// File:        cordic_lanes.sv
+// Author:      agent
+// Date:        10/2026
+// Description: LANES cordic_sincos pipelines behind one interface. Each cycle takes a group of up
+//              to LANES thetas (i_start_cnt of them, in i_theta[0..]) and hands them out round-robin:
+//              theta k since reset goes to lane k mod LANES. All lanes have the same latency, so
+//              results come back as the same rotation and are reassembled in issue order in
+//              o_sin_theta/o_cos_theta[0..o_done_cnt-1]. With LANES = 1 this is cordic_sincos.
+//
+//              With LANE_CLK_ASYNC = 0 the lanes run on i_clk and share i_pipeline_en, o_ready is
+//              always high and the latency is that of cordic_sincos. With LANE_CLK_ASYNC = 1 they
+//              run on i_lane_clk (a faster PLL output, say) behind two async_fifo of CDC_FIFO_DEPTH
+//              groups: i_pipeline_en then only gates taking groups in and results out on the i_clk
+//              side, the lanes hold while the result FIFO is full, o_ready drops while the theta
+//              FIFO is, and the latency in i_clk cycles depends on the clock ratio.
+//
+// Copyright (C) 2021, Grant Yu
+//
+// This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+// 
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+// 
+//    You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+`default_nettype none
+
+module cordic_lanes #(
+  parameter STAGES,                 // # of pipeline stages = [1,48]
+  parameter BITS,                   // # datapath bitwidth  = [4,48]
+  parameter SEED_BITS       = 0,    // hybrid mode, see cordic_sincos
+  parameter SEED_ROM_FILE   = "",
+  parameter LANES           = 1,    // # of cordic_sincos pipelines = [1,8]
+  parameter LANE_CLK_ASYNC  = 0,    // 0: lanes on i_clk. 1: lanes on i_lane_clk behind CDC FIFOs.
+  parameter CDC_FIFO_DEPTH  = 16    // groups per CDC FIFO, a power of 2 and at least 4
+)
+(
+  input wire                                i_clk,
+  input wire                                i_rst_n,
+  input wire                                i_lane_clk,         // unused with LANE_CLK_ASYNC = 0
+  input wire                                i_lane_rst_n,       // synchronous to i_lane_clk
+  input wire                                i_pipeline_en,
+  input wire        [$clog2(LANES):0]       i_start_cnt,        // thetas this cycle, 0 to LANES
+  input wire        [LANES-1:0][BITS-1:0]   i_theta,            // in issue order from [0]
+  output wire                               o_ready,            // a group is taken this cycle
+  output wire       [$clog2(LANES):0]       o_done_cnt,         // results this cycle, 0 to LANES
+  output wire       [LANES-1:0][BITS-1:0]   o_sin_theta,        // in issue order from [0]
+  output wire       [LANES-1:0][BITS-1:0]   o_cos_theta
+);
+
+  localparam CNT_W  = $clog2(LANES) + 1;
+  localparam RR_W   = (LANES > 1) ? $clog2(LANES) : 1;
+  
+  // Lane side: the clock, reset and enable the lanes run on, and the groups in and out
+  logic                         lane_clk, lane_rst_n, lane_en;
+  logic [CNT_W-1:0]             lane_start_cnt, lane_done_cnt;
+  logic [LANES-1:0][BITS-1:0]   lane_theta, lane_sin, lane_cos;
+  
+  // Round-robin pointers: the lane of the next theta in and of the next result out
+  logic [RR_W-1:0]              rr_in, rr_out;
+  logic [LANES-1:0]             start, done;
+  logic [LANES-1:0][BITS-1:0]   theta, sin, cos;
+  
+  // Group slot j goes to lane (rr_in + j) mod LANES
+  always_comb
+    for (int i = 0; i < LANES; i++) begin
+      start[i] = ((i - rr_in + LANES) % LANES) < lane_start_cnt;
+      theta[i] = lane_theta[(i - rr_in + LANES) % LANES];
+    end
+  
+  // A done lane set is always a rotation issued STAGES+2 running cycles earlier, so it starts at
+  // rr_out and result j comes from lane (rr_out + j) mod LANES
+  always_comb begin
+    lane_done_cnt = '0;
+    for (int i = 0; i < LANES; i++)
+      lane_done_cnt += done[i];
+    for (int j = 0; j < LANES; j++) begin
+      lane_sin[j] = sin[(rr_out + j) % LANES];
+      lane_cos[j] = cos[(rr_out + j) % LANES];
+    end
+  end
+  
+  always_ff @(posedge lane_clk)
+    if (!lane_rst_n) begin
+      rr_in     <= '0;
+      rr_out    <= '0;
+    end else if (lane_en) begin
+      rr_in     <= (rr_in  + lane_start_cnt) % LANES;
+      rr_out    <= (rr_out + lane_done_cnt)  % LANES;
+    end
+  
+  // CORDIC LANES
+  genvar i;
+  generate
+    for (i = 0; i < LANES; i++) begin : LANES_GEN
+      cordic_sincos #(
+        .STAGES         (STAGES),
+        .BITS           (BITS),
+        .SEED_BITS      (SEED_BITS),
+        .SEED_ROM_FILE  (SEED_ROM_FILE)
+      )
+      cordic_sincos_inst (
+        .i_clk          ( lane_clk    ),
+        .i_rst_n        ( lane_rst_n  ),
+        .i_pipeline_en  ( lane_en     ),
+        .i_start        ( start [i]   ),
+        .i_theta        ( theta [i]   ),
+        .o_done         ( done  [i]   ),
+        .o_sin_theta    ( sin   [i]   ),
+        .o_cos_theta    ( cos   [i]   )
+      );
+    end
+  endgenerate
+  
+  // CLOCKING
+  generate
+    if (LANE_CLK_ASYNC == 0) begin : SYNC_GEN
+      assign lane_clk       = i_clk;
+      assign lane_rst_n     = i_rst_n;
+      assign lane_en        = i_pipeline_en;
+      assign lane_start_cnt = i_start_cnt;
+      assign lane_theta     = i_theta;
+      assign o_ready        = 1'b1;
+      assign o_done_cnt     = lane_done_cnt;
+      assign o_sin_theta    = lane_sin;
+      assign o_cos_theta    = lane_cos;
+    end else begin : ASYNC_GEN
+      logic                         in_full, in_empty, out_full, out_empty;
+      logic [CNT_W+LANES*BITS-1:0]  in_rd_data;
+      logic [CNT_W+2*LANES*BITS-1:0] out_rd_data;
+      
+      assign lane_clk       = i_lane_clk;
+      assign lane_rst_n     = i_lane_rst_n;
+      assign lane_en        = !out_full;
+      assign lane_start_cnt = in_empty ? '0 : in_rd_data[LANES*BITS +: CNT_W];
+      assign lane_theta     = in_rd_data[LANES*BITS-1:0];
+      assign o_ready        = !in_full;
+      assign o_done_cnt     = out_empty ? '0 : out_rd_data[2*LANES*BITS +: CNT_W];
+      assign o_sin_theta    = out_rd_data[LANES*BITS +: LANES*BITS];
+      assign o_cos_theta    = out_rd_data[LANES*BITS-1:0];
+      
+      // Theta groups, i_clk to i_lane_clk
+      async_fifo #(
+        .WIDTH      (CNT_W + LANES*BITS),
+        .DEPTH      (CDC_FIFO_DEPTH)
+      ) theta_fifo_inst (
+        .i_wr_clk   (i_clk),
+        .i_wr_rst_n (i_rst_n),
+        .i_wr_en    (i_pipeline_en && (i_start_cnt != 0)),
+        .i_wr_data  ({i_start_cnt, i_theta}),
+        .o_full     (in_full),
+        .i_rd_clk   (i_lane_clk),
+        .i_rd_rst_n (i_lane_rst_n),
+        .i_rd_en    (lane_en),
+        .o_rd_data  (in_rd_data),
+        .o_empty    (in_empty)
+      );
+      
+      // Result groups, i_lane_clk to i_clk; a held caller leaves the head in place
+      async_fifo #(
+        .WIDTH      (CNT_W + 2*LANES*BITS),
+        .DEPTH      (CDC_FIFO_DEPTH)
+      ) result_fifo_inst (
+        .i_wr_clk   (i_lane_clk),
+        .i_wr_rst_n (i_lane_rst_n),
+        .i_wr_en    (lane_en && (lane_done_cnt != 0)),
+        .i_wr_data  ({lane_done_cnt, lane_sin, lane_cos}),
+        .o_full     (out_full),
+        .i_rd_clk   (i_clk),
+        .i_rd_rst_n (i_rst_n),
+        .i_rd_en    (i_pipeline_en),
+        .o_rd_data  (out_rd_data),
+        .o_empty    (out_empty)
+      );
+    end
+  endgenerate
+
+endmodule
\ No newline at end of file
@@ -2,7 +2,9 @@
 // File:        cordic_sincos.sv
 // Author:      Grant Yu
 // Date:        03/2021
-// Description: Top-level wrapper for a pipelined CORDIC block
+// Description: Top-level wrapper for a pipelined CORDIC block. With SEED_BITS > 0 (hybrid mode) a
+//              seed ROM stage replaces CORDIC stages 0 to SEED_BITS, cutting SEED_BITS cycles of
+//              latency and SEED_BITS+1 stages of adders for one BRAM-based ROM.
 //
 // Copyright (C) 2021, Grant Yu
 //
@@ -24,8 +26,10 @@
 import pkg_cordic_sincos::*;
 
 module cordic_sincos #(
-  parameter STAGES,    // # of pipeline stages = [1,48]
-  parameter BITS       // # datapath bitwidth  = [4,48]
+  parameter STAGES,            // # of pipeline stages = [1,48]
+  parameter BITS,              // # datapath bitwidth  = [4,48]
+  parameter SEED_BITS = 0,     // hybrid mode ROM grid 2^-SEED_BITS rad, 0 = plain CORDIC
+  parameter SEED_ROM_FILE = "" // hybrid mode ROM contents (tools/hybrid/cordic_hybrid.cpp)
 )
 (
   input wire                        i_clk,
@@ -44,6 +48,12 @@ module cordic_sincos #(
   logic signed [BITS-1:0]   sin     [STAGES + 1];
   logic signed [BITS-1:0]   theta   [STAGES + 1];
   
+  // First CORDIC stage instantiated; the seed ROM stands in for the ones before it
+  localparam FIRST = (SEED_BITS == 0) ? 0 : SEED_BITS + 1;
+  
+  logic                     valid_pre, sign_pre;
+  logic signed [BITS-1:0]   cos_pre, sin_pre, theta_pre;
+  
   // CORDIC PREPROCESSING STAGE
   cordic_sincos_preprocess #(
     .STAGES     (STAGES),
@@ -55,18 +65,50 @@ module cordic_sincos #(
     .i_pipeline_en,
     .i_start,
     .i_theta,
-    .o_valid    ( valid [0]),
-    .o_sign     ( sign  [0]),
-    .o_cos      ( cos   [0]),
-    .o_sin      ( sin   [0]),
-    .o_theta    ( theta [0])
+    .o_valid    ( valid_pre ),
+    .o_sign     ( sign_pre  ),
+    .o_cos      ( cos_pre   ),
+    .o_sin      ( sin_pre   ),
+    .o_theta    ( theta_pre )
   );
   
+  // SEED ROM STAGE (hybrid mode)
+  generate
+    if (SEED_BITS == 0) begin : NO_SEED_GEN
+      assign valid  [0] = valid_pre;
+      assign sign   [0] = sign_pre;
+      assign cos    [0] = cos_pre;
+      assign sin    [0] = sin_pre;
+      assign theta  [0] = theta_pre;
+    end else begin : SEED_GEN
+      cordic_sincos_seed #(
+        .STAGES         (STAGES),
+        .BITS           (BITS),
+        .SEED_BITS      (SEED_BITS),
+        .SEED_ROM_FILE  (SEED_ROM_FILE)
+      )
+      cordic_seed_inst (
+        .i_clk,
+        .i_rst_n,
+        .i_pipeline_en,
+        .i_valid    ( valid_pre ),
+        .i_sign     ( sign_pre  ),
+        .i_theta    ( theta_pre ),
+        .o_valid    ( valid [FIRST]),
+        .o_sign     ( sign  [FIRST]),
+        .o_cos      ( cos   [FIRST]),
+        .o_sin      ( sin   [FIRST]),
+        .o_theta    ( theta [FIRST])
+      );
+    end
+  endgenerate
+  
   // CORDIC PIPELINE STAGES
   genvar i;
   generate
-    for (i = 0; i < STAGES; i++) begin : CORDIC_STAGES_GEN 
+    for (i = FIRST; i < STAGES; i++) begin : CORDIC_STAGES_GEN 
         cordic_sincos_stage #(
+          .STAGES   (STAGES),
           .BITS     (BITS),
           .STAGE    (i)
         )
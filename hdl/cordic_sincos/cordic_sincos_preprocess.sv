@@ -75,10 +75,10 @@ module cordic_sincos_preprocess #(
   assign PI_MULT_2_n        = round(PI_MULT_2, BITS)        >>> (MAX_D_WIDTH - BITS);
   
   logic signed [BITS-1:0] theta_w2;
-  assign theta_w2 = ( theta_p1 > PI_MULT_3_DIV_2_n )    ?   theta_p1 - PI_MULT_2 :
-                    ( theta_p1 > PI_DIV_2_n )           ?   theta_p1 - PI :
-                    ( theta_p1 < -PI_MULT_3_DIV_2_n )   ?   theta_p1 + PI_MULT_2 :
-                    ( theta_p1 < -PI_DIV_2_n )          ?   theta_p1 + PI :
+  assign theta_w2 = ( theta_p1 > PI_MULT_3_DIV_2_n )    ?   theta_p1 - PI_MULT_2_n :
+                    ( theta_p1 > PI_DIV_2_n )           ?   theta_p1 - PI_n :
+                    ( theta_p1 < -PI_MULT_3_DIV_2_n )   ?   theta_p1 + PI_MULT_2_n :
+                    ( theta_p1 < -PI_DIV_2_n )          ?   theta_p1 + PI_n :
                                                             theta_p1;
 
   logic sign_w2;
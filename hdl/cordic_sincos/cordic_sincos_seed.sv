@@ -0,0 +1,108 @@
+//
+// File:        cordic_sincos_seed.sv
+// Author:      agent
+// Date:        10/2026
+// Description: Seed stage of the hybrid CORDIC mode. The reduced angle from the preprocessing stage
+//              is rounded to a multiple of 2^-SEED_BITS, a coarse sin/cos ROM (bram) gives the
+//              rotation by that angle, and the remainder is left to stages SEED_BITS+1 and up.
+//
+// Copyright (C) 2021, Grant Yu
+//
+// This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+// 
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+// 
+//    You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+`default_nettype none
+import pkg_cordic_sincos::*;
+
+module cordic_sincos_seed #(
+  parameter STAGES,
+  parameter BITS,
+  parameter SEED_BITS,        // ROM grid is 2^-SEED_BITS rad
+  parameter SEED_ROM_FILE     // $readmemh file, 2^(SEED_BITS+1) lines of {cos, sin} (48b each, 2.46)
+) 
+(
+  input wire                    i_clk,
+  input wire                    i_rst_n,
+  input wire                    i_pipeline_en,
+  input wire                    i_valid,
+  input wire                    i_sign,
+  input wire signed [BITS-1:0]  i_theta,
+  output wire                   o_valid,
+  output wire                   o_sign,
+  output wire signed [BITS-1:0] o_cos,
+  output wire signed [BITS-1:0] o_sin,
+  output wire signed [BITS-1:0] o_theta
+);
+
+  // ROM entry n holds cos and sin of n*2^-SEED_BITS, scaled by the gain of stages SEED_BITS+1 to
+  // STAGES-1 (generated by tools/hybrid). Only |n| is stored; sin is negated for negative n.
+  localparam SHIFT      = BITS - 2 - SEED_BITS;
+  localparam ADDR_WIDTH = SEED_BITS + 1;
+
+  localparam logic signed [BITS-1:0] HALF_STEP = {{(BITS-1){1'b0}}, 1'b1} << (SHIFT - 1);
+  
+  logic signed [BITS-1:0] theta_rnd, idx, theta_rem;
+  logic [ADDR_WIDTH-1:0] rom_addr;
+  assign theta_rnd  = i_theta + HALF_STEP;
+  assign idx        = theta_rnd >>> SHIFT;
+  assign theta_rem  = i_theta - (idx <<< SHIFT);
+  assign rom_addr   = idx[BITS-1] ? -idx : idx;
+  
+  logic [2*MAX_D_WIDTH-1:0] rom_data;
+  
+  bram #(
+    .ADDR_WIDTH (ADDR_WIDTH),
+    .DEPTH      (2**ADDR_WIDTH),
+    .DATA_WIDTH (2*MAX_D_WIDTH),
+    .INIT_FILE  (SEED_ROM_FILE)
+  ) seed_rom_inst (
+    .i_clk_wr   (i_clk),
+    .i_clk_rd   (i_clk),
+    .i_rst_n,
+    .i_wr_en    (1'b0),
+    .i_wr_data  ('0),
+    .i_wr_addr  ('0),
+    .i_rd_addr  (rom_addr),
+    .o_rd_data  (rom_data)
+  );
+  
+  // Everything else is registered alongside the ROM read. The ROM address follows the held
+  // preprocessing outputs while the pipeline is stalled, so its output stays aligned.
+  logic valid_s, sign_s, neg_s;
+  logic signed [BITS-1:0] theta_s;
+  
+  always_ff @(posedge i_clk)
+    if (!i_rst_n) begin
+      valid_s   <= 1'b0;
+      sign_s    <= 1'b0;
+      neg_s     <= 1'b0;
+      theta_s   <= '0;
+    end else if (i_pipeline_en) begin
+      valid_s   <= i_valid;
+      sign_s    <= i_sign;
+      neg_s     <= idx[BITS-1];
+      theta_s   <= theta_rem;
+    end
+  
+  logic signed [BITS-1:0] cos_seed, sin_seed;
+  assign cos_seed   = round(rom_data[2*MAX_D_WIDTH-1:MAX_D_WIDTH], BITS) >>> (MAX_D_WIDTH - BITS);
+  assign sin_seed   = round(rom_data[MAX_D_WIDTH-1:0], BITS) >>> (MAX_D_WIDTH - BITS);
+  
+  assign o_valid    = valid_s;
+  assign o_sign     = sign_s;
+  assign o_cos      = cos_seed;
+  assign o_sin      = neg_s ? -sin_seed : sin_seed;
+  assign o_theta    = theta_s;
+  
+endmodule
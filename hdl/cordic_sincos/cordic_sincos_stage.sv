@@ -24,6 +24,7 @@
 import pkg_cordic_sincos::*;
 
 module cordic_sincos_stage #(
+  parameter STAGES = MAX_STAGES,  // pipeline length; stage STAGES-1 applies the fold sign
   parameter BITS,
   parameter STAGE
 ) 
@@ -51,7 +52,8 @@ module cordic_sincos_stage #(
 
   generate
 
-    if ( STAGE == MAX_STAGES-1 ) begin
+    // Sign correction from the preprocessing fold is applied in the last instantiated stage
+    if ( STAGE == STAGES-1 ) begin
     
       logic [BITS-1:0] cos_sign_check, sin_sign_check;
       assign cos_sign_check = ( i_sign ? -(i_cos + delta_cos) : (i_cos + delta_cos) );
@@ -0,0 +1,118 @@
+//
+// File:        cordic_vectoring.sv
+// Author:      agent
+// Date:        10/2026
+// Description: Pipelined vectoring-mode CORDIC, the sibling of cordic_sincos: atan2(y, x) and
+//              sqrt(x^2 + y^2) of one (x, y) pair per clock. Latency is STAGES + 2 cycles.
+//
+// Copyright (C) 2021, Grant Yu
+//
+// This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+// 
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+// 
+//    You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+`default_nettype none
+import pkg_cordic_sincos::*;
+
+module cordic_vectoring #(
+  parameter STAGES,            // # of pipeline stages = [1,48]
+  parameter BITS               // # datapath bitwidth  = [4,48]
+)
+(
+  input wire                        i_clk,
+  input wire                        i_rst_n,
+  input wire                        i_pipeline_en,
+  input wire                        i_start,
+  input wire signed     [BITS-1:0]  i_x,                // -1 to 1 (upper 2b are signed integer)
+  input wire signed     [BITS-1:0]  i_y,                // -1 to 1 (upper 2b are signed integer)
+  output reg                        o_done,
+  output reg signed     [BITS-1:0]  o_magnitude,        // 0 to sqrt(2) (upper 2b are signed integer)
+  output reg signed     [BITS-1:0]  o_atan              // -pi to pi (upper 4b are signed integer)
+);
+
+  // x and y carry 2 extra integer bits: the stages grow the vector by the CORDIC gain (~1.647)
+  logic                     valid   [STAGES + 1];
+  logic        [1:0]        quad    [STAGES + 1];
+  logic signed [BITS+1:0]   x       [STAGES + 1];
+  logic signed [BITS+1:0]   y       [STAGES + 1];
+  logic signed [BITS-1:0]   z       [STAGES + 1];
+  
+  // PREPROCESSING STAGE
+  // The stages converge for angles within +/- pi/2. For x < 0 the vector is negated and pi
+  // (y >= 0) or -pi (y < 0) is added back at the end: quad 2'b01 and 2'b11, 2'b00 otherwise.
+  always_ff @(posedge i_clk)
+    if (!i_rst_n) begin
+      valid [0] <= 1'b0;
+      quad  [0] <= '0;
+      x     [0] <= '0;
+      y     [0] <= '0;
+      z     [0] <= '0;
+    end else if (i_pipeline_en) begin
+      valid [0] <= i_start;
+      quad  [0] <= i_x[BITS-1] ? {i_y[BITS-1], 1'b1} : 2'b00;
+      x     [0] <= i_x[BITS-1] ? -{{2{i_x[BITS-1]}}, i_x} : {{2{i_x[BITS-1]}}, i_x};
+      y     [0] <= i_x[BITS-1] ? -{{2{i_y[BITS-1]}}, i_y} : {{2{i_y[BITS-1]}}, i_y};
+      z     [0] <= '0;
+    end
+  
+  // CORDIC PIPELINE STAGES
+  genvar i;
+  generate
+    for (i = 0; i < STAGES; i++) begin : CORDIC_STAGES_GEN 
+        cordic_vectoring_stage #(
+          .STAGES   (STAGES),
+          .BITS     (BITS),
+          .STAGE    (i)
+        )
+        cordic_inst_i (
+          .i_clk,
+          .i_rst_n,
+          .i_pipeline_en,
+          .i_valid  ( valid  [i]),
+          .i_quad   ( quad   [i]),
+          .i_x      ( x      [i]),
+          .i_y      ( y      [i]),
+          .i_z      ( z      [i]),
+          .o_valid  ( valid  [i+1]),
+          .o_quad   ( quad   [i+1]),
+          .o_x      ( x      [i+1]),
+          .o_y      ( y      [i+1]),
+          .o_z      ( z      [i+1])
+        );
+    end
+  endgenerate
+  
+  // POSTPROCESSING STAGE
+  // Magnitude: x times the gain compensation K (a constant multiply, DSP slices on the FPGA).
+  // Angle: z back to the theta format of cordic_sincos (4 integer bits) plus the fold.
+  logic signed [BITS-1:0]   K_n, PI_n, fold;
+  logic signed [2*BITS+1:0] x_k;
+  assign K_n  = round(K[STAGES-1], BITS) >>> (MAX_D_WIDTH - BITS);
+  assign PI_n = round(PI, BITS)          >>> (MAX_D_WIDTH - BITS);
+  assign x_k  = x[STAGES] * K_n;
+  assign fold = (quad[STAGES] == 2'b01) ?  PI_n :
+                (quad[STAGES] == 2'b11) ? -PI_n :
+                                           0;
+  
+  always_ff @(posedge i_clk)
+    if (!i_rst_n) begin
+      o_done        <= 1'b0;
+      o_magnitude   <= '0;
+      o_atan        <= '0;
+    end else if (i_pipeline_en) begin
+      o_done        <= valid[STAGES];
+      o_magnitude   <= x_k[2*BITS-3:BITS-2];
+      o_atan        <= (z[STAGES] >>> 2) + fold;
+    end
+
+endmodule
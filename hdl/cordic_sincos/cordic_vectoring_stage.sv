@@ -0,0 +1,72 @@
+//
+// File:        cordic_vectoring_stage.sv
+// Author:      agent
+// Date:        10/2026
+// Description: Unit-level vectoring-mode CORDIC block to be generated per pipeline stage. Rotates
+//              (x, y) towards the x axis by +/-atan(2^-STAGE), driving y to zero, and accumulates
+//              the rotation in z.
+//
+// Copyright (C) 2021, Grant Yu
+//
+// This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+// 
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+// 
+//    You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+`default_nettype none
+import pkg_cordic_sincos::*;
+
+module cordic_vectoring_stage #(
+  parameter STAGES,
+  parameter BITS,
+  parameter STAGE
+) 
+(
+  input wire                    i_clk,
+  input wire                    i_rst_n,
+  input wire                    i_pipeline_en,
+  input wire                    i_valid,
+  input wire        [1:0]       i_quad,
+  input wire signed [BITS+1:0]  i_x,
+  input wire signed [BITS+1:0]  i_y,
+  input wire signed [BITS-1:0]  i_z,
+  output reg                    o_valid,
+  output reg        [1:0]       o_quad,
+  output reg signed [BITS+1:0]  o_x,
+  output reg signed [BITS+1:0]  o_y,
+  output reg signed [BITS-1:0]  o_z
+);
+  
+  // y >= 0: rotate clockwise and add the angle; y < 0: counterclockwise and subtract it
+  logic signed [BITS+1:0] delta_x, delta_y;
+  logic signed [BITS-1:0] delta_z;
+  assign delta_x = ( i_y[BITS+1] ? -i_y :  i_y ) >>> STAGE;
+  assign delta_y = ( i_y[BITS+1] ?  i_x : -i_x ) >>> STAGE;
+  assign delta_z = ( i_y[BITS+1] ? round(-ATAN[STAGE], BITS) >>> (MAX_D_WIDTH - BITS) :
+                                   round( ATAN[STAGE], BITS) >>> (MAX_D_WIDTH - BITS) );
+
+  always_ff @(posedge i_clk)
+    if (!i_rst_n) begin
+      o_valid   <= 1'b0;
+      o_quad    <= '0;
+      o_x       <= '0;
+      o_y       <= '0;
+      o_z       <= '0;
+    end else if (i_pipeline_en) begin
+      o_valid   <= i_valid;
+      o_quad    <= i_quad;
+      o_x       <= i_x + delta_x;
+      o_y       <= i_y + delta_y;
+      o_z       <= i_z + delta_z;
+    end
+
+endmodule
@@ -0,0 +1,98 @@
+//
+// File:        async_fifo.sv
+// Author:      agent
+// Date:        10/2026
+// Description: Generic parametrized dual-clock FIFO for clock domain crossing. Pointers cross in
+//              Gray code through two-flop synchronizers, so o_full and o_empty are pessimistic by
+//              up to three cycles of the other clock but never wrong. The read side is first word
+//              fall through: o_rd_data is the head while o_empty is low. DEPTH is a power of 2 and
+//              at least 4.
+//
+// Copyright (C) 2021, Grant Yu
+//
+// This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+// 
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+// 
+//    You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+`default_nettype none
+
+module async_fifo #(
+    parameter WIDTH = 8,
+    parameter DEPTH = 16
+)
+(
+    input wire i_wr_clk,
+    input wire i_wr_rst_n,
+    input wire i_wr_en,
+    input wire [WIDTH-1:0] i_wr_data,
+    output wire o_full,
+
+    input wire i_rd_clk,
+    input wire i_rd_rst_n,
+    input wire i_rd_en,
+    output wire [WIDTH-1:0] o_rd_data,
+    output wire o_empty
+);
+
+localparam ADDR_WIDTH = $clog2(DEPTH);
+
+// memory, written in the write domain and read combinationally in the read domain
+logic [WIDTH-1:0] mem [DEPTH-1:0];
+
+// binary and Gray pointers of each side, and the other side's Gray pointer synchronized
+logic [ADDR_WIDTH:0] wr_ptr, wr_gray, rd_ptr, rd_gray;
+logic [ADDR_WIDTH:0] rd_gray_s1, rd_gray_s2, wr_gray_s1, wr_gray_s2;
+
+function automatic logic [ADDR_WIDTH:0] bin2gray(input logic [ADDR_WIDTH:0] b);
+    return b ^ (b >> 1);
+endfunction
+
+assign o_full       = (wr_gray == {~rd_gray_s2[ADDR_WIDTH:ADDR_WIDTH-1],
+                                    rd_gray_s2[ADDR_WIDTH-2:0]});
+assign o_empty      = (rd_gray == wr_gray_s2);
+assign o_rd_data    = mem[rd_ptr[ADDR_WIDTH-1:0]];
+
+// write domain
+always_ff @(posedge i_wr_clk)
+    if (i_wr_en && !o_full) mem[wr_ptr[ADDR_WIDTH-1:0]] <= i_wr_data;
+
+always_ff @(posedge i_wr_clk)
+    if (~i_wr_rst_n) begin
+        wr_ptr      <= '0;
+        wr_gray     <= '0;
+        rd_gray_s1  <= '0;
+        rd_gray_s2  <= '0;
+    end else begin
+        {rd_gray_s2, rd_gray_s1} <= {rd_gray_s1, rd_gray};
+        if (i_wr_en && !o_full) begin
+            wr_ptr  <= wr_ptr + 1;
+            wr_gray <= bin2gray(wr_ptr + 1);
+        end
+    end
+
+// read domain
+always_ff @(posedge i_rd_clk)
+    if (~i_rd_rst_n) begin
+        rd_ptr      <= '0;
+        rd_gray     <= '0;
+        wr_gray_s1  <= '0;
+        wr_gray_s2  <= '0;
+    end else begin
+        {wr_gray_s2, wr_gray_s1} <= {wr_gray_s1, wr_gray};
+        if (i_rd_en && !o_empty) begin
+            rd_ptr  <= rd_ptr + 1;
+            rd_gray <= bin2gray(rd_ptr + 1);
+        end
+    end
+
+endmodule
\ No newline at end of file
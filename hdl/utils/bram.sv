@@ -2,7 +2,8 @@
 // File:        bram.sv
 // Author:      Grant Yu
 // Date:        03/2021
-// Description: Generic parametrized block RAM with synchronous read and write
+// Description: Generic parametrized block RAM with synchronous read and write. With INIT_FILE set
+//              the contents are loaded with $readmemh, so it also serves as a ROM.
 //
 // Copyright (C) 2021, Grant Yu
 //
@@ -25,7 +26,8 @@
 module bram #(
     parameter ADDR_WIDTH    = 8,
     parameter DEPTH         = 256,
-    parameter DATA_WIDTH    = 8
+    parameter DATA_WIDTH    = 8,
+    parameter INIT_FILE     = ""
 )
 (
     input wire                     i_clk_wr, 
@@ -40,6 +42,9 @@ module bram #(
 
 logic [DATA_WIDTH-1:0] mem [DEPTH-1:0];
 
+initial
+    if (INIT_FILE != "") $readmemh(INIT_FILE, mem);
+
 always_ff @(posedge i_clk_wr)
     if (i_wr_en) mem[i_wr_addr]  <= i_wr_data;
 
@@ -0,0 +1,147 @@
+//
+// File:        cordic_selftest.sv
+// Author:      agent
+// Date:        10/2026
+// Description: At-speed self-test for CMD_SELFTEST. A 48-bit LFSR (lfsr.sv) loaded with the seed
+//              feeds cordic_lanes LANES angles (LFSR steps) per enabled cycle for count angles, every
+//              cos/sin result is folded into a CRC-32 signature in angle order, and the cycles from
+//              the first angle in to the last result out are counted. While busy it owns the
+//              cordic_lanes start/theta inputs (see top_module). The signature does not depend on
+//              LANES; the LANES CRC updates per cycle are one XOR network, which bounds LANES at a
+//              given clock.
+//
+// Copyright (C) 2021, Grant Yu
+//
+// This program is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+// 
+//     This program is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+// 
+//    You should have received a copy of the GNU General Public License
+//     along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+`default_nettype none
+
+import pkg_msg::*;
+
+module cordic_selftest #(
+  parameter LANES = 1                                   // angles per cycle, as cordic_lanes
+)
+  (
+    input wire                      i_clk,
+    input wire                      i_rst_n,
+    input wire                      i_pipeline_en,
+
+    // from uart_rx_msg
+    input wire                      i_start,
+    input wire  [47:0]              i_seed,
+    input wire  [31:0]              i_cnt,              // 0 means 2^32
+    output wire                     o_busy,
+
+    // to cordic
+    output wire [$clog2(LANES):0]   o_cordic_start_cnt,
+    output wire [LANES-1:0][47:0]   o_cordic_theta,
+
+    // from cordic
+    input wire  [$clog2(LANES):0]   i_cordic_done_cnt,
+    input wire  [LANES-1:0][47:0]   i_cordic_cos_theta,
+    input wire  [LANES-1:0][47:0]   i_cordic_sin_theta,
+
+    // to uart_tx_msg
+    output reg                      o_done,
+    output reg  [31:0]              o_signature,
+    output reg  [47:0]              o_cycles
+  );
+
+  logic busy;
+  logic [32:0] issue_cnt, result_cnt;
+  logic [31:0] crc, crc_next;
+  logic [47:0] cycles;
+  logic [47:0] lfsr_reg;
+  logic [LANES-1:0][47:0] lfsr_ahead;
+  logic [$clog2(LANES):0] issue_n;
+
+  localparam [$clog2(LANES):0] LANES_N = LANES;
+
+  // Up to LANES angles per cycle while any are left; a stalled pipeline would drop them, so wait
+  assign issue_n            = (!busy || !i_pipeline_en) ? '0 :
+                              (issue_cnt >= LANES)      ? LANES_N : issue_cnt[$clog2(LANES):0];
+  assign o_busy             = busy;
+  assign o_cordic_start_cnt = issue_n;
+
+  // LFSR angle generator, one state per lane; steps by the angles issued
+  lfsr #(
+    .N          (48),
+    .poly       (SELFTEST_LFSR_POLY),
+    .STEPS      (LANES)
+  ) lfsr_inst (
+    .i_clk,
+    .i_rst_n,
+    .i_count_en (issue_n != 0),
+    .i_steps    (issue_n),
+    .i_load     (i_start && !busy),
+    .i_seed     (i_seed),
+    .o_lfsr     (lfsr_reg),
+    .o_lfsr_ahead(lfsr_ahead)
+  );
+
+  genvar j;
+  generate
+    for (j = 0; j < LANES; j++) begin : THETA_GEN
+      assign o_cordic_theta[j] = selftest_theta(lfsr_ahead[j]);
+    end
+  endgenerate
+
+  // Results of this cycle folded in, in angle order
+  always_comb begin
+    crc_next = crc;
+    for (int k = 0; k < LANES; k++)
+      if (k < i_cordic_done_cnt)
+        crc_next = selftest_crc(crc_next, i_cordic_cos_theta[k], i_cordic_sin_theta[k]);
+  end
+
+  always_ff @(posedge i_clk)
+    if (!i_rst_n) begin
+      busy          <= 1'b0;
+      issue_cnt     <= '0;
+      result_cnt    <= '0;
+      crc           <= '1;
+      cycles        <= '0;
+      o_done        <= 1'b0;
+      o_signature   <= '0;
+      o_cycles      <= '0;
+    end else begin
+
+      o_done        <= 1'b0;
+
+      if (!busy) begin
+        if (i_start) begin
+          busy          <= 1'b1;
+          issue_cnt     <= (i_cnt == 0) ? 33'h1_0000_0000 : {1'b0, i_cnt};
+          result_cnt    <= (i_cnt == 0) ? 33'h1_0000_0000 : {1'b0, i_cnt};
+          crc           <= '1;
+          cycles        <= '0;
+        end
+      end else begin
+        cycles          <= cycles + 1;
+        issue_cnt       <= issue_cnt - issue_n;
+        if (i_cordic_done_cnt != 0) begin
+          crc           <= crc_next;
+          result_cnt    <= result_cnt - i_cordic_done_cnt;
+          if (result_cnt == i_cordic_done_cnt) begin
+            busy        <= 1'b0;
+            o_done      <= 1'b1;
+            o_signature <= crc_next;
+            o_cycles    <= cycles + 1;
+          end
+        end
+      end
+    end
+
+endmodule
\ No newline at end of file
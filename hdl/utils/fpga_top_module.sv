@@ -59,6 +59,7 @@ module fpga_top_module
                 .BAUD_RATE( 3_000_000 ) )
   top_module_inst (
       .i_clk    (pll_clk),
+      .i_lane_clk (pll_clk),     // a second clk_wiz_0 output for CORDIC_LANE_CLK_ASYNC
       .i_rst_n  (i_rst_n),
       .i_rx     (i_rx),
       .o_tx     (o_tx),
@@ -3,7 +3,9 @@
 // Author:      Grant Yu
 // Date:        03/2021
 // Description: Generic Galois-type LFSR with parametrized generator polynomial and 
-//              flow control signals including a load and count_enable signal.
+//              flow control signals including a load and count_enable signal. With STEPS > 1
+//              it advances by i_steps (up to STEPS) per count, and o_lfsr_ahead gives the states
+//              0 to STEPS-1 steps ahead of o_lfsr.
 //
 // Copyright (C) 2021, Grant Yu
 //
@@ -25,20 +27,39 @@
 
 module lfsr #(
   parameter N = 8,
-  parameter [7:0] poly = 8'h9b
+  parameter [N-1:0] poly = 8'h9b,
+  parameter STEPS = 1
 )
   (
     input wire i_clk,
     input wire i_rst_n,
     input wire i_count_en,
+    input wire [$clog2(STEPS):0] i_steps,
     input wire i_load,
     input wire [N-1:0] i_seed,
-    output reg [N-1:0] o_lfsr
+    output reg [N-1:0] o_lfsr,
+    output wire [STEPS-1:0][N-1:0] o_lfsr_ahead
   );
   
+  // State after k steps, one Galois step per stage
+  logic [N-1:0] ahead [STEPS+1];
+  
+  always_comb begin
+    ahead[0] = o_lfsr;
+    for (int k = 0; k < STEPS; k++)
+      ahead[k+1] = {ahead[k][N-2:0], 1'b0} ^ (poly & {N{ahead[k][N-1]}});
+  end
+  
+  genvar k;
+  generate
+    for (k = 0; k < STEPS; k++) begin : AHEAD_GEN
+      assign o_lfsr_ahead[k] = ahead[k];
+    end
+  endgenerate
+  
   always_ff @(posedge i_clk)
     if (!i_rst_n)           o_lfsr  <= '0;
     else if (i_load)        o_lfsr  <= i_seed;
-    else if (i_count_en)    o_lfsr  <= {o_lfsr[N-2:0], 1'b0} ^ (poly & {N{o_lfsr[N-1]}});
+    else if (i_count_en)    o_lfsr  <= ahead[i_steps];
  
 endmodule
\ No newline at end of file
@@ -26,7 +26,77 @@ parameter bit [7:0] POLY = 8'h9b;
 parameter bit [7:0] BYTE_HEADER         = 8'h5a;
 parameter bit [7:0] CMD_SINGLE_TRANS    = 8'hd1;
 parameter bit [7:0] CMD_BURST_TRANS     = 8'hd2;
+parameter bit [7:0] CMD_STREAM_TRANS    = 8'hd3;
+parameter bit [7:0] CMD_VECTOR_TRANS    = 8'hd4;
+parameter bit [7:0] CMD_SELFTEST        = 8'hd5;
 parameter bit [7:0] CMD_DISABLE         = 8'he1;
 parameter bit [7:0] CMD_ENABLE          = 8'he2;
 
+// CMD_STREAM_TRANS: header, cmd, mode, count (2 bytes, LSB first, 0 means 65536), count thetas,
+// crc. The response echoes header, cmd, mode and count, then cos and sin per angle, then crc.
+// Mode [1:0] selects the cos/sin width, [2] rounds them to nearest instead of truncating, and
+// [4:3] selects the theta width. Widths are 16/24/32/48 bits taken from the top of the 48-bit
+// values, LSB first. The response queues 2*result bytes per angle while the request delivers
+// theta bytes, so the host paces anything wider than the TX FIFO can absorb.
+parameter bit [1:0] STREAM_WIDTH_16     = 2'd0;
+parameter bit [1:0] STREAM_WIDTH_24     = 2'd1;
+parameter bit [1:0] STREAM_WIDTH_32     = 2'd2;
+parameter bit [1:0] STREAM_WIDTH_48     = 2'd3;
+parameter int       STREAM_MODE_ROUND   = 2;
+
+// CMD_VECTOR_TRANS: header, cmd, x, y (6 bytes each, 2.46 like the cos/sin results, LSB first),
+// crc. The response is header, cmd, magnitude (2.46), atan2(y, x) (4.44 like theta), crc; the
+// magnitude must stay below 2.
+
+// CMD_SELFTEST: header, cmd, seed (6 bytes), count (4 bytes, 0 means 2^32), crc, all LSB first.
+// cordic_selftest feeds count LFSR angles to cordic_lanes, one per lane per cycle, and folds every
+// cos/sin result into a CRC-32 in angle order. The response is header, cmd, signature (4 bytes),
+// cycles (6 bytes), crc; cycles runs from the first angle in to the last result out, so
+// ceil(count/lanes) + pipeline latency when nothing stalls (with the lanes on i_clk). A zero seed
+// keeps the LFSR, and every theta, at 0.
+parameter bit [47:0] SELFTEST_LFSR_POLY = 48'h800000300001;    // taps 48, 47, 21, 20
+parameter bit [31:0] SELFTEST_CRC_POLY  = 32'h04c11db7;
+
+// Theta of an LFSR state: the state as a signed 4.44 value halved, so |theta| <= 4 < 2pi
+function automatic logic [47:0] selftest_theta(input logic [47:0] state);
+  return {state[47], state[47:1]};
+endfunction
+
+// CRC-32 (MSB first, no reflection) of one result: the 12 bytes cos then sin as uart_tx_msg sends
+// them, each byte MSB first
+function automatic logic [31:0] selftest_crc(input logic [31:0] crc, input logic [47:0] cos_theta,
+                                             input logic [47:0] sin_theta);
+  logic [95:0] bytes;
+  logic [7:0]  b;
+  bytes = {sin_theta, cos_theta};
+  for (int i = 0; i < 12; i++) begin
+    b = bytes[8*i +: 8];
+    for (int j = 7; j >= 0; j--)
+      crc = {crc[30:0], 1'b0} ^ (SELFTEST_CRC_POLY & {32{crc[31] ^ b[j]}});
+  end
+  return crc;
+endfunction
+
+// Bytes per value for a stream width select
+function automatic logic [2:0] stream_width_bytes(input logic [1:0] sel);
+  case (sel)
+    STREAM_WIDTH_16:  return 3'd2;
+    STREAM_WIDTH_24:  return 3'd3;
+    STREAM_WIDTH_32:  return 3'd4;
+    default:          return 3'd6;
+  endcase
+endfunction
+
+// Top bytes of a 2.46 result, truncated or rounded half up, moved down to the low bytes. |v| is at
+// most 1.0, so the rounding cannot overflow.
+function automatic logic [47:0] stream_result(input logic [47:0] v, input logic [7:0] mode);
+  logic [5:0]         drop;
+  logic signed [47:0] r;
+  drop = 6'd48 - 6'(8*stream_width_bytes(mode[1:0]));
+  r    = v;
+  if (mode[STREAM_MODE_ROUND] && drop != 0)
+    r  = r + (48'sd1 <<< (drop - 1));
+  return r >>> drop;
+endfunction
+
 endpackage
\ No newline at end of file
@@ -3,7 +3,8 @@
 // Author:      Grant Yu
 // Date:        03/2021
 // Description: Generic parametrized synchronous FIFO using a block RAM implementation. Has access
-//              to 2^WIDTH memory slots and internal write/read pointer widths of WIDTH+1.
+//              to 2^WIDTH memory slots and internal write/read pointer widths of WIDTH+1. o_count is
+//              the occupancy (0..DEPTH), for flow control ahead of o_full.
 //
 // Copyright (C) 2021, Grant Yu
 //
@@ -35,7 +36,8 @@ module sync_fifo #(
     input wire [WIDTH-1:0] i_wr_data,
     output reg [WIDTH-1:0] o_rd_data,
     output wire o_full,
-    output wire o_empty
+    output wire o_empty,
+    output wire [$clog2(DEPTH):0] o_count
 );
 
 localparam ADDR_WIDTH = $clog2(DEPTH);
@@ -66,6 +68,7 @@ assign ram_wr_en    = ((i_wr_en)&&(!o_full));
 assign o_empty      = (wr_ptr==rd_ptr);
 assign o_full       = (wr_ptr=={~rd_ptr[ADDR_WIDTH],
                                  rd_ptr[ADDR_WIDTH-1:0]});
+assign o_count      = wr_ptr - rd_ptr;
 
 always_ff @(posedge i_clk)
     if (~i_rst_n) begin
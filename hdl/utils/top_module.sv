@@ -3,7 +3,14 @@
 // Author:      Grant Yu
 // Date:        03/2021
 // Description: Top-level module for a CORDIC demonstration design that includes UART communications
-//              as well as a custom messaging protocol.
+//              as well as a custom messaging protocol. The CORDIC pipelines are held while the TX FIFO
+//              (TX_FIFO_DEPTH bytes, a power of 2) has less than TX_FIFO_MARGIN bytes free, so
+//              responses wait instead of being dropped; o_tx_overrun flags the case backpressure
+//              cannot cover (a host with more response bytes outstanding than the FIFO holds).
+//              UART_OVERSAMPLE (4, 8 or 16) must keep BAUD_RATE*UART_OVERSAMPLE within CLK_FREQ,
+//              e.g. 8 for 12 Mbaud at 100 MHz. CORDIC_LANES sin/cos pipelines (cordic_lanes) take
+//              the self-test angles CORDIC_LANES per cycle; with CORDIC_LANE_CLK_ASYNC they run on
+//              i_lane_clk, otherwise i_lane_clk is unused and can be tied to i_clk.
 //
 // Copyright (C) 2021, Grant Yu
 //
@@ -23,17 +30,29 @@
 
 `default_nettype none
 
-module top_module #(CLK_FREQ, BAUD_RATE)
+module top_module #(CLK_FREQ, BAUD_RATE, CORDIC_SEED_BITS = 0, CORDIC_SEED_ROM_FILE = "",
+                    TX_FIFO_DEPTH = 1024, UART_OVERSAMPLE = 16,
+                    CORDIC_LANES = 1, CORDIC_LANE_CLK_ASYNC = 0)
   (
     input wire i_clk,
+    input wire i_lane_clk,
     input wire i_rst_n,
     input wire i_rx,
     output wire o_tx,
     output wire o_rx_err,
     output wire o_rx_msg_err,
-    output wire o_cordic_pipeline_en
+    output wire o_cordic_pipeline_en,
+    output wire o_tx_overrun
   );
 
+  // Free TX FIFO bytes below which the CORDIC pipelines hold: one angle's worth of response from
+  // uart_tx_msg (at most 18 bytes, a STREAM header + 12 result bytes + crc) plus slack for the
+  // registered stall
+  localparam TX_FIFO_MARGIN = 32;
+  // Message angles held while one is in flight or the FIFO is nearly full (see below)
+  localparam SKID_DEPTH = 16;
+  localparam SKID_PTR_W = $clog2(SKID_DEPTH);
+
   // Reset synchronizer for system
   logic [1:0] sync_reg;
   logic sync_rst_n;
@@ -44,6 +63,16 @@ module top_module #(CLK_FREQ, BAUD_RATE)
 
   assign sync_rst_n = sync_reg[1];
   
+  // Reset synchronizer for the CORDIC lanes clock
+  logic [1:0] lane_sync_reg;
+  logic lane_rst_n;
+
+  always_ff @(posedge i_lane_clk or negedge i_rst_n)
+    if (!i_rst_n) lane_sync_reg <= 2'b00;
+    else          lane_sync_reg <= {lane_sync_reg[0], 1'b1};
+
+  assign lane_rst_n = lane_sync_reg[1];
+  
   logic [7:0] rx_byte;
   logic rx_byte_valid, rx_err;
 
@@ -53,7 +82,7 @@ module top_module #(CLK_FREQ, BAUD_RATE)
   uart_rx #(
     .CLK_FREQ_MHZ   (CLK_FREQ),
     .BAUD_RATE      (BAUD_RATE),
-    .OVERSAMPLE_RATE(16),
+    .OVERSAMPLE_RATE(UART_OVERSAMPLE),
     .NUM_DATA_BITS  (8),
     .PARITY_ON      (1),
     .PARITY_EO      (1)
@@ -70,10 +99,18 @@ module top_module #(CLK_FREQ, BAUD_RATE)
   logic cmd_reg_valid;
   logic [7:0] burst_cnt;
   logic burst_cnt_valid;
+  logic [7:0] stream_mode;
+  logic [15:0] stream_cnt;
+  logic stream_valid;
   logic rx_msg_err;
   logic cordic_start;
   logic [47:0] cordic_theta;
   logic cordic_pipeline_en;
+  logic vector_start;
+  logic [47:0] vector_x, vector_y;
+  logic selftest_start;
+  logic [47:0] selftest_seed;
+  logic [31:0] selftest_cnt;
 
   assign o_cordic_pipeline_en = cordic_pipeline_en;
   assign o_rx_msg_err = rx_msg_err;
@@ -93,36 +130,195 @@ module top_module #(CLK_FREQ, BAUD_RATE)
     .o_cmd_reg_valid    (cmd_reg_valid),
     .o_burst_cnt        (burst_cnt),
     .o_burst_cnt_valid  (burst_cnt_valid),
+    .o_stream_mode      (stream_mode),
+    .o_stream_cnt       (stream_cnt),
+    .o_stream_valid     (stream_valid),
     .o_rx_msg_err       (rx_msg_err),
     
     // out to cordic
     .o_cordic_start         (cordic_start),
     .o_cordic_theta         (cordic_theta),
-    .o_cordic_pipeline_en   (cordic_pipeline_en)
+    .o_cordic_pipeline_en   (cordic_pipeline_en),
+    
+    // out to cordic vectoring
+    .o_vector_start         (vector_start),
+    .o_vector_x             (vector_x),
+    .o_vector_y             (vector_y),
+    
+    // out to cordic selftest
+    .o_selftest_start       (selftest_start),
+    .o_selftest_seed        (selftest_seed),
+    .o_selftest_cnt         (selftest_cnt)
   );
   
-  logic cordic_done;
-  logic [47:0] cordic_sin_theta, cordic_cos_theta;
+  logic [7:0] tx_byte;
+  logic tx_byte_valid;
+  logic fifo_wr_en, fifo_rd_en, fifo_full, fifo_empty;
+  logic [$clog2(TX_FIFO_DEPTH):0] fifo_count;
+  localparam LANE_CNT_W = $clog2(CORDIC_LANES) + 1;
+
+  logic tx_stall, cordic_run, cordic_ready, tx_msg_busy;
+  logic [LANE_CNT_W-1:0] cordic_start_cnt, cordic_done_cnt;
+  logic selftest_busy, vector_done;
+  logic cordic_slot, cordic_issue, cordic_inflight;
+  logic [47:0] skid_theta [SKID_DEPTH];
+  logic [SKID_PTR_W:0] skid_wr_ptr, skid_rd_ptr;
+  logic skid_empty, skid_full, skid_push, skid_lost;
+  logic vector_slot, vector_pend, vector_issue, vector_inflight;
+  logic [47:0] vector_pend_x, vector_pend_y;
+  logic tx_overrun;
+
+  // TX backpressure: while the FIFO is nearly full the CORDIC pipelines hold, so no result reaches
+  // uart_tx_msg until its bytes fit. Nothing is lost as long as the host keeps its outstanding
+  // response bytes below TX_FIFO_DEPTH - TX_FIFO_MARGIN; a faster host gets stalls, which the skids
+  // ride out, and then o_tx_overrun once an angle finds its skid full.
+  //
+  // uart_tx_msg takes one result at a time, so an angle is issued only when no other one is in
+  // flight and uart_tx_msg is not writing bytes. Angles that cannot issue wait in a SKID_DEPTH
+  // entry skid FIFO, which covers a stall of one result's bytes (at most 18) at STREAM's fastest
+  // input rate (a 16-bit theta every 2 bytes). A VECTOR takes 12 bytes to arrive, so its skid has
+  // one entry. A DISABLEd pipeline still drops arrivals, a message error clears the skids, and a
+  // full CDC FIFO ahead of asynchronous lanes holds everything the same way.
+  assign tx_stall       = (fifo_count > TX_FIFO_DEPTH - TX_FIFO_MARGIN);
+  assign cordic_run     = cordic_pipeline_en && !tx_stall && cordic_ready;
+  assign cordic_slot    = cordic_run && !cordic_inflight && !vector_inflight && !tx_msg_busy && !selftest_busy;
+  assign vector_slot    = cordic_run && !cordic_inflight && !vector_inflight && !tx_msg_busy && !cordic_issue;
+  assign skid_empty     = (skid_wr_ptr == skid_rd_ptr);
+  assign skid_full      = (skid_wr_ptr == {~skid_rd_ptr[SKID_PTR_W], skid_rd_ptr[SKID_PTR_W-1:0]});
+  assign cordic_issue   = cordic_slot && (cordic_start || !skid_empty);
+  assign skid_push      = cordic_start && cordic_pipeline_en && !(cordic_slot && skid_empty) && !skid_full;
+  assign skid_lost      = cordic_start && cordic_pipeline_en && !(cordic_slot && skid_empty) && skid_full;
+  assign vector_issue   = vector_slot && (vector_start || vector_pend);
+  assign o_tx_overrun   = tx_overrun;
+
+  always_ff @(posedge i_clk)
+    if (!sync_rst_n) begin
+      skid_theta        <= '{default:'0};
+      skid_wr_ptr       <= '0;
+      skid_rd_ptr       <= '0;
+      cordic_inflight   <= 1'b0;
+      vector_pend       <= 1'b0;
+      vector_pend_x     <= '0;
+      vector_pend_y     <= '0;
+      vector_inflight   <= 1'b0;
+      tx_overrun        <= 1'b0;
+    end else begin
+      if (skid_push) begin
+        skid_theta[skid_wr_ptr[SKID_PTR_W-1:0]] <= cordic_theta;
+        skid_wr_ptr         <= skid_wr_ptr + 1;
+      end
+      if (cordic_slot && !skid_empty)
+        skid_rd_ptr         <= skid_rd_ptr + 1;
+
+      if (vector_start && cordic_pipeline_en && (vector_pend || !vector_slot)) begin
+        if (vector_pend && !vector_slot)
+          tx_overrun        <= 1'b1;
+        else begin
+          vector_pend       <= 1'b1;
+          vector_pend_x     <= vector_x;
+          vector_pend_y     <= vector_y;
+        end
+      end else if (vector_slot)
+        vector_pend         <= 1'b0;
+
+      // Set on issue, cleared as the result goes to uart_tx_msg
+      if (cordic_issue)
+        cordic_inflight     <= 1'b1;
+      else if ((cordic_done_cnt != 0) && cordic_run)
+        cordic_inflight     <= 1'b0;
+      if (vector_issue)
+        vector_inflight     <= 1'b1;
+      else if (vector_done && cordic_run)
+        vector_inflight     <= 1'b0;
+
+      if (rx_msg_err) begin
+        skid_wr_ptr         <= '0;
+        skid_rd_ptr         <= '0;
+        vector_pend         <= 1'b0;
+      end
+
+      // Only reachable when the stall could not hold everything back
+      if (skid_lost || (tx_byte_valid && fifo_full))
+        tx_overrun          <= 1'b1;
+    end
+
+  logic [CORDIC_LANES-1:0][47:0] cordic_theta_lanes, cordic_sin_theta, cordic_cos_theta;
+  logic [LANE_CNT_W-1:0] selftest_cordic_start_cnt;
+  logic [CORDIC_LANES-1:0][47:0] selftest_cordic_theta;
+  logic selftest_done;
+  logic [31:0] selftest_signature;
+  logic [47:0] selftest_cycles;
   
+  // CORDIC SELFTEST, owns the CORDIC inputs and results while busy
+  cordic_selftest #(
+    .LANES              (CORDIC_LANES)
+  ) cordic_selftest_module (
+    .i_clk,
+    .i_rst_n            (sync_rst_n),
+    .i_pipeline_en      (cordic_run),
+    .i_start            (selftest_start),
+    .i_seed             (selftest_seed),
+    .i_cnt              (selftest_cnt),
+    .o_busy             (selftest_busy),
+    .o_cordic_start_cnt (selftest_cordic_start_cnt),
+    .o_cordic_theta     (selftest_cordic_theta),
+    .i_cordic_done_cnt  (cordic_run ? cordic_done_cnt : '0),
+    .i_cordic_cos_theta (cordic_cos_theta),
+    .i_cordic_sin_theta (cordic_sin_theta),
+    .o_done             (selftest_done),
+    .o_signature        (selftest_signature),
+    .o_cycles           (selftest_cycles)
+  );
+  
+  // Message angles go in one at a time through lane slot 0
+  always_comb begin
+    cordic_start_cnt        = selftest_busy ? selftest_cordic_start_cnt : LANE_CNT_W'(cordic_issue);
+    cordic_theta_lanes      = selftest_cordic_theta;
+    if (!selftest_busy)
+      cordic_theta_lanes[0] = skid_empty ? cordic_theta : skid_theta[skid_rd_ptr[SKID_PTR_W-1:0]];
+  end
+
   // CORDIC
-  cordic_sincos #(
-    .STAGES     (48),
-    .BITS       (48)
+  cordic_lanes #(
+    .STAGES         (48),
+    .BITS           (48),
+    .SEED_BITS      (CORDIC_SEED_BITS),
+    .SEED_ROM_FILE  (CORDIC_SEED_ROM_FILE),
+    .LANES          (CORDIC_LANES),
+    .LANE_CLK_ASYNC (CORDIC_LANE_CLK_ASYNC)
   ) cordic_sincos_module (
     .i_clk,
     .i_rst_n        (sync_rst_n),
-    .i_pipeline_en  (cordic_pipeline_en),
-    .i_start        (cordic_start),
-    .i_theta        (cordic_theta),            
-    .o_done         (cordic_done),
-    .o_sin_theta    (cordic_sin_theta),  
-    .o_cos_theta    (cordic_cos_theta)   
+    .i_lane_clk,
+    .i_lane_rst_n   (lane_rst_n),
+    .i_pipeline_en  (cordic_run),
+    .i_start_cnt    (cordic_start_cnt),
+    .i_theta        (cordic_theta_lanes),
+    .o_ready        (cordic_ready),
+    .o_done_cnt     (cordic_done_cnt),
+    .o_sin_theta    (cordic_sin_theta),
+    .o_cos_theta    (cordic_cos_theta)
   );
- 
-  logic [7:0] tx_byte;
-  logic tx_byte_valid;
   
-  // TX MSG
+  logic [47:0] vector_magnitude, vector_atan;
+  
+  // CORDIC VECTORING (atan2 and magnitude), shares the DISABLE/ENABLE pipeline enable and the stall
+  cordic_vectoring #(
+    .STAGES         (48),
+    .BITS           (48)
+  ) cordic_vectoring_module (
+    .i_clk,
+    .i_rst_n        (sync_rst_n),
+    .i_pipeline_en  (cordic_run),
+    .i_start        (vector_issue),
+    .i_x            (vector_pend ? vector_pend_x : vector_x),
+    .i_y            (vector_pend ? vector_pend_y : vector_y),
+    .o_done         (vector_done),
+    .o_magnitude    (vector_magnitude),
+    .o_atan         (vector_atan)
+  );
+ 
+  // TX MSG, a held pipeline keeps its last result on the outputs so results count only while running
   uart_tx_msg uart_tx_msg_module (
     .i_clk,
     .i_rst_n            (sync_rst_n),
@@ -132,19 +328,32 @@ module top_module #(CLK_FREQ, BAUD_RATE)
     .i_cmd_valid        (cmd_reg_valid),
     .i_burst_cnt        (burst_cnt),
     .i_burst_cnt_valid  (burst_cnt_valid),
+    .i_stream_mode      (stream_mode),
+    .i_stream_cnt       (stream_cnt),
+    .i_stream_valid     (stream_valid),
     .i_rx_msg_err       (rx_msg_err),
     
     // from cordic
-    .i_cordic_sin_theta (cordic_sin_theta),
-    .i_cordic_cos_theta (cordic_cos_theta),
-    .i_cordic_done      (cordic_done),
+    .i_cordic_sin_theta (cordic_sin_theta[0]),
+    .i_cordic_cos_theta (cordic_cos_theta[0]),
+    .i_cordic_done      ((cordic_done_cnt != 0) && cordic_run && !selftest_busy),
+    
+    // from cordic vectoring
+    .i_vector_magnitude (vector_magnitude),
+    .i_vector_atan      (vector_atan),
+    .i_vector_done      (vector_done && cordic_run),
+    
+    // from cordic selftest
+    .i_selftest_signature   (selftest_signature),
+    .i_selftest_cycles      (selftest_cycles),
+    .i_selftest_done        (selftest_done),
     
     // to uart tx
     .o_tx_byte          (tx_byte),
-    .o_tx_byte_valid    (tx_byte_valid)
+    .o_tx_byte_valid    (tx_byte_valid),
+    .o_busy             (tx_msg_busy)
   );
   
-  logic fifo_wr_en, fifo_rd_en, fifo_full, fifo_empty;
   logic [7:0] fifo_wr_data, fifo_rd_data;
   
   assign fifo_wr_en = ((tx_byte_valid)&&(!fifo_full));
@@ -153,7 +362,7 @@ module top_module #(CLK_FREQ, BAUD_RATE)
   // FIFO between TX MSG and TX
   sync_fifo #(
     .WIDTH  (8),
-    .DEPTH  (64)
+    .DEPTH  (TX_FIFO_DEPTH)
   ) sync_fifo_inst (
     .i_clk,
     .i_rst_n    (sync_rst_n),
@@ -162,7 +371,8 @@ module top_module #(CLK_FREQ, BAUD_RATE)
     .i_wr_data  (fifo_wr_data),
     .o_rd_data  (fifo_rd_data),
     .o_full     (fifo_full),
-    .o_empty    (fifo_empty)
+    .o_empty    (fifo_empty),
+    .o_count    (fifo_count)
   );
   
   // UART TX
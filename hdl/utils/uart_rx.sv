@@ -2,7 +2,11 @@
 // File:        uart_rx.sv
 // Author:      Grant Yu
 // Date:        03/2021
-// Description: Generic parametrized UART receiver module 
+// Description: Generic parametrized UART receiver module. Samples come from a fractional
+//              (phase accumulator) tick generator, so the average sample rate is exact for any
+//              CLK_FREQ/BAUD_RATE ratio. Each bit is decided by a majority vote of the three samples
+//              around its middle, counted from the start bit edge. o_rx_err flags a parity error
+//              (the byte is not valid) or a low stop bit (framing error, after the byte).
 //
 // Copyright (C) 2021, Grant Yu
 //
@@ -25,7 +29,7 @@
 module uart_rx #(
   parameter CLK_FREQ_MHZ    = 100_000_000,
   parameter BAUD_RATE       =   3_000_000,
-  parameter OVERSAMPLE_RATE =          16, // Common choices: 8 or 16
+  parameter OVERSAMPLE_RATE =          16, // 4, 8 or 16, with BAUD_RATE*OVERSAMPLE_RATE <= CLK_FREQ_MHZ
   parameter NUM_DATA_BITS   =           8, // Within 5-9
   parameter PARITY_ON       =           1, // 0: Parity disabled. 1: Parity enabled.
   parameter PARITY_EO       =           1  // 0: Even parity. 1: Odd parity.
@@ -43,9 +47,9 @@ module uart_rx #(
   localparam EVEN_PAR = 0;
   localparam ODD_PAR  = 1;
   
-  // Synchronize rx line into FPGA clock domain
+  // Synchronize rx line into FPGA clock domain, plus one more stage for the start edge
   logic [2:0] rx_sync;
-  logic rx;
+  logic rx, rx_d;
   
   assign rx = rx_sync[2];
   
@@ -53,19 +57,33 @@ module uart_rx #(
     if (!i_rst_n) rx_sync <= 3'b000;
     else          rx_sync <= {rx_sync[1:0], i_rx};
   
-  // Oversample pulse generation
-  localparam OVERSAMP_PULSEGEN_MAX = int'(real'(CLK_FREQ_MHZ) / (real'(BAUD_RATE)*real'(OVERSAMPLE_RATE)));  
-  logic [$clog2(OVERSAMP_PULSEGEN_MAX)-1:0] oversamp_pulsegen;
+  // Oversample tick generation: the accumulator carries BAUD_RATE*OVERSAMPLE_RATE times per second
+  // on average, so ticks are floor or ceil of the ideal period apart and no error builds up
+  localparam SAMPLE_ACC_BITS  = 32;
+  localparam longint SAMPLE_INC = longint'(real'(BAUD_RATE) * real'(OVERSAMPLE_RATE) * (2.0**SAMPLE_ACC_BITS)
+                                           / real'(CLK_FREQ_MHZ));
+  logic [SAMPLE_ACC_BITS:0] sample_acc;
+  logic sample_tick;
   
-  // Oversample counter
+  assign sample_tick = sample_acc[SAMPLE_ACC_BITS];
+  
+  // Oversample counter, the sample position within a bit counted from the start edge. The middle
+  // of a bit is at count MID-1; samples MID-2, MID-1 and MID vote and the bit is decided at MID.
   localparam OVERSAMP_CNT_MAX = OVERSAMPLE_RATE;
+  localparam MID              = OVERSAMPLE_RATE/2;
   logic [$clog2(OVERSAMP_CNT_MAX)-1:0] oversamp_cnt;
+  logic [1:0] votes;
+  logic bit_val, bit_done;
+  
+  assign bit_val  = (votes[1] & votes[0]) | (votes[1] & rx) | (votes[0] & rx);
+  assign bit_done = sample_tick && (oversamp_cnt == MID);
   
   // Byte index register
   logic [$clog2(NUM_DATA_BITS)-1:0] idx;
   
   // Control FSM
-  typedef enum {RX_START, 
+  typedef enum {RX_IDLE,
+                RX_START, 
                 RX_DATA, 
                 RX_PARITY,
                 RX_STOP} state_t;
@@ -73,108 +91,107 @@ module uart_rx #(
   
   always_ff @(posedge i_clk)
     if (!i_rst_n) begin
-      oversamp_pulsegen <= '0;
+      rx_d              <= 1'b1;
+      sample_acc        <= '0;
       oversamp_cnt      <= '0;
+      votes             <= '0;
       idx               <= '0;
       o_rx_byte         <= '0;
       o_rx_err          <= 1'b0;
       o_rx_byte_valid   <= 1'b0;
-      state             <= RX_START;
+      state             <= RX_IDLE;
     end else begin
+      
+      rx_d              <= rx;
+      o_rx_err          <= 1'b0;
+      o_rx_byte_valid   <= 1'b0;
+      
+      sample_acc        <= sample_acc[SAMPLE_ACC_BITS-1:0] + SAMPLE_INC;
+      if (sample_tick) begin
+        votes           <= {votes[0], rx};
+        oversamp_cnt    <= (oversamp_cnt == OVERSAMP_CNT_MAX - 1) ? '0 : oversamp_cnt + 1;
+      end
+      
       case (state)
       
-        RX_START: begin
-          
-          o_rx_err          <= 1'b0;
-          o_rx_byte_valid   <= 1'b0;
+        RX_IDLE: begin
           
-          if (!rx) begin
-            oversamp_pulsegen   <= oversamp_pulsegen + 1;
-            if (oversamp_pulsegen == OVERSAMP_PULSEGEN_MAX - 1) begin
-              oversamp_pulsegen <= '0;
-              oversamp_cnt      <= oversamp_cnt + 1;
-              if (oversamp_cnt == OVERSAMP_CNT_MAX/2 - 1) begin
-                oversamp_cnt    <= '0;
-                state           <= RX_DATA;
-              end
-            end
-          end else begin
-            oversamp_pulsegen   <= '0;  
-            oversamp_cnt        <= '0;
+          // Falling edge of the start bit restarts the sample phase, one clock ahead since the
+          // edge is seen up to a cycle after it happened
+          if (rx_d && !rx) begin
+            sample_acc      <= 2*SAMPLE_INC;
+            oversamp_cnt    <= '0;
+            state           <= RX_START;
           end
+          
+        end
+      
+        RX_START: begin
+          
+          // A start bit that is high again by its middle was a glitch
+          if (bit_done)
+            state           <= bit_val ? RX_IDLE : RX_DATA;
                         
         end
         
         RX_DATA: begin
           
-          o_rx_err          <= 1'b0;
-          o_rx_byte_valid   <= 1'b0;
-          
-          oversamp_pulsegen     <= oversamp_pulsegen + 1;
-          if (oversamp_pulsegen == OVERSAMP_PULSEGEN_MAX - 1) begin
-              oversamp_pulsegen <= '0;
-              oversamp_cnt      <= oversamp_cnt + 1;
-              if (oversamp_cnt == OVERSAMP_CNT_MAX - 1) begin
-                oversamp_cnt        <= '0;
-                idx                 <= idx + 1;
-                o_rx_byte           <= {rx, o_rx_byte[NUM_DATA_BITS-1:1]};
-                if (idx == NUM_DATA_BITS - 1)
-                  if (PARITY_ON)
-                    state           <= RX_PARITY;
-                  else
-                    state           <= RX_START;
-              end
+          if (bit_done) begin
+            idx             <= idx + 1;
+            o_rx_byte       <= {bit_val, o_rx_byte[NUM_DATA_BITS-1:1]};
+            if (idx == NUM_DATA_BITS - 1) begin
+              idx           <= '0;
+              state         <= PARITY_ON ? RX_PARITY : RX_STOP;
+            end
           end
           
         end
         
         RX_PARITY: begin
           
-          o_rx_err          <= 1'b0;
-          o_rx_byte_valid   <= 1'b0;
-          
-          oversamp_pulsegen     <= oversamp_pulsegen + 1;
-          if (oversamp_pulsegen == OVERSAMP_PULSEGEN_MAX - 1) begin
-              oversamp_pulsegen <= '0;
-              oversamp_cnt      <= oversamp_cnt + 1;
-              if (oversamp_cnt == OVERSAMP_CNT_MAX - 1) begin
-                oversamp_cnt    <= '0;
-                state           <= RX_STOP;
-                o_rx_err        <= ( (PARITY_EO==EVEN_PAR && ((^o_rx_byte) ^ rx)) || 
-                                     (PARITY_EO==ODD_PAR  && ~((^o_rx_byte) ^ rx)) );
-                o_rx_byte_valid <= ( (PARITY_EO==EVEN_PAR && ~((^o_rx_byte) ^ rx)) || 
-                                     (PARITY_EO==ODD_PAR  && ((^o_rx_byte) ^ rx)) );
-              end
+          if (bit_done) begin
+            state           <= RX_STOP;
+            o_rx_err        <= ( (PARITY_EO==EVEN_PAR && ((^o_rx_byte) ^ bit_val)) || 
+                                 (PARITY_EO==ODD_PAR  && ~((^o_rx_byte) ^ bit_val)) );
+            o_rx_byte_valid <= ( (PARITY_EO==EVEN_PAR && ~((^o_rx_byte) ^ bit_val)) || 
+                                 (PARITY_EO==ODD_PAR  && ((^o_rx_byte) ^ bit_val)) );
           end
           
         end
         
         RX_STOP: begin
         
-          o_rx_err          <= 1'b0;
-          o_rx_byte_valid   <= 1'b0;
-          
-          oversamp_pulsegen     <= oversamp_pulsegen + 1;
-          if (oversamp_pulsegen == OVERSAMP_PULSEGEN_MAX - 1) begin
-              oversamp_pulsegen <= '0;
-              oversamp_cnt      <= oversamp_cnt + 1;
-              if (oversamp_cnt == OVERSAMP_CNT_MAX - 1 && rx) begin
-                oversamp_cnt    <= '0;
-                state           <= RX_START;
-              end
+          // A fast transmitter's next start bit can begin before this one's vote is in, so its
+          // edge is taken here too, but only in the last sample period before the vote and once
+          // sample MID-1 has seen the stop bit high. An earlier edge (still in the previous bit,
+          // or early in the stop bit) is a parity or last data bit of 1 falling into a low stop
+          // bit, which the vote then flags as a framing error before going back to idle. A line
+          // still low (break) has no falling edge until it has been high again.
+          if (rx_d && !rx && oversamp_cnt == MID && votes[0]) begin
+            sample_acc      <= 2*SAMPLE_INC;
+            oversamp_cnt    <= '0;
+            state           <= RX_START;
+            if (!PARITY_ON)
+              o_rx_byte_valid <= 1'b1;
+          end else if (bit_done) begin
+            state           <= RX_IDLE;
+            o_rx_err        <= !bit_val;
+            if (!PARITY_ON)
+              o_rx_byte_valid <= bit_val;
           end
         
         end
         
         default: begin
           
-          oversamp_pulsegen <= '0;
+          sample_acc        <= '0;
           oversamp_cnt      <= '0;
+          votes             <= '0;
           idx               <= '0;
           o_rx_byte         <= '0;
           o_rx_err          <= 1'b0;
           o_rx_byte_valid   <= 1'b0;
-          state             <= RX_START;
+          state             <= RX_IDLE;
           
         end
           
@@ -182,4 +199,4 @@ module uart_rx #(
     end
   
   
-endmodule
\ No newline at end of file
+endmodule
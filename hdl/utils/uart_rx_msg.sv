@@ -40,12 +40,25 @@ module uart_rx_msg (
     output reg                      o_cmd_reg_valid,
     output reg  [7:0]               o_burst_cnt,
     output reg                      o_burst_cnt_valid,
+    output reg  [7:0]               o_stream_mode,
+    output reg  [15:0]              o_stream_cnt,
+    output reg                      o_stream_valid,
     output reg                      o_rx_msg_err,
     
     // out to cordic
     output reg                      o_cordic_start,
     output reg  [47:0]              o_cordic_theta,
-    output reg                      o_cordic_pipeline_en
+    output reg                      o_cordic_pipeline_en,
+    
+    // out to cordic vectoring
+    output reg                      o_vector_start,
+    output reg  [47:0]              o_vector_x,
+    output reg  [47:0]              o_vector_y,
+    
+    // out to cordic selftest
+    output reg                      o_selftest_start,
+    output reg  [47:0]              o_selftest_seed,
+    output reg  [31:0]              o_selftest_cnt
   );
   
   // LFSR module used to calculate CRC-8
@@ -59,6 +72,7 @@ module uart_rx_msg (
     .i_clk,
     .i_rst_n,
     .i_count_en (lfsr_count_en),
+    .i_steps    (1'b1),
     .i_load     (lfsr_load),
     .i_seed     (lfsr_seed),
     .o_lfsr     (lfsr_reg)
@@ -129,6 +143,14 @@ module uart_rx_msg (
                 STATE_SINGLE_TRANS,
                 STATE_BURST_TRANS,
                 STATE_BURST_TRANS_II,
+                STATE_STREAM_TRANS,
+                STATE_STREAM_TRANS_II,
+                STATE_STREAM_TRANS_III,
+                STATE_STREAM_TRANS_IV,
+                STATE_VECTOR_TRANS,
+                STATE_VECTOR_TRANS_II,
+                STATE_SELFTEST,
+                STATE_SELFTEST_II,
                 STATE_DISABLE,
                 STATE_ENABLE,
                 STATE_CRC_CHECK,
@@ -140,6 +162,10 @@ module uart_rx_msg (
   // RX msg registers
   logic [2:0] count2six;
   logic [7:0] count2burst;
+  logic [15:0] count2stream;
+  logic [2:0] theta_bytes;
+  logic [47:0] theta_mask;
+  logic selftest_req;
   
   always_ff @(posedge i_clk)
     
@@ -148,18 +174,35 @@ module uart_rx_msg (
         cmd_seq_state       <= STATE_HEADER;
         count2six           <= '0;
         count2burst         <= '0;
+        count2stream        <= '0;
+        theta_bytes         <= 3'd6;
+        theta_mask          <= '1;
         
         // to tx msg
         o_cmd_reg           <= '0;
         o_cmd_reg_valid     <= 1'b0;
         o_burst_cnt         <= '0;
         o_burst_cnt_valid   <= '0;
+        o_stream_mode       <= '0;
+        o_stream_cnt        <= '0;
+        o_stream_valid      <= 1'b0;
         o_rx_msg_err        <= 1'b0;
         
         // to cordic
         o_cordic_start      <= 1'b0;
         o_cordic_theta      <= '0;
         o_cordic_pipeline_en<= 1'b1;
+        
+        // to cordic vectoring
+        o_vector_start      <= 1'b0;
+        o_vector_x          <= '0;
+        o_vector_y          <= '0;
+        
+        // to cordic selftest
+        selftest_req        <= 1'b0;
+        o_selftest_start    <= 1'b0;
+        o_selftest_seed     <= '0;
+        o_selftest_cnt      <= '0;
       end
     else begin
       
@@ -168,6 +211,9 @@ module uart_rx_msg (
       o_cmd_reg_valid       <= 1'b0;
       o_burst_cnt           <= '0;
       o_burst_cnt_valid     <= '0;
+      o_stream_mode         <= o_stream_mode;
+      o_stream_cnt          <= o_stream_cnt;
+      o_stream_valid        <= 1'b0;
       o_rx_msg_err          <= 1'b0;
       
       // to cordic
@@ -175,12 +221,23 @@ module uart_rx_msg (
       o_cordic_theta        <= o_cordic_theta;
       o_cordic_pipeline_en  <= o_cordic_pipeline_en;
       
+      // to cordic vectoring
+      o_vector_start        <= 1'b0;
+      o_vector_x            <= o_vector_x;
+      o_vector_y            <= o_vector_y;
+      
+      // to cordic selftest
+      o_selftest_start      <= 1'b0;
+      o_selftest_seed       <= o_selftest_seed;
+      o_selftest_cnt        <= o_selftest_cnt;
+      
       case (cmd_seq_state)
         
         STATE_HEADER: begin
           cmd_seq_state <= STATE_HEADER;
           count2six     <= '0;
           count2burst   <= '0;
+          selftest_req  <= 1'b0;
           if (i_rx_byte_valid && i_rx_byte == BYTE_HEADER)
             cmd_seq_state   <= STATE_CMD;
         end
@@ -190,6 +247,9 @@ module uart_rx_msg (
             case (i_rx_byte)
               CMD_SINGLE_TRANS: cmd_seq_state   <= STATE_SINGLE_TRANS;
               CMD_BURST_TRANS:  cmd_seq_state   <= STATE_BURST_TRANS;
+              CMD_STREAM_TRANS: cmd_seq_state   <= STATE_STREAM_TRANS;
+              CMD_VECTOR_TRANS: cmd_seq_state   <= STATE_VECTOR_TRANS;
+              CMD_SELFTEST:     cmd_seq_state   <= STATE_SELFTEST;
               CMD_DISABLE:      cmd_seq_state   <= STATE_DISABLE;
               CMD_ENABLE:       cmd_seq_state   <= STATE_ENABLE;
               default:          cmd_seq_state   <= STATE_HEADER;
@@ -235,6 +295,94 @@ module uart_rx_msg (
           end
         end
         
+        STATE_STREAM_TRANS: begin
+          if (i_rx_byte_valid) begin
+            o_stream_mode   <= i_rx_byte;
+            theta_bytes     <= stream_width_bytes(i_rx_byte[4:3]);
+            theta_mask      <= {48{1'b1}} << (8*(6 - stream_width_bytes(i_rx_byte[4:3])));
+            cmd_seq_state   <= STATE_STREAM_TRANS_II;
+          end
+        end
+        
+        STATE_STREAM_TRANS_II: begin
+          if (i_rx_byte_valid) begin
+            count2stream[7:0]   <= i_rx_byte;
+            cmd_seq_state       <= STATE_STREAM_TRANS_III;
+          end
+        end
+        
+        STATE_STREAM_TRANS_III: begin
+          if (i_rx_byte_valid) begin
+            count2stream[15:8]  <= i_rx_byte;
+            o_stream_cnt        <= {i_rx_byte, count2stream[7:0]};
+            o_stream_valid      <= 1'b1;
+            cmd_seq_state       <= STATE_STREAM_TRANS_IV;
+          end
+        end
+        
+        // thetas arrive as their top theta_bytes; the bits below are cleared
+        STATE_STREAM_TRANS_IV: begin
+          if (i_rx_byte_valid) begin
+            o_cordic_theta  <= {i_rx_byte, o_cordic_theta[47:8]};
+            count2six       <= count2six + 1;
+            if (count2six == theta_bytes - 1) begin
+              count2six         <= '0;
+              o_cordic_theta    <= {i_rx_byte, o_cordic_theta[47:8]} & theta_mask;
+              o_cordic_start    <= 1'b1;
+              count2stream      <= count2stream - 1;
+              if (count2stream == 1) begin
+                cmd_seq_state       <= STATE_CRC_CHECK;
+              end
+            end
+          end
+        end
+        
+        STATE_VECTOR_TRANS: begin
+          if (i_rx_byte_valid) begin
+            o_vector_x      <= {i_rx_byte, o_vector_x[47:8]};
+            count2six       <= count2six + 1;
+            if (count2six == 5) begin
+              count2six         <= '0;
+              cmd_seq_state     <= STATE_VECTOR_TRANS_II;
+            end
+          end
+        end
+        
+        STATE_VECTOR_TRANS_II: begin
+          if (i_rx_byte_valid) begin
+            o_vector_y      <= {i_rx_byte, o_vector_y[47:8]};
+            count2six       <= count2six + 1;
+            if (count2six == 5) begin
+              count2six         <= '0;
+              o_vector_start    <= 1'b1;
+              cmd_seq_state     <= STATE_CRC_CHECK;
+            end
+          end
+        end
+        
+        STATE_SELFTEST: begin
+          if (i_rx_byte_valid) begin
+            o_selftest_seed <= {i_rx_byte, o_selftest_seed[47:8]};
+            count2six       <= count2six + 1;
+            if (count2six == 5) begin
+              count2six         <= '0;
+              cmd_seq_state     <= STATE_SELFTEST_II;
+            end
+          end
+        end
+        
+        STATE_SELFTEST_II: begin
+          if (i_rx_byte_valid) begin
+            o_selftest_cnt  <= {i_rx_byte, o_selftest_cnt[31:8]};
+            count2six       <= count2six + 1;
+            if (count2six == 3) begin
+              count2six         <= '0;
+              selftest_req      <= 1'b1;
+              cmd_seq_state     <= STATE_CRC_CHECK;
+            end
+          end
+        end
+        
         STATE_DISABLE: begin
           o_cordic_pipeline_en  <= 1'b0;
           cmd_seq_state         <= STATE_CRC_CHECK;
@@ -255,6 +403,8 @@ module uart_rx_msg (
           if (crc_byte_done) begin
             cmd_seq_state   <= STATE_HEADER;
             o_rx_msg_err    <= (lfsr_reg != 0);
+            // The self-test starts only once its CRC checks out, and not while disabled
+            o_selftest_start<= selftest_req && (lfsr_reg == 0) && o_cordic_pipeline_en;
           end
         end
         
@@ -262,14 +412,25 @@ module uart_rx_msg (
             cmd_seq_state       <= STATE_HEADER;
             count2six           <= '0;
             count2burst         <= '0;
+            count2stream        <= '0;
             o_burst_cnt         <= '0;
             o_burst_cnt_valid   <= '0;
+            o_stream_mode       <= '0;
+            o_stream_cnt        <= '0;
+            o_stream_valid      <= 1'b0;
             o_cmd_reg           <= '0;
             o_cmd_reg_valid     <= 1'b0;
             o_rx_msg_err        <= 1'b0;
             o_cordic_start      <= 1'b0;
             o_cordic_theta      <= '0;
             o_cordic_pipeline_en<= 1'b1;
+            o_vector_start      <= 1'b0;
+            o_vector_x          <= '0;
+            o_vector_y          <= '0;
+            selftest_req        <= 1'b0;
+            o_selftest_start    <= 1'b0;
+            o_selftest_seed     <= '0;
+            o_selftest_cnt      <= '0;
 
         end
           
@@ -279,18 +440,35 @@ module uart_rx_msg (
         cmd_seq_state       <= STATE_HEADER;
         count2six           <= '0;
         count2burst         <= '0;
+        count2stream        <= '0;
+        theta_bytes         <= 3'd6;
+        theta_mask          <= '1;
         
         // to tx msg
         o_cmd_reg           <= '0;
         o_cmd_reg_valid     <= 1'b0;
         o_burst_cnt         <= '0;
         o_burst_cnt_valid   <= '0;
+        o_stream_mode       <= '0;
+        o_stream_cnt        <= '0;
+        o_stream_valid      <= 1'b0;
         o_rx_msg_err        <= 1'b0;
         
         // to cordic
         o_cordic_start      <= 1'b0;
         o_cordic_theta      <= '0;
         o_cordic_pipeline_en<= 1'b1;
+        
+        // to cordic vectoring
+        o_vector_start      <= 1'b0;
+        o_vector_x          <= '0;
+        o_vector_y          <= '0;
+        
+        // to cordic selftest
+        selftest_req        <= 1'b0;
+        o_selftest_start    <= 1'b0;
+        o_selftest_seed     <= '0;
+        o_selftest_cnt      <= '0;
       end
       
     end
@@ -2,7 +2,9 @@
 // File:        uart_tx.sv
 // Author:      Grant Yu
 // Date:        03/2021
-// Description: Generic parametrized UART TX module.
+// Description: Generic parametrized UART TX module. Bit periods come from a fractional (phase
+//              accumulator) generator, so the average baud rate is exact for any CLK_FREQ/BAUD_RATE
+//              ratio and every bit edge is within half a clock of its ideal time.
 //
 // Copyright (C) 2021, Grant Yu
 //
@@ -43,9 +45,15 @@ module uart_tx #(
   localparam EVEN_PAR = 0;
   localparam ODD_PAR  = 1;
 
-  // Baudperiod counter
-  localparam BAUDPER_CNT_MAX = int'(real'(CLK_FREQ_MHZ) / real'(BAUD_RATE));
-  logic [$clog2(BAUDPER_CNT_MAX)-1:0] baudper_cnt;
+  // Bit period generation: the accumulator carries BAUD_RATE times per second on average, and is
+  // restarted with the start bit so that each byte is timed from its own start edge. The extra
+  // half increment rounds each edge to the nearest clock instead of the next one.
+  localparam BIT_ACC_BITS = 32;
+  localparam longint BIT_INC = longint'(real'(BAUD_RATE) * (2.0**BIT_ACC_BITS) / real'(CLK_FREQ_MHZ));
+  logic [BIT_ACC_BITS:0] bit_acc;
+  logic bit_tick;
+  
+  assign bit_tick = bit_acc[BIT_ACC_BITS];
   
   // TX byte register
   logic [NUM_DATA_BITS-1:0] tx_byte, tx_byte_sreg;
@@ -71,13 +79,15 @@ module uart_tx #(
     if (!i_rst_n) begin
       tx_byte           <= '0;
       tx_byte_sreg      <= '0;
-      baudper_cnt       <= '0;
+      bit_acc           <= '0;
       idx               <= '0;
       o_tx              <= 1'b1;
       stop_b_cnt        <= 1'b0;
       state             <= TX_IDLE;
     end else begin
     
+      bit_acc           <= bit_acc[BIT_ACC_BITS-1:0] + BIT_INC;
+    
       case (state)
       
         TX_IDLE: begin
@@ -91,6 +101,7 @@ module uart_tx #(
         TX_GET_DATA: begin
         
             o_tx        <= 1'b0;
+            bit_acc     <= BIT_INC + BIT_INC/2;
             tx_byte     <= i_fifo_rd_data;
             tx_byte_sreg<= i_fifo_rd_data;
             state       <= TX_START;
@@ -99,9 +110,7 @@ module uart_tx #(
         
         TX_START: begin
           
-          baudper_cnt   <= baudper_cnt + 1;
-          if (baudper_cnt == BAUDPER_CNT_MAX - 1) begin
-            baudper_cnt <= '0;
+          if (bit_tick) begin
             o_tx        <= tx_byte[0];
             state       <= TX_DATA;
           end
@@ -110,9 +119,7 @@ module uart_tx #(
         
         TX_DATA: begin
           
-          baudper_cnt   <= baudper_cnt + 1;
-          if (baudper_cnt == BAUDPER_CNT_MAX - 1) begin
-            baudper_cnt <= '0;
+          if (bit_tick) begin
             o_tx        <= tx_byte[1];
             tx_byte     <= tx_byte >> 1;
             idx         <= idx + 1;
@@ -135,9 +142,7 @@ module uart_tx #(
         
         TX_PARITY: begin
           
-          baudper_cnt   <= baudper_cnt + 1;
-          if (baudper_cnt == BAUDPER_CNT_MAX - 1) begin
-            baudper_cnt <= '0;
+          if (bit_tick) begin
             o_tx        <= 1'b1;
             state       <= TX_STOP;
           end
@@ -146,9 +151,7 @@ module uart_tx #(
         
         TX_STOP: begin
           
-          baudper_cnt   <= baudper_cnt + 1;
-          if (baudper_cnt == BAUDPER_CNT_MAX - 1) begin
-            baudper_cnt <= '0;
+          if (bit_tick) begin
             stop_b_cnt  <= ~stop_b_cnt; 
             if (stop_b_cnt == NUM_STOP_BITS - 1) begin
               stop_b_cnt<= '0;
@@ -163,7 +166,7 @@ module uart_tx #(
           
           tx_byte           <= '0;
           tx_byte_sreg      <= '0;
-          baudper_cnt       <= '0;
+          bit_acc           <= '0;
           idx               <= '0;
           o_tx              <= 1'b1;
           stop_b_cnt        <= 1'b0;
@@ -3,7 +3,8 @@
 // Author:      Grant Yu
 // Date:        03/2021
 // Description: This module transmits UART messages based on a custom messaging protocol used to communicate
-//              with the CORDIC module realized in the FPGA.
+//              with the CORDIC module realized in the FPGA. It takes one result at a time: o_busy is
+//              high while it writes bytes, and a result arriving then is lost.
 //
 // Copyright (C) 2021, Grant Yu
 //
@@ -34,6 +35,9 @@ module uart_tx_msg (
     input wire          i_cmd_valid,
     input wire [7:0]    i_burst_cnt,
     input wire          i_burst_cnt_valid,
+    input wire [7:0]    i_stream_mode,
+    input wire [15:0]   i_stream_cnt,
+    input wire          i_stream_valid,
     input wire          i_rx_msg_err,
     
     // from cordic
@@ -41,9 +45,20 @@ module uart_tx_msg (
     input wire [47:0]   i_cordic_cos_theta,
     input wire          i_cordic_done,
     
+    // from cordic vectoring
+    input wire [47:0]   i_vector_magnitude,
+    input wire [47:0]   i_vector_atan,
+    input wire          i_vector_done,
+    
+    // from cordic selftest
+    input wire [31:0]   i_selftest_signature,
+    input wire [47:0]   i_selftest_cycles,
+    input wire          i_selftest_done,
+    
     // to uart tx
     output reg [7:0]    o_tx_byte,
-    output reg          o_tx_byte_valid
+    output reg          o_tx_byte_valid,
+    output wire         o_busy
   );
   
   // LFSR to calculate CRC8
@@ -57,6 +72,7 @@ module uart_tx_msg (
     .i_clk,
     .i_rst_n,
     .i_count_en (lfsr_count_en),
+    .i_steps    (1'b1),
     .i_load     (lfsr_load),
     .i_seed     (lfsr_seed),
     .o_lfsr     (lfsr_reg)
@@ -136,6 +152,19 @@ module uart_tx_msg (
                 STATE_BURST_TRANS_III,
                 STATE_BURST_TRANS_IV,
                 STATE_BURST_TRANS_V,
+                STATE_STREAM_TRANS,
+                STATE_STREAM_TRANS_II,
+                STATE_STREAM_TRANS_III,
+                STATE_STREAM_TRANS_IV,
+                STATE_STREAM_TRANS_V,
+                STATE_STREAM_TRANS_VI,
+                STATE_STREAM_TRANS_VII,
+                STATE_VECTOR_TRANS,
+                STATE_VECTOR_TRANS_II,
+                STATE_VECTOR_TRANS_III,
+                STATE_SELFTEST,
+                STATE_SELFTEST_II,
+                STATE_SELFTEST_III,
                 STATE_DISABLE,
                 STATE_DISABLE_II,
                 STATE_ENABLE,
@@ -143,10 +172,24 @@ module uart_tx_msg (
                 STATE_TX_CRC8
                } tx_msg_state_t;
   tx_msg_state_t tx_msg_state;
+  
+  // Idle or waiting for a result; every other state is writing bytes
+  assign o_busy = !(tx_msg_state inside {STATE_IDLE, STATE_SINGLE_TRANS, STATE_BURST_TRANS,
+                                         STATE_BURST_TRANS_IV, STATE_STREAM_TRANS, STATE_STREAM_TRANS_VI,
+                                         STATE_VECTOR_TRANS, STATE_SELFTEST});
 
   logic [7:0] bytes2send [12];
   logic [3:0] byte_cnt;
   logic [7:0] burst_cnt;
+  logic [7:0] stream_mode;
+  logic [15:0] stream_cnt;
+  logic [3:0] stream_bytes;
+  logic [95:0] stream_results;
+  
+  // cos then sin of one stream angle, each reduced to the selected width, packed from byte 0
+  assign stream_results = ({48'b0, stream_result(i_cordic_cos_theta, stream_mode)}
+                           & ~({96{1'b1}} << (4*stream_bytes)))
+                        | ({48'b0, stream_result(i_cordic_sin_theta, stream_mode)} << (4*stream_bytes));
   
   always_ff @(posedge i_clk)
     if (!i_rst_n) begin
@@ -154,6 +197,9 @@ module uart_tx_msg (
       bytes2send        <= '{default:'0};
       byte_cnt          <= '0;
       burst_cnt         <= '0;
+      stream_mode       <= '0;
+      stream_cnt        <= '0;
+      stream_bytes      <= 4'd12;
       o_tx_byte_valid   <= 1'b0;
       o_tx_byte         <= '0;
     end else begin
@@ -167,6 +213,9 @@ module uart_tx_msg (
                 case (i_cmd_reg) 
                     CMD_SINGLE_TRANS:   tx_msg_state  <= STATE_SINGLE_TRANS;
                     CMD_BURST_TRANS:    tx_msg_state  <= STATE_BURST_TRANS;
+                    CMD_STREAM_TRANS:   tx_msg_state  <= STATE_STREAM_TRANS;
+                    CMD_VECTOR_TRANS:   tx_msg_state  <= STATE_VECTOR_TRANS;
+                    CMD_SELFTEST:       tx_msg_state  <= STATE_SELFTEST;
                     CMD_DISABLE:        tx_msg_state  <= STATE_DISABLE;
                     CMD_ENABLE:         tx_msg_state  <= STATE_ENABLE;
                     default:            tx_msg_state  <= STATE_IDLE;
@@ -189,6 +238,9 @@ module uart_tx_msg (
                 case (i_cmd_reg) 
                     CMD_SINGLE_TRANS:   tx_msg_state  <= STATE_SINGLE_TRANS;
                     CMD_BURST_TRANS:    tx_msg_state  <= STATE_BURST_TRANS;
+                    CMD_STREAM_TRANS:   tx_msg_state  <= STATE_STREAM_TRANS;
+                    CMD_VECTOR_TRANS:   tx_msg_state  <= STATE_VECTOR_TRANS;
+                    CMD_SELFTEST:       tx_msg_state  <= STATE_SELFTEST;
                     CMD_DISABLE:        tx_msg_state  <= STATE_DISABLE;
                     CMD_ENABLE:         tx_msg_state  <= STATE_ENABLE;
                     default:            tx_msg_state  <= STATE_IDLE;
@@ -233,6 +285,9 @@ module uart_tx_msg (
                 case (i_cmd_reg) 
                     CMD_SINGLE_TRANS:   tx_msg_state  <= STATE_SINGLE_TRANS;
                     CMD_BURST_TRANS:    tx_msg_state  <= STATE_BURST_TRANS;
+                    CMD_STREAM_TRANS:   tx_msg_state  <= STATE_STREAM_TRANS;
+                    CMD_VECTOR_TRANS:   tx_msg_state  <= STATE_VECTOR_TRANS;
+                    CMD_SELFTEST:       tx_msg_state  <= STATE_SELFTEST;
                     CMD_DISABLE:        tx_msg_state  <= STATE_DISABLE;
                     CMD_ENABLE:         tx_msg_state  <= STATE_ENABLE;
                     default:            tx_msg_state  <= STATE_IDLE;
@@ -279,6 +334,170 @@ module uart_tx_msg (
                 end
             end
         end
+        STATE_STREAM_TRANS: begin
+            if (i_stream_valid) begin
+                stream_mode     <= i_stream_mode;
+                stream_cnt      <= i_stream_cnt;
+                stream_bytes    <= 4'(2*stream_width_bytes(i_stream_mode[1:0]));
+            end
+            byte_cnt            <= stream_bytes;
+            if (i_cordic_done) begin
+                for (int i = 0; i < 12; i++)
+                    bytes2send[i]       <= stream_results[(8*i)+7 -: 8];
+                o_tx_byte_valid     <= 1'b1;
+                o_tx_byte           <= BYTE_HEADER;
+                tx_msg_state        <= STATE_STREAM_TRANS_II;
+            end
+
+            if (i_cmd_valid) begin
+                case (i_cmd_reg) 
+                    CMD_SINGLE_TRANS:   tx_msg_state  <= STATE_SINGLE_TRANS;
+                    CMD_BURST_TRANS:    tx_msg_state  <= STATE_BURST_TRANS;
+                    CMD_STREAM_TRANS:   tx_msg_state  <= STATE_STREAM_TRANS;
+                    CMD_VECTOR_TRANS:   tx_msg_state  <= STATE_VECTOR_TRANS;
+                    CMD_SELFTEST:       tx_msg_state  <= STATE_SELFTEST;
+                    CMD_DISABLE:        tx_msg_state  <= STATE_DISABLE;
+                    CMD_ENABLE:         tx_msg_state  <= STATE_ENABLE;
+                    default:            tx_msg_state  <= STATE_IDLE;
+                endcase
+            end
+        end
+        STATE_STREAM_TRANS_II: begin
+            if (crc_byte_done) begin
+                o_tx_byte_valid         <= 1'b1;
+                o_tx_byte               <= CMD_STREAM_TRANS;
+                tx_msg_state            <= STATE_STREAM_TRANS_III;
+            end
+        end
+        STATE_STREAM_TRANS_III: begin
+            if (crc_byte_done) begin
+                o_tx_byte_valid         <= 1'b1;
+                o_tx_byte               <= stream_mode;
+                tx_msg_state            <= STATE_STREAM_TRANS_IV;
+            end
+        end
+        STATE_STREAM_TRANS_IV: begin
+            if (crc_byte_done) begin
+                o_tx_byte_valid         <= 1'b1;
+                o_tx_byte               <= stream_cnt[7:0];
+                tx_msg_state            <= STATE_STREAM_TRANS_V;
+            end
+        end
+        STATE_STREAM_TRANS_V: begin
+            if (crc_byte_done) begin
+                o_tx_byte_valid         <= 1'b1;
+                o_tx_byte               <= stream_cnt[15:8];
+                tx_msg_state            <= STATE_STREAM_TRANS_VII;
+            end
+        end
+        STATE_STREAM_TRANS_VI: begin
+            byte_cnt            <= stream_bytes - 1;
+            if (i_cordic_done) begin
+                for (int i = 0; i < 12; i++)
+                    bytes2send[i]       <= stream_results[(8*i)+7 -: 8];
+                o_tx_byte_valid     <= 1'b1;
+                o_tx_byte           <= stream_results[7:0];
+                tx_msg_state        <= STATE_STREAM_TRANS_VII;
+            end
+        end
+        STATE_STREAM_TRANS_VII: begin
+            if (crc_byte_done) begin
+                o_tx_byte_valid     <= 1'b1;
+                o_tx_byte           <= bytes2send[stream_bytes - byte_cnt];
+                byte_cnt            <= byte_cnt - 1;
+                if (byte_cnt == 1) begin
+                    stream_cnt          <= stream_cnt - 1;
+                    if (stream_cnt == 1)
+                        tx_msg_state    <= STATE_TX_CRC8;
+                    else
+                        tx_msg_state    <= STATE_STREAM_TRANS_VI;
+                end
+            end
+        end
+        STATE_VECTOR_TRANS: begin
+            byte_cnt            <= 12;
+            if (i_vector_done) begin
+                for (int i = 0; i < 6; i++) begin
+                    bytes2send[i]       <= i_vector_magnitude[(8*i)+7 -: 8];
+                    bytes2send[i+6]     <= i_vector_atan[(8*i)+7 -: 8];
+                end
+                o_tx_byte_valid     <= 1'b1;
+                o_tx_byte           <= BYTE_HEADER;
+                tx_msg_state        <= STATE_VECTOR_TRANS_II;
+            end
+
+            if (i_cmd_valid) begin
+                case (i_cmd_reg) 
+                    CMD_SINGLE_TRANS:   tx_msg_state  <= STATE_SINGLE_TRANS;
+                    CMD_BURST_TRANS:    tx_msg_state  <= STATE_BURST_TRANS;
+                    CMD_STREAM_TRANS:   tx_msg_state  <= STATE_STREAM_TRANS;
+                    CMD_VECTOR_TRANS:   tx_msg_state  <= STATE_VECTOR_TRANS;
+                    CMD_SELFTEST:       tx_msg_state  <= STATE_SELFTEST;
+                    CMD_DISABLE:        tx_msg_state  <= STATE_DISABLE;
+                    CMD_ENABLE:         tx_msg_state  <= STATE_ENABLE;
+                    default:            tx_msg_state  <= STATE_IDLE;
+                endcase
+            end
+        end
+        STATE_VECTOR_TRANS_II: begin
+            if (crc_byte_done) begin
+                o_tx_byte_valid         <= 1'b1;
+                o_tx_byte               <= CMD_VECTOR_TRANS;
+                tx_msg_state            <= STATE_VECTOR_TRANS_III;
+            end
+        end
+        STATE_VECTOR_TRANS_III: begin
+            if (crc_byte_done) begin
+                o_tx_byte_valid     <= 1'b1;
+                o_tx_byte           <= bytes2send[12 - byte_cnt];
+                byte_cnt            <= byte_cnt - 1;
+                if (byte_cnt == 1) begin
+                    tx_msg_state    <= STATE_TX_CRC8;
+                end
+            end
+        end
+        STATE_SELFTEST: begin
+            byte_cnt            <= 10;
+            if (i_selftest_done) begin
+                for (int i = 0; i < 4; i++)
+                    bytes2send[i]       <= i_selftest_signature[(8*i)+7 -: 8];
+                for (int i = 0; i < 6; i++)
+                    bytes2send[i+4]     <= i_selftest_cycles[(8*i)+7 -: 8];
+                o_tx_byte_valid     <= 1'b1;
+                o_tx_byte           <= BYTE_HEADER;
+                tx_msg_state        <= STATE_SELFTEST_II;
+            end
+
+            if (i_cmd_valid) begin
+                case (i_cmd_reg) 
+                    CMD_SINGLE_TRANS:   tx_msg_state  <= STATE_SINGLE_TRANS;
+                    CMD_BURST_TRANS:    tx_msg_state  <= STATE_BURST_TRANS;
+                    CMD_STREAM_TRANS:   tx_msg_state  <= STATE_STREAM_TRANS;
+                    CMD_VECTOR_TRANS:   tx_msg_state  <= STATE_VECTOR_TRANS;
+                    CMD_SELFTEST:       tx_msg_state  <= STATE_SELFTEST;
+                    CMD_DISABLE:        tx_msg_state  <= STATE_DISABLE;
+                    CMD_ENABLE:         tx_msg_state  <= STATE_ENABLE;
+                    default:            tx_msg_state  <= STATE_IDLE;
+                endcase
+            end
+        end
+        STATE_SELFTEST_II: begin
+            if (crc_byte_done) begin
+                o_tx_byte_valid         <= 1'b1;
+                o_tx_byte               <= CMD_SELFTEST;
+                tx_msg_state            <= STATE_SELFTEST_III;
+            end
+        end
+        STATE_SELFTEST_III: begin
+            if (crc_byte_done) begin
+                o_tx_byte_valid     <= 1'b1;
+                o_tx_byte           <= bytes2send[10 - byte_cnt];
+                byte_cnt            <= byte_cnt - 1;
+                if (byte_cnt == 1) begin
+                    tx_msg_state    <= STATE_TX_CRC8;
+                end
+            end
+        end
         STATE_DISABLE: begin
             o_tx_byte_valid     <= 1'b1;
             o_tx_byte           <= BYTE_HEADER;
@@ -317,6 +536,7 @@ module uart_tx_msg (
               bytes2send        <= '{default:'0};
               byte_cnt          <= '0;
               burst_cnt         <= '0;
+              stream_cnt        <= '0;
         end
       endcase
       
@@ -325,6 +545,7 @@ module uart_tx_msg (
           bytes2send        <= '{default:'0};
           byte_cnt          <= '0;
           burst_cnt         <= '0;
+          stream_cnt        <= '0;
           o_tx_byte_valid   <= 1'b0;
           o_tx_byte         <= '0;
       end
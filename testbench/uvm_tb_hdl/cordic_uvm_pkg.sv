@@ -20,6 +20,9 @@ package cordic_uvm_pkg;
     `include "../uvm_tb_hvl/sequence_item/cordic_input_tx.svh"
     `include "../uvm_tb_hvl/sequence_item/cordic_output_tx.svh"
 
+	// Coverage-directed stimulus generator (used by the sequences and cordic_coverage)
+	`include "../uvm_tb_hvl/subscriber/cordic_stimgen.svh"
+
 	// Agent
     `include "../uvm_tb_hvl/agent/cordic_agent_cfg.svh"
     `include "../uvm_tb_hvl/agent/cordic_coverage.svh"
@@ -27,10 +30,15 @@ package cordic_uvm_pkg;
     `include "../uvm_tb_hvl/agent/cordic_monitor.svh"
     `include "../uvm_tb_hvl/agent/cordic_agent.svh"
 
+	// Golden vector file
+	`include "../uvm_tb_hvl/subscriber/cordic_vec.svh"
+
 	// Sequence
 	`include "../uvm_tb_hvl/sequence/disable_enable_sequence.svh"
 	`include "../uvm_tb_hvl/sequence/single_cmd_sequence.svh"
 	`include "../uvm_tb_hvl/sequence/burst_cmd_sequence.svh"
+	`include "../uvm_tb_hvl/sequence/vector_cmd_sequence.svh"
+	`include "../uvm_tb_hvl/sequence/stream_cmd_sequence.svh"
 	`include "../uvm_tb_hvl/sequence/cordic_vseq.svh"
     
     // Subscriber
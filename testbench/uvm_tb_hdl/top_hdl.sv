@@ -13,13 +13,25 @@ module top_hdl();
     
     logic clk, baud_clk, rst_n;
     
+    // Hybrid CORDIC seed ROM address bits, 0 for the plain pipeline (see cordic_sincos_seed.sv). The
+    // predictor reads the same value from the config database.
+    localparam int    CORDIC_SEED_BITS      = 0;
+    localparam string CORDIC_SEED_ROM_FILE  = "../hdl/cordic_sincos/cordic_seed_rom_48_8.mem";
+    
+    // CORDIC lanes (cordic_lanes.sv), on the DUT clock; results must come back in order for any count
+    localparam int    CORDIC_LANES          = 1;
+    
     // UART Interface
     uart_if m_uart_if ( .* );
     
     // DUT
-    top_module #( .CLK_FREQ (100000000), .BAUD_RATE (3000000) )
+    top_module #( .CLK_FREQ (100000000), .BAUD_RATE (3000000),
+                  .CORDIC_SEED_BITS (CORDIC_SEED_BITS),
+                  .CORDIC_SEED_ROM_FILE (CORDIC_SEED_ROM_FILE),
+                  .CORDIC_LANES (CORDIC_LANES) )
     DUT (
         .i_clk  (clk),
+        .i_lane_clk (clk),
         .i_rst_n(rst_n),
         .i_rx   (m_uart_if.rx),
         .o_tx   (m_uart_if.tx)
@@ -27,6 +39,7 @@ module top_hdl();
     
     // Set the VIF in the UVM config database
     initial uvm_config_db #(virtual interface uart_if)::set(null, "uvm_test_top", "vif", m_uart_if);
+    initial uvm_config_db #(uvm_bitstream_t)::set(null, "*", "cordic_seed_bits", CORDIC_SEED_BITS);
 
     initial clk         <= 1'b0;
     always #5 clk       <= !clk;
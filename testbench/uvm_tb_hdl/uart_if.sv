@@ -12,7 +12,8 @@ interface uart_if (input logic baud_clk, logic clk, logic rst_n);
     logic rx=1'b1;
     logic tx=1'b1;
     
-    // Byte-level helper transfer task
+    // Byte-level helper transfer task. A cleared stop bit (framing error) is followed by one bit
+    // of idle, so the next start bit still has a falling edge.
     task transfer_byte(bit[10:0] i_byte);
         //$display($sformatf("Transferring:\n %0x\n", i_byte[8:1]));
         for (int i = 0; i < 11; i++) begin
@@ -21,6 +22,11 @@ interface uart_if (input logic baud_clk, logic clk, logic rst_n);
             #1;
             rx <= i_byte[idx];
         end
+        if (!i_byte[10]) begin
+            @(posedge baud_clk);
+            #1;
+            rx <= 1'b1;
+        end
     endtask: transfer_byte
     
     // Input pin wiggle sniffer used by monitor
@@ -0,0 +1,70 @@
+//
+// File:        cordic_crc8.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Table-driven CRC-8 and parity engine. The tables are generated at compile time
+//              from POLY.
+//
+
+#include "cordic_gref_const.h"
+#include "cordic_crc8.h"
+
+/* One byte through the shift register, used to generate the tables */
+static constexpr unsigned char crc_8_shift(unsigned char crc_8) {
+    for (int i = 0; i < 8; i++)
+        crc_8 = (crc_8 & 0x80) ? (unsigned char)((crc_8 << 1) ^ POLY) : (unsigned char)(crc_8 << 1);
+    return crc_8;
+}
+
+static constexpr crc8_tables_t make_crc8_tables() {
+    crc8_tables_t tables = {};
+    for (int b = 0; b < 256; b++)
+        tables.t[0][b] = crc_8_shift((unsigned char)b);
+    for (int k = 1; k < 4; k++)
+        for (int b = 0; b < 256; b++)
+            tables.t[k][b] = tables.t[0][tables.t[k-1][b]];
+    return tables;
+}
+
+extern const crc8_tables_t CRC8_TABLES = make_crc8_tables();
+
+unsigned char crc_8_serial(unsigned char crc_8, const unsigned char* data, size_t len) {
+    for (size_t n = 0; n < len; n++) {
+        crc_8 ^= data[n];
+        for (int i = 0; i < 8; i++) {
+            if (crc_8 >> 7)
+                crc_8 = (crc_8 << 1) ^ POLY;
+            else
+                crc_8 = (crc_8 << 1);
+        }
+    }
+    return crc_8;
+}
+
+unsigned char crc_8_block(unsigned char crc_8, const unsigned char* data, size_t len) {
+    const unsigned char (*t)[256] = CRC8_TABLES.t;
+    size_t n = 0;
+    for (; n + 4 <= len; n += 4)
+        crc_8 = t[3][crc_8 ^ data[n]] ^ t[2][data[n+1]] ^ t[1][data[n+2]] ^ t[0][data[n+3]];
+    for (; n < len; n++)
+        crc_8 = t[0][crc_8 ^ data[n]];
+    return crc_8;
+}
+
+bool crc_8_packets(const short int* packets, size_t n, unsigned char* data, unsigned char* crc_8) {
+    unsigned int bad = 0;
+    for (size_t i = 0; i < n; i++) {
+        unsigned int p = (unsigned short)packets[i];
+        /* start == 0, stop == 1, and data plus parity bit hold an odd number of ones */
+        bad |= ((p & 0x401) ^ 0x400) | !(__builtin_popcount(p & 0x3fe) & 1);
+        data[i] = (unsigned char)(p >> 1);
+    }
+    (*crc_8) = crc_8_block(*crc_8, data, n);
+    return !bad;
+}
+
+void set_packets(short int* packets, const unsigned char* data, size_t n, unsigned char* crc_8) {
+    for (size_t i = 0; i < n; i++)
+        packets[i] = (short int)((data[i] << 1) | (parity_odd(data[i]) << 9) | (1 << 10));
+    (*crc_8) = crc_8_block(*crc_8, data, n);
+}
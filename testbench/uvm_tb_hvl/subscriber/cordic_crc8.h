@@ -0,0 +1,45 @@
+//
+// File:        cordic_crc8.h
+// Author:      agent
+// Date:        10/2026
+// Description: Table-driven CRC-8 (POLY 0x9b, MSB first, zero init) and odd-parity engine shared
+//              by the C++ reference model and its tools. Also validates and builds whole runs of
+//              11-bit UART packets ({stop, parity, data[7:0], start}) in a single pass.
+//
+
+#ifndef CORDIC_CRC8_H
+#define CORDIC_CRC8_H
+
+#include <stddef.h>
+
+/* CRC8_TABLES.t[0] is the byte-wise table; t[k] advances the CRC by k extra zero bytes (slice-by-4) */
+struct crc8_tables_t {
+    unsigned char t[4][256];
+};
+
+extern const crc8_tables_t CRC8_TABLES;
+
+/* Shift one byte into the CRC-8 */
+static inline unsigned char crc_8_byte(unsigned char crc_8, unsigned char i_byte) {
+    return CRC8_TABLES.t[0][crc_8 ^ i_byte];
+}
+
+/* Odd parity bit of a byte */
+static inline bool parity_odd(unsigned char i_data_frame) {
+    return !(__builtin_popcount(i_data_frame) & 1);
+}
+
+/* Bit-serial CRC-8 matching the Galois LFSR in lfsr.sv; kept as the reference implementation */
+unsigned char crc_8_serial(unsigned char crc_8, const unsigned char* data, size_t len);
+
+/* Slice-by-4 CRC-8 over a byte buffer */
+unsigned char crc_8_block(unsigned char crc_8, const unsigned char* data, size_t len);
+
+/* Checks start/parity/stop framing of n packets, extracts their data bytes and shifts them into
+   the CRC-8. Returns false if any packet is malformed. */
+bool crc_8_packets(const short int* packets, size_t n, unsigned char* data, unsigned char* crc_8);
+
+/* Builds n framed packets from data bytes and shifts the bytes into the CRC-8 */
+void set_packets(short int* packets, const unsigned char* data, size_t n, unsigned char* crc_8);
+
+#endif
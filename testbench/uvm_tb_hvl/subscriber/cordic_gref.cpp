@@ -5,21 +5,25 @@
 // Description: Golden reference C++ implementation of CORDIC-UART 
 //
 
+#ifndef CORDIC_GREF_STANDALONE
 #include "svdpi.h"
+#endif
+#include <math.h>
 #include <stdio.h>
+#include <string.h>
 #include <iostream>  
 #include <bitset> 
+#include <vector>
 
 #include "cordic_gref_const.h"
+#include "cordic_gref.h"
+#include "cordic_crc8.h"
+#include "cordic_gref_prof.h"
+#include "cordic_lanes.h"
 
 /* Calculates odd parity of a byte */
 bool parity_calc(unsigned char i_data_frame) {
-    bool parity = 1;
-    for (int i = 0; i < 8; i++) {
-        parity ^= (i_data_frame & 1);
-        i_data_frame >>= 1;
-    }
-    return parity;
+    return parity_odd(i_data_frame);
 }
 
 /* Extracts frames from a UART packet */
@@ -41,114 +45,175 @@ void set_packet(short int* packet, unsigned char data_frame) {
     return;
 }
 
-/* Calculates the CRC-8 using a shift register implementation */
+/* Calculates the CRC-8 using a byte-wise table (see crc_8_serial for the shift register form) */
 void crc_8_calc(unsigned char* crc_8, unsigned char i_byte) {
-    (*crc_8) ^= i_byte;
-    //std::cout << "crc_8 after xor is: "  << std::bitset<8>(+(*crc_8)) << std::endl;
-    for (int i = 0; i < 8; i++) {
-        //std::cout << "crc_8 masked is: "  << std::bitset<16>(+((*crc_8) >> 7)) << std::endl;
-        if ((*crc_8) >> 7) {
-            (*crc_8) = ((*crc_8) << 1) ^ POLY;
-            //std::cout << "MSB set. crc_8 is: "  << std::bitset<8>(+(*crc_8)) << std::endl;
-        } else {
-            (*crc_8) = ((*crc_8) << 1);
-            //std::cout << "MSB not set. crc_8 is: "  << std::bitset<8>(+(*crc_8)) << std::endl;
-        }
-    }
+    (*crc_8) = crc_8_byte(*crc_8, i_byte);
+}
+
+/* Quadrant fold of the sin/cos pipelines: theta (4.44) into z in [-pi/2, pi/2] (2.46), and
+   whether the results are negated at the end */
+void cordic_fold(long long theta, long long* z, bool* sign) {
+
+    (*z) =  (theta > PI_MULT_3_DIV_2)                               ? theta - PI_MULT_2    :
+            (theta > PI_DIV_2          && theta <= PI_MULT_3_DIV_2) ? theta - PI           :
+            (theta >= -PI_MULT_3_DIV_2 && theta < -PI_DIV_2)        ? theta + PI           :
+            (theta < -PI_MULT_3_DIV_2)                              ? theta + PI_MULT_2    :
+            theta;
+    (*z) <<= 2;
+
+    (*sign) =   (theta > PI_MULT_3_DIV_2)                               ? 0 :
+                (theta > PI_DIV_2          && theta <= PI_MULT_3_DIV_2) ? 1 :
+                (theta >= -PI_MULT_3_DIV_2 && theta < -PI_DIV_2)        ? 1 :
+                (theta < -PI_MULT_3_DIV_2)                              ? 0 :
+                0;
+}
+
+/* Rotation stage i: turns (x, y) towards the residual angle z by atan(2^-i) */
+void cordic_stage(int i, long long* x, long long* y, long long* z) {
+
+    long long dx = ((*z) < 0) ? ((*y) >> i)    : ((-(*y)) >> i);
+    long long dy = ((*z) < 0) ? ((-(*x)) >> i) :    ((*x) >> i);
+    long long dz = ((*z) < 0) ?      ATAN[i]   :     -ATAN[i];
+    (*x) += dx;
+    (*y) += dy;
+    (*z) += dz;
 }
 
-/* CORDIC model */
+/* CORDIC model. Per-stage x/y/z can be captured with cordic_sincos<48, 48>() (cordic_sincos_param.h),
+   which is bit-exact with this function. */
 void cordic_sincos(long long* theta, long long* x, long long* y) {
-    
-    /*
-    std::cout << "Starting cordic C++ golden ref..." << std::endl;
-    std::cout << "Theta input is " << std::hex << "0x" << *theta << std::endl;
-    */
 
     long long z;
-    z =     ((*theta) > PI_MULT_3_DIV_2)                                  ? (*theta) - PI_MULT_2    :
-            ((*theta) > PI_DIV_2          && (*theta) <= PI_MULT_3_DIV_2) ? (*theta) - PI           :
-            ((*theta) > -PI_MULT_3_DIV_2  && (*theta) <= -PI_DIV_2)       ? (*theta) + PI           :
-            ((*theta) <= -PI_MULT_3_DIV_2)                                ? (*theta) + PI_MULT_2    :
-            (*theta);
-    z <<= 2;
-
     bool sign;
-    sign =  ((*theta) > PI_MULT_3_DIV_2)                                  ? 0 :
-            ((*theta) > PI_DIV_2          && (*theta) <= PI_MULT_3_DIV_2) ? 1 :
-            ((*theta) > -PI_MULT_3_DIV_2  && (*theta) <= -PI_DIV_2)       ? 1 :
-            ((*theta) <= -PI_MULT_3_DIV_2)                                ? 0 :
-            0;
-
-    /*
-    std::cout << "Sign corrected is " << std::hex << "0x" << sign << std::endl;
-    */
+    cordic_fold(*theta, &z, &sign);
 
     (*x) = K[47];
     (*y) = 0;
+    for (int i = 0; i <= 47; i++)
+        cordic_stage(i, x, y, &z);
+    
+    if (sign) {
+        (*x) = -(*x);
+        (*y) = -(*y);
+    }
+
+    return;
+}
 
-    /*
-    std::cout << "x_0 is " << std::hex << "0x" << (*x) << std::endl;
-    std::cout << "y_0 is " << std::hex << "0x" << (*y) << std::endl;
-    std::cout << "z_0 is " << std::hex << "0x" <<    z << std::endl;
-    */
+/* Vectoring-mode CORDIC model (cordic_vectoring.sv, STAGES = BITS = 48). x and y get 2 extra
+   integer bits for the CORDIC gain; for x < 0 the vector is negated and +/-pi added back. The
+   magnitude is x times K, truncated. */
+void cordic_vectoring(long long x, long long y, long long* magnitude, long long* atan) {
+
+    long long z = 0, fold = 0;
+    if (x < 0) {
+        fold = (y < 0) ? -PI : PI;
+        x = -x;
+        y = -y;
+    }
 
     long long dx, dy, dz;
     for (int i = 0; i <= 47; i++) {
-        dx = (z < 0) ? ((*y) >> i)    : ((-(*y)) >> i);
-        dy = (z < 0) ? ((-(*x)) >> i) :    ((*x) >> i);
-        dz = (z < 0) ?      ATAN[i] :     -ATAN[i];
-        (*x) += dx;
-        (*y) += dy;
-        z    += dz;
-
-        /*
-        std::cout << "Iteration " << i << ":" << std::endl;
-        std::cout << "x = " << std::hex << "0x" << (*x) << std::endl;
-        std::cout << "y = " << std::hex << "0x" << (*y) << std::endl;
-        std::cout << "z = " << std::hex << "0x" <<    z << std::endl;
-        std::cout << std::endl;
-        std::cout << "dx = " << std::hex << "0x" << dx << std::endl;
-        std::cout << "dy = " << std::hex << "0x" << dy << std::endl;
-        std::cout << "dz = " << std::hex << "0x" << dz << std::endl;
-        std::cout << std::endl;
-        std::cout << std::endl;
-        */
+        dx = (y < 0) ? ((-y) >> i) :    (y >> i);
+        dy = (y < 0) ?    (x >> i) : ((-x) >> i);
+        dz = (y < 0) ?   -ATAN[i]  :    ATAN[i];
+        x += dx;
+        y += dy;
+        z += dz;
     }
-    
+
+    /* 48-bit output registers */
+    long long m = (long long)(((__int128)x * K[47]) >> 46);
+    (*magnitude) = (m << 16) >> 16;
+    (*atan)      = (((z >> 2) + fold) << 16) >> 16;
+}
+ 
+/* Seed ROM of the hybrid mode (cordic_sincos #(.SEED_BITS(seed_bits))). Entry idx holds cos and sin
+   of idx*2^-seed_bits in 2.46, pre-scaled by the gain of CORDIC stages seed_bits+1..stages-1 that
+   finish the rotation. tools/hybrid writes the same values into the ROM's $readmemh file. */
+void cordic_seed_rom_entry(int stages, int seed_bits, int idx, long long* cos_seed, long long* sin_seed) {
+    long double gain = 1.0L;
+    for (int i = seed_bits + 1; i < stages; i++)
+        gain /= sqrtl(1.0L + ldexpl(1.0L, -2*i));
+    long double a = ldexpl((long double)idx, -seed_bits);
+    (*cos_seed) = llroundl(ldexpl(cosl(a) * gain, 46));
+    (*sin_seed) = llroundl(ldexpl(sinl(a) * gain, 46));
+}
+
+/* Start of the hybrid pipeline: the folded angle z rounded to a multiple of 2^-seed_bits indexes
+   the seed ROM, whose entry goes to x and y, and z keeps the remainder for stages seed_bits+1..47 */
+void cordic_seed(int seed_bits, long long* z, long long* x, long long* y) {
+
+    int shift = 46 - seed_bits;
+    long long idx = ((*z) + (1LL << (shift - 1))) >> shift;
+    (*z) -= idx * (1LL << shift);
+    cordic_seed_rom_entry(48, seed_bits, (int)(idx < 0 ? -idx : idx), x, y);
+    if (idx < 0)
+        (*y) = -(*y);
+}
+
+/* Hybrid CORDIC model: the fold of cordic_sincos(), the seed ROM, then stages seed_bits+1..47
+   rotate by the remainder. */
+void cordic_sincos_hybrid(long long* theta, long long* x, long long* y, int seed_bits) {
+
+    long long z;
+    bool sign;
+    cordic_fold(*theta, &z, &sign);
+
+    cordic_seed(seed_bits, &z, x, y);
+    for (int i = seed_bits + 1; i <= 47; i++)
+        cordic_stage(i, x, y, &z);
+
     if (sign) {
         (*x) = -(*x);
         (*y) = -(*y);
     }
+}
 
-    /*
-    std::cout << "x final is " << std::hex << "0x" << (*x) << std::endl;
-    std::cout << "y final is " << std::hex << "0x" << (*y) << std::endl;
-    std::cout << "z final is " << std::hex << "0x" <<    z << std::endl;
-    */
+void cordic_gref_sincos(const long long* theta, long long* x, long long* y, int n, int seed_bits) {
+    if (!seed_bits) {
+        cordic_sincos_burst(theta, x, y, n);
+        return;
+    }
+    for (int k = 0; k < n; k++) {
+        long long t = theta[k];
+        cordic_sincos_hybrid(&t, x + k, y + k, seed_bits);
+    }
+}
 
+/* Constructs the error response message (header, CMD_ERR, crc) */
+void set_err_msg(short int* o_header, short int* o_cmd, short int* o_crc_8) {
+    unsigned char crc_8_calculated = 0;
+    set_packet(o_header, BYTE_HEADER);
+    crc_8_calc(&crc_8_calculated, BYTE_HEADER);
+    set_packet(o_cmd, CMD_ERR);
+    crc_8_calc(&crc_8_calculated, CMD_ERR);
+    set_packet(o_crc_8, crc_8_calculated);
     return;
 }
- 
-/* SystemVerilog exported C++ function */
-extern "C" void cordic_gref(const short int     i_header,
-                            const short int     i_cmd, 
-                            const short int     i_burst_cnt, 
-                            const short int*    i_theta,
-                            const short int     i_crc_8,
-                            char*               disabled,           
-                            short int*          o_header,
-                            short int*          o_cmd, 
-                            short int*          o_burst_cnt,
-                            short int*          o_cos_theta,
-                            short int*          o_sin_theta,
-                            short int*          o_crc_8 ) 
+
+/* Message-level model of one SINGLE/BURST/DISABLE/ENABLE message for a given CORDIC mode */
+static void gref_msg(const int          seed_bits,
+                     const short int    i_header,
+                     const short int    i_cmd,
+                     const short int    i_burst_cnt,
+                     const short int*   i_theta,
+                     const short int    i_crc_8,
+                     char*              disabled,
+                     short int*         o_header,
+                     short int*         o_cmd,
+                     short int*         o_burst_cnt,
+                     short int*         o_cos_theta,
+                     short int*         o_sin_theta,
+                     short int*         o_crc_8 )
 {
     unsigned char crc_8_calculated = 0, header = 0, cmd = 0, burst_cnt = 0, crc_8 = 0; 
     bool start = 0, parity = 0, stop = 0;
-    long long * theta = new long long[8];
-    long long * cos_theta = new long long[8];
-    long long * sin_theta = new long long[8];
+    long long theta[8]      = {0};
+    long long cos_theta[8]  = {0};
+    long long sin_theta[8]  = {0};
+    unsigned char theta_bytes[6*8];
+    GREF_PROF_TIMER(t);
     
     /* Initialize memory to 0 */
     memset(o_header,    0, sizeof(short int));
@@ -157,156 +222,73 @@ extern "C" void cordic_gref(const short int     i_header,
     memset(o_cos_theta, 0, sizeof(short int)*6*8);
     memset(o_sin_theta, 0, sizeof(short int)*6*8);
     memset(o_crc_8,     0, sizeof(short int));
-    memset(theta,       0, sizeof(long long)*8);
-    memset(cos_theta,   0, sizeof(long long)*8);
-    memset(sin_theta,   0, sizeof(long long)*8);
     
     /* Header byte */
     extract_packet(i_header, &start, &header, &parity, &stop);
-    //std::cout << "Header: " <<  std::hex << +header << std::endl;
     crc_8_calc(&crc_8_calculated, header);
-    //std::cout << "crc after header is: " <<  std::hex << +crc_8_calculated << std::endl;
     if (!(!start && (header == BYTE_HEADER) && (parity_calc(header) == parity) && stop)) {
         std::cout << "Error detected when extracting header byte." << std::endl;
-        crc_8_calculated = 0;
-        set_packet(o_header, BYTE_HEADER);
-        crc_8_calc(&crc_8_calculated, *o_header);
-        set_packet(o_cmd, CMD_ERR);
-        crc_8_calc(&crc_8_calculated, *o_cmd);
-        set_packet(o_crc_8, crc_8_calculated);
-        delete[] theta;
-        delete[] cos_theta;
-        delete[] sin_theta;
+        GREF_PROF_ERROR(PROF_ERR_HEADER, t);
+        set_err_msg(o_header, o_cmd, o_crc_8);
         return;
     }
    
     /* Cmd byte */
     extract_packet(i_cmd, &start, &cmd, &parity, &stop);
-    //std::cout << "Cmd: " <<  std::hex << +cmd << std::endl;
     crc_8_calc(&crc_8_calculated, cmd);
-    //std::cout << "crc after cmd is: "  << std::hex <<  +crc_8_calculated << std::endl;
-    if (!(!start && (cmd == CMD_SINGLE_TRANS || cmd == CMD_BURST_TRANS || cmd == CMD_DISABLE || cmd == CMD_ENABLE) 
+    if (!(!start && (cmd == CMD_SINGLE_TRANS || cmd == CMD_BURST_TRANS || cmd == CMD_VECTOR_TRANS
+                     || cmd == CMD_DISABLE || cmd == CMD_ENABLE)
         && (parity_calc(cmd) == parity) && stop)) {
-            std::cout << "Error detected when extracting cmd byte." << std::endl;
-        crc_8_calculated = 0;
-        set_packet(o_header, BYTE_HEADER);
-        crc_8_calc(&crc_8_calculated, *o_header);
-        set_packet(o_cmd, CMD_ERR);
-        crc_8_calc(&crc_8_calculated, *o_cmd);
-        set_packet(o_crc_8, crc_8_calculated);
-        delete[] theta;
-        delete[] cos_theta;
-        delete[] sin_theta;
+        std::cout << "Error detected when extracting cmd byte." << std::endl;
+        GREF_PROF_ERROR(PROF_ERR_CMD, t);
+        set_err_msg(o_header, o_cmd, o_crc_8);
         return;
     }
 
-    if (cmd == CMD_DISABLE) {
+    if (cmd == CMD_DISABLE || cmd == CMD_ENABLE) {
 
         /* CRC byte */
         extract_packet(i_crc_8, &start, &crc_8, &parity, &stop);
-        //std::cout << "CRC-8: " <<  std::hex << +crc_8 << std::endl;
         crc_8_calc(&crc_8_calculated, crc_8);
-        //std::cout << "crc after crc_8 is: " << std::hex << +crc_8_calculated << std::endl;
         if (!(!start && !crc_8_calculated && (parity_calc(crc_8) == parity) && stop)) {
             std::cout << "Error detected when extracting crc byte." << std::endl;
-            crc_8_calculated = 0;
-            set_packet(o_header, BYTE_HEADER);
-            crc_8_calc(&crc_8_calculated, BYTE_HEADER);
-            set_packet(o_cmd, CMD_ERR);
-            crc_8_calc(&crc_8_calculated, CMD_ERR);
-            set_packet(o_crc_8, crc_8_calculated);
-            delete[] theta;
-            delete[] cos_theta;
-            delete[] sin_theta;
+            GREF_PROF_ERROR(PROF_ERR_CRC, t);
+            set_err_msg(o_header, o_cmd, o_crc_8);
             return;
         }
 
-        (*disabled) = 1;
+        (*disabled) = (cmd == CMD_DISABLE);
+        GREF_PROF_COUNT(cmd == CMD_DISABLE ? PROF_CMD_DISABLE : PROF_CMD_ENABLE, 1);
+        GREF_PROF_SECTION(PROF_DECODE, t);
 
         /* Construct output msg */
         crc_8_calculated = 0;
         set_packet(o_header, BYTE_HEADER);
         crc_8_calc(&crc_8_calculated, BYTE_HEADER);
-        set_packet(o_cmd, CMD_DISABLE);
-        crc_8_calc(&crc_8_calculated, CMD_DISABLE);
+        set_packet(o_cmd, cmd);
+        crc_8_calc(&crc_8_calculated, cmd);
         set_packet(o_crc_8, crc_8_calculated);
-        delete[] theta;
-        delete[] cos_theta;
-        delete[] sin_theta;
-        return;
-        
-    } else if (cmd == CMD_ENABLE) {
-
-        /* CRC byte */
-        extract_packet(i_crc_8, &start, &crc_8, &parity, &stop);
-        crc_8_calc(&crc_8_calculated, crc_8);
-        //std::cout << "crc after crc_8 is: " << std::hex << +crc_8_calculated << std::endl;
-        if (!(!start && !crc_8_calculated && (parity_calc(crc_8) == parity) && stop)) {
-            std::cout << "Error detected when extracting crc byte." << std::endl;
-            crc_8_calculated = 0;
-            set_packet(o_header, BYTE_HEADER);
-            crc_8_calc(&crc_8_calculated, BYTE_HEADER);
-            set_packet(o_cmd, CMD_ERR);
-            crc_8_calc(&crc_8_calculated, CMD_ERR);
-            set_packet(o_crc_8, crc_8_calculated);
-            delete[] theta;
-            delete[] cos_theta;
-            delete[] sin_theta;
-            return;
-        }
-
-        (*disabled) = 0;
-
-        /* Construct output msg */
-        crc_8_calculated = 0;
-        set_packet(o_header, BYTE_HEADER);
-        crc_8_calc(&crc_8_calculated, BYTE_HEADER);
-        set_packet(o_cmd, CMD_ENABLE);
-        crc_8_calc(&crc_8_calculated, CMD_ENABLE);
-        set_packet(o_crc_8, crc_8_calculated);
-        delete[] theta;
-        delete[] cos_theta;
-        delete[] sin_theta;
+        GREF_PROF_SECTION(PROF_ENCODE, t);
         return;
         
     } else if (cmd == CMD_SINGLE_TRANS) {
         
         /* Theta bytes */
-        for (int i = 0; i < 6; i++) {
-            extract_packet(*(i_theta+i), &start, ((unsigned char*)theta)+i, &parity, &stop);
-            crc_8_calc(&crc_8_calculated, *(((unsigned char*)theta)+i) );
-            if (!(!start && (parity_calc( *(((unsigned char*)theta)+i) ) == parity) && stop)) {
-                std::cout << "Error detected when extracting theta byte." << std::endl;
-                crc_8_calculated = 0;
-                set_packet(o_header, BYTE_HEADER);
-                crc_8_calc(&crc_8_calculated, BYTE_HEADER);
-                set_packet(o_cmd, CMD_ERR);
-                crc_8_calc(&crc_8_calculated, CMD_ERR);
-                set_packet(o_crc_8, crc_8_calculated);
-                delete[] theta;
-                delete[] cos_theta;
-                delete[] sin_theta;
-                return;
-            }
+        if (!crc_8_packets(i_theta, 6, theta_bytes, &crc_8_calculated)) {
+            std::cout << "Error detected when extracting theta byte." << std::endl;
+            GREF_PROF_ERROR(PROF_ERR_THETA, t);
+            set_err_msg(o_header, o_cmd, o_crc_8);
+            return;
         }
-        
-        /* std::cout << "Theta is: " << std::hex << *theta << std::endl;
-        */
+        memcpy(theta, theta_bytes, 6);
         
         /* CRC byte */
         extract_packet(i_crc_8, &start, &crc_8, &parity, &stop);
         crc_8_calc(&crc_8_calculated, crc_8);
         if (!(!start && !crc_8_calculated && (parity_calc(crc_8) == parity) && stop)) {
             std::cout << "Error detected when extracting crc byte." << std::endl;
-            crc_8_calculated = 0;
-            set_packet(o_header, BYTE_HEADER);
-            crc_8_calc(&crc_8_calculated, BYTE_HEADER);
-            set_packet(o_cmd, CMD_ERR);
-            crc_8_calc(&crc_8_calculated, CMD_ERR);
-            set_packet(o_crc_8, crc_8_calculated);
-            delete[] theta;
-            delete[] cos_theta;
-            delete[] sin_theta;
+            GREF_PROF_ERROR(PROF_ERR_CRC, t);
+            set_err_msg(o_header, o_cmd, o_crc_8);
             return;
         }
 
@@ -314,7 +296,11 @@ extern "C" void cordic_gref(const short int     i_header,
         (*theta) |= ( (((*theta) >> 47) & 1UL) ? 0xFFFF000000000000 : 0 );
             
         /* CORDIC call */
-        cordic_sincos(theta, cos_theta, sin_theta);
+        GREF_PROF_COUNT(PROF_CMD_SINGLE, 1);
+        GREF_PROF_COUNT(PROF_ANGLES, 1);
+        GREF_PROF_SECTION(PROF_DECODE, t);
+        cordic_gref_sincos(theta, cos_theta, sin_theta, 1, seed_bits);
+        GREF_PROF_SECTION(PROF_CORDIC, t);
         
         /* Construct output msg */
         if (!(*disabled)) {
@@ -323,19 +309,14 @@ extern "C" void cordic_gref(const short int     i_header,
             crc_8_calc(&crc_8_calculated, BYTE_HEADER);
             set_packet(o_cmd, CMD_SINGLE_TRANS);
             crc_8_calc(&crc_8_calculated, CMD_SINGLE_TRANS);
-            for (int i = 0; i < 6; i++) {
-                set_packet(o_cos_theta+i, *(((unsigned char*)cos_theta)+i));
-                crc_8_calc(&crc_8_calculated, *(((unsigned char*)cos_theta)+i));
-            }
-            for (int i = 0; i < 6; i++) {
-                set_packet(o_sin_theta+i, *(((unsigned char*)sin_theta)+i));
-                crc_8_calc(&crc_8_calculated, *(((unsigned char*)sin_theta)+i));
-            }
+            set_packets(o_cos_theta, (unsigned char*)cos_theta, 6, &crc_8_calculated);
+            set_packets(o_sin_theta, (unsigned char*)sin_theta, 6, &crc_8_calculated);
             set_packet(o_crc_8, crc_8_calculated);
+            GREF_PROF_SECTION(PROF_ENCODE, t);
+        } else {
+            GREF_PROF_COUNT(PROF_SILENT, 1);
         }
-        delete[] theta;
-        delete[] cos_theta;
-        delete[] sin_theta;
+        GREF_PROF_CONVERGENCE(theta, 1, seed_bits);
         return;
         
     } else if (cmd == CMD_BURST_TRANS) {
@@ -345,53 +326,28 @@ extern "C" void cordic_gref(const short int     i_header,
         crc_8_calc(&crc_8_calculated, burst_cnt);
         if (!(!start && (burst_cnt >= 1 && burst_cnt <= 8) && (parity_calc(burst_cnt) == parity) && stop)) {
             std::cout << "Error detected when extracting burst_cnt byte." << std::endl;
-            crc_8_calculated = 0;
-            set_packet(o_header, BYTE_HEADER);
-            crc_8_calc(&crc_8_calculated, *o_header);
-            set_packet(o_cmd, CMD_ERR);
-            crc_8_calc(&crc_8_calculated, *o_cmd);
-            set_packet(o_crc_8, crc_8_calculated);
-            delete[] theta;
-            delete[] cos_theta;
-            delete[] sin_theta;
+            GREF_PROF_ERROR(PROF_ERR_BURST_CNT, t);
+            set_err_msg(o_header, o_cmd, o_crc_8);
             return;
         }
 
         /* Theta bytes */
-        for (int j = 0; j < burst_cnt; j++) {
-            for (int i = 0; i < 6; i++) {
-                extract_packet( *(i_theta + i + 6*j) , &start , ((unsigned char*)theta) + i + 8*j , &parity , &stop );
-                crc_8_calc(&crc_8_calculated, *(((unsigned char*)theta) + i + 8*j) );
-                if (!(!start && (parity_calc( *(((unsigned char*)theta) + i + 8*j) ) == parity) && stop)) {
-                    std::cout << "Error detected when extracting theta byte." << std::endl;
-                    crc_8_calculated = 0;
-                    set_packet(o_header, BYTE_HEADER);
-                    crc_8_calc(&crc_8_calculated, BYTE_HEADER);
-                    set_packet(o_cmd, CMD_ERR);
-                    crc_8_calc(&crc_8_calculated, CMD_ERR);
-                    set_packet(o_crc_8, crc_8_calculated);
-                    delete[] theta;
-                    delete[] cos_theta;
-                    delete[] sin_theta;
-                    return;
-                }
-            }
+        if (!crc_8_packets(i_theta, 6*burst_cnt, theta_bytes, &crc_8_calculated)) {
+            std::cout << "Error detected when extracting theta byte." << std::endl;
+            GREF_PROF_ERROR(PROF_ERR_THETA, t);
+            set_err_msg(o_header, o_cmd, o_crc_8);
+            return;
         }
+        for (int j = 0; j < burst_cnt; j++)
+            memcpy(theta + j, theta_bytes + 6*j, 6);
 
        /* CRC byte */
         extract_packet(i_crc_8, &start, &crc_8, &parity, &stop);
         crc_8_calc(&crc_8_calculated, crc_8);
         if (!(!start && !crc_8_calculated && (parity_calc(crc_8) == parity) && stop)) {
             std::cout << "Error detected when extracting crc byte." << std::endl;
-            crc_8_calculated = 0;
-            set_packet(o_header, BYTE_HEADER);
-            crc_8_calc(&crc_8_calculated, BYTE_HEADER);
-            set_packet(o_cmd, CMD_ERR);
-            crc_8_calc(&crc_8_calculated, CMD_ERR);
-            set_packet(o_crc_8, crc_8_calculated);
-            delete[] theta;
-            delete[] cos_theta;
-            delete[] sin_theta;
+            GREF_PROF_ERROR(PROF_ERR_CRC, t);
+            set_err_msg(o_header, o_cmd, o_crc_8);
             return;
         }
 
@@ -399,21 +355,12 @@ extern "C" void cordic_gref(const short int     i_header,
         for (int i = 0; i < burst_cnt; i++)
             (*(theta + i)) |= ( (((*(theta + i)) >> 47) & 1UL) ? 0xFFFF000000000000 : 0 );
 
-        /*
-        for (int i = 0; i < 8; i++)
-            std::cout << "Theta " << i << " is: " << std::hex << *(theta+i) << std::endl;
-        */
-
-        /* CORDIC call */
-        for (int i = 0; i < burst_cnt; i++) 
-            cordic_sincos(theta + i, cos_theta + i, sin_theta + i);
-
-        /*
-        for (int i = 0; i < 8; i++)
-            std::cout << "Cos theta " << i << " is: " << std::hex << *(cos_theta+i) << std::endl;
-        for (int i = 0; i < 8; i++)
-            std::cout << "Sin theta " << i << " is: " << std::hex << *(sin_theta+i) << std::endl;
-        */
+        /* CORDIC call, all thetas of the burst in lockstep */
+        GREF_PROF_COUNT(PROF_CMD_BURST, 1);
+        GREF_PROF_COUNT(PROF_ANGLES, burst_cnt);
+        GREF_PROF_SECTION(PROF_DECODE, t);
+        cordic_gref_sincos(theta, cos_theta, sin_theta, burst_cnt, seed_bits);
+        GREF_PROF_SECTION(PROF_CORDIC, t);
 
         /* Construct output msg */
         if (!(*disabled)) {
@@ -425,21 +372,575 @@ extern "C" void cordic_gref(const short int     i_header,
             set_packet(o_burst_cnt, burst_cnt);
             crc_8_calc(&crc_8_calculated, burst_cnt);
             for (int j = 0; j < burst_cnt; j++) {
-                for (int i = 0; i < 6; i++) {
-                    set_packet(o_cos_theta + i + j*6, *(((unsigned char*)(cos_theta+j))+i) );
-                    crc_8_calc(&crc_8_calculated, *(((unsigned char*)(cos_theta+j))+i) );
-                }
-                for (int i = 0; i < 6; i++) {
-                    set_packet(o_sin_theta + i + j*6, *(((unsigned char*)(sin_theta+j))+i) );
-                    crc_8_calc(&crc_8_calculated, *(((unsigned char*)(sin_theta+j))+i) );
-                }
+                set_packets(o_cos_theta + j*6, (unsigned char*)(cos_theta+j), 6, &crc_8_calculated);
+                set_packets(o_sin_theta + j*6, (unsigned char*)(sin_theta+j), 6, &crc_8_calculated);
             }
             set_packet(o_crc_8, crc_8_calculated);
+            GREF_PROF_SECTION(PROF_ENCODE, t);
+        } else {
+            GREF_PROF_COUNT(PROF_SILENT, 1);
         }
-        delete[] theta;
-        delete[] cos_theta;
-        delete[] sin_theta;
+        GREF_PROF_CONVERGENCE(theta, burst_cnt, seed_bits);
         return;
+
+    } else if (cmd == CMD_VECTOR_TRANS) {
+
+        /* x and y bytes, in the theta packets */
+        if (!crc_8_packets(i_theta, 12, theta_bytes, &crc_8_calculated)) {
+            std::cout << "Error detected when extracting x/y byte." << std::endl;
+            GREF_PROF_ERROR(PROF_ERR_THETA, t);
+            set_err_msg(o_header, o_cmd, o_crc_8);
+            return;
+        }
+        memcpy(theta, theta_bytes, 6);
+        memcpy(theta + 1, theta_bytes + 6, 6);
+
+        /* CRC byte */
+        extract_packet(i_crc_8, &start, &crc_8, &parity, &stop);
+        crc_8_calc(&crc_8_calculated, crc_8);
+        if (!(!start && !crc_8_calculated && (parity_calc(crc_8) == parity) && stop)) {
+            std::cout << "Error detected when extracting crc byte." << std::endl;
+            GREF_PROF_ERROR(PROF_ERR_CRC, t);
+            set_err_msg(o_header, o_cmd, o_crc_8);
+            return;
+        }
+
+        /* Sign extension */
+        for (int i = 0; i < 2; i++)
+            (*(theta + i)) |= ( (((*(theta + i)) >> 47) & 1UL) ? 0xFFFF000000000000 : 0 );
+
+        /* CORDIC call, magnitude and angle in the cos and sin slots */
+        GREF_PROF_COUNT(PROF_CMD_VECTOR, 1);
+        GREF_PROF_SECTION(PROF_DECODE, t);
+        cordic_vectoring(theta[0], theta[1], cos_theta, sin_theta);
+        GREF_PROF_SECTION(PROF_CORDIC, t);
+
+        /* Construct output msg */
+        if (!(*disabled)) {
+            crc_8_calculated = 0;
+            set_packet(o_header, BYTE_HEADER);
+            crc_8_calc(&crc_8_calculated, BYTE_HEADER);
+            set_packet(o_cmd, CMD_VECTOR_TRANS);
+            crc_8_calc(&crc_8_calculated, CMD_VECTOR_TRANS);
+            set_packets(o_cos_theta, (unsigned char*)cos_theta, 6, &crc_8_calculated);
+            set_packets(o_sin_theta, (unsigned char*)sin_theta, 6, &crc_8_calculated);
+            set_packet(o_crc_8, crc_8_calculated);
+            GREF_PROF_SECTION(PROF_ENCODE, t);
+        } else {
+            GREF_PROF_COUNT(PROF_SILENT, 1);
+        }
+        return;
+    }
+
+}
+
+/* SystemVerilog exported C++ function, plain CORDIC pipeline */
+extern "C" void cordic_gref(const short int     i_header,
+                            const short int     i_cmd, 
+                            const short int     i_burst_cnt, 
+                            const short int*    i_theta,
+                            const short int     i_crc_8,
+                            char*               disabled,           
+                            short int*          o_header,
+                            short int*          o_cmd, 
+                            short int*          o_burst_cnt,
+                            short int*          o_cos_theta,
+                            short int*          o_sin_theta,
+                            short int*          o_crc_8 ) 
+{
+    gref_msg(0, i_header, i_cmd, i_burst_cnt, i_theta, i_crc_8, disabled,
+             o_header, o_cmd, o_burst_cnt, o_cos_theta, o_sin_theta, o_crc_8);
+}
+
+/* Messages a batch call processes: i_num_msgs clamped to [0, GREF_BATCH_MAX], reporting the
+   messages beyond the limit that are left unprocessed */
+static int batch_num_msgs(const int i_num_msgs)
+{
+    if (i_num_msgs > GREF_BATCH_MAX) {
+        std::cout << "Error: batch of " << i_num_msgs << " messages exceeds GREF_BATCH_MAX ("
+                  << GREF_BATCH_MAX << "), processing the first " << GREF_BATCH_MAX << "." << std::endl;
+        return GREF_BATCH_MAX;
+    }
+    return (i_num_msgs < 0) ? 0 : i_num_msgs;
+}
+
+/* SystemVerilog exported C++ function, batched. Processes i_num_msgs packed input messages
+   (GREF_IN_MSG_LEN packets each) into caller-owned packed output messages (GREF_OUT_MSG_LEN
+   packets each). The disabled state carries from one message to the next. Returns the number of
+   messages processed, at most GREF_BATCH_MAX. */
+extern "C" int cordic_gref_batch(const int         i_num_msgs,
+                                 const short int*  i_msgs,
+                                 char*             disabled,
+                                 short int*        o_msgs )
+{
+    int num_msgs = batch_num_msgs(i_num_msgs);
+    for (int n = 0; n < num_msgs; n++) {
+        const short int* i_msg = i_msgs + n*GREF_IN_MSG_LEN;
+        short int*       o_msg = o_msgs + n*GREF_OUT_MSG_LEN;
+        cordic_gref(i_msg[GREF_IN_HEADER],
+                    i_msg[GREF_IN_CMD],
+                    i_msg[GREF_IN_BURST_CNT],
+                    i_msg + GREF_IN_THETA,
+                    i_msg[GREF_IN_CRC_8],
+                    disabled,
+                    o_msg + GREF_OUT_HEADER,
+                    o_msg + GREF_OUT_CMD,
+                    o_msg + GREF_OUT_BURST_CNT,
+                    o_msg + GREF_OUT_COS_THETA,
+                    o_msg + GREF_OUT_SIN_THETA,
+                    o_msg + GREF_OUT_CRC_8);
+    }
+    return num_msgs;
+}
+
+/* Bytes per theta and per cos/sin result of a CMD_STREAM_TRANS mode byte */
+static const int STREAM_WIDTH_BYTES[4] = {2, 3, 4, 6};
+
+int stream_theta_bytes(unsigned char mode) {
+    return STREAM_WIDTH_BYTES[(mode >> STREAM_MODE_THETA_SHIFT) & 3];
+}
+
+int stream_result_bytes(unsigned char mode) {
+    return STREAM_WIDTH_BYTES[mode & 3];
+}
+
+/* Unpacks one little-endian stream theta into a sign-extended 4.44 value. The bytes sent are the
+   top of the 48-bit theta; the bits below are zero, as uart_rx_msg masks them. */
+long long stream_theta(const unsigned char* b, unsigned char mode) {
+    int n = stream_theta_bytes(mode);
+    unsigned long long t = 0;
+    for (int i = n - 1; i >= 0; i--)
+        t = (t << 8) | b[i];
+    return (long long)(t << (64 - 8*n)) >> 16;
+}
+
+/* Packs one 2.46 result as uart_tx_msg does: the top result_bytes of the 48-bit value,
+   truncated, or rounded half up when the mode asks for it. |v| <= 1.0, so rounding cannot
+   overflow. */
+void stream_result(long long v, unsigned char mode, unsigned char* b) {
+    int n = stream_result_bytes(mode);
+    int drop = 48 - 8*n;
+    if (drop && (mode & STREAM_MODE_ROUND))
+        v += 1LL << (drop - 1);
+    v >>= drop;
+    for (int i = 0; i < n; i++)
+        b[i] = (unsigned char)(v >> (8*i));
+}
+
+/* Message-level model of one CMD_STREAM_TRANS message for a given CORDIC mode; msg is scratch
+   space for the unpacked bytes */
+static int gref_stream(const int                    seed_bits,
+                       const int                    i_len,
+                       const short int*             i_msg,
+                       char*                        disabled,
+                       short int*                   o_msg,
+                       std::vector<unsigned char>&  msg)
+{
+    unsigned char crc_8_calculated = 0;
+    GREF_PROF_TIMER(t);
+    msg.resize(i_len > 0 ? i_len : 1);
+
+    /* Framing of every packet, then header, cmd, length and CRC */
+    if (i_len < 6 || !crc_8_packets(i_msg, i_len, msg.data(), &crc_8_calculated)
+        || msg[0] != BYTE_HEADER || msg[1] != CMD_STREAM_TRANS) {
+        std::cout << "Error detected when extracting stream header." << std::endl;
+        GREF_PROF_ERROR(PROF_ERR_STREAM_HEADER, t);
+        set_err_msg(o_msg, o_msg + 1, o_msg + 2);
+        return 3;
+    }
+    unsigned char mode = msg[2];
+    int cnt = msg[3] | (msg[4] << 8);
+    if (!cnt)
+        cnt = STREAM_MAX_CNT;
+    int theta_bytes = stream_theta_bytes(mode);
+    if (i_len != 5 + cnt*theta_bytes + 1 || crc_8_calculated) {
+        std::cout << "Error detected when extracting stream thetas or crc byte." << std::endl;
+        GREF_PROF_ERROR(PROF_ERR_STREAM_LEN, t);
+        set_err_msg(o_msg, o_msg + 1, o_msg + 2);
+        return 3;
+    }
+    GREF_PROF_COUNT(PROF_CMD_STREAM, 1);
+    GREF_PROF_COUNT(PROF_ANGLES, cnt);
+    if (*disabled) {
+        GREF_PROF_COUNT(PROF_SILENT, 1);
+        GREF_PROF_SECTION(PROF_DECODE, t);
+        return 0;
+    }
+
+    /* Header, cmd, mode and count are echoed */
+    int len = 0, result_bytes = stream_result_bytes(mode);
+    crc_8_calculated = 0;
+    set_packets(o_msg, msg.data(), 5, &crc_8_calculated);
+    len += 5;
+
+    long long theta[8], cos_theta[8], sin_theta[8];
+    unsigned char out[12];
+    for (int j = 0; j < cnt; j += 8) {
+        int n = (cnt - j < 8) ? cnt - j : 8;
+        for (int k = 0; k < n; k++)
+            theta[k] = stream_theta(msg.data() + 5 + (j + k)*theta_bytes, mode);
+        GREF_PROF_SECTION(PROF_DECODE, t);
+        cordic_gref_sincos(theta, cos_theta, sin_theta, n, seed_bits);
+        GREF_PROF_SECTION(PROF_CORDIC, t);
+        for (int k = 0; k < n; k++) {
+            stream_result(cos_theta[k], mode, out);
+            stream_result(sin_theta[k], mode, out + result_bytes);
+            set_packets(o_msg + len, out, 2*result_bytes, &crc_8_calculated);
+            len += 2*result_bytes;
+        }
+        GREF_PROF_SECTION(PROF_ENCODE, t);
+        GREF_PROF_CONVERGENCE(theta, n, seed_bits);
+        GREF_PROF_RESTART(t);
+    }
+    set_packet(o_msg + len, crc_8_calculated);
+    return len + 1;
+}
+
+/* SystemVerilog exported C++ function for CMD_STREAM_TRANS, whose messages are too long for the
+   fixed cordic_gref() arguments. i_msg holds the i_len packets of one message (header through
+   crc); o_msg receives the response packets and must hold 5 + 12*cnt + 1 of them (cnt being the
+   angle count the message asks for), or STREAM_MAX_CNT angles' worth when that is not known.
+   Returns the number of response packets: 0 while disabled, 3 for the error message. */
+extern "C" int cordic_gref_stream(const int         i_len,
+                                  const short int*  i_msg,
+                                  char*             disabled,
+                                  short int*        o_msg )
+{
+    // Scratch kept across calls like cordic_gref_ctx's stream_msg, one per emulator worker thread
+    static thread_local std::vector<unsigned char> msg;
+    return gref_stream(0, i_len, i_msg, disabled, o_msg, msg);
+}
+
+/* CRC-32 byte table for SELFTEST_CRC_POLY, MSB first */
+static const struct selftest_crc_table_t {
+    unsigned int t[256];
+    selftest_crc_table_t() : t() {
+        for (int b = 0; b < 256; b++) {
+            unsigned int crc = (unsigned int)b << 24;
+            for (int j = 0; j < 8; j++)
+                crc = (crc << 1) ^ ((crc & 0x80000000u) ? SELFTEST_CRC_POLY : 0);
+            t[b] = crc;
+        }
+    }
+} SELFTEST_CRC_TABLE;
+
+static const unsigned long long SELFTEST_LFSR_MASK = (1ULL << 48) - 1;
+
+/* Galois step of lfsr.sv: shift left, XOR the polynomial when the MSB falls out */
+unsigned long long selftest_lfsr_step(unsigned long long state) {
+    return ((state << 1) & SELFTEST_LFSR_MASK) ^ (((state >> 47) & 1) ? SELFTEST_LFSR_POLY : 0);
+}
+
+/* The 48-bit state as a signed 4.44 value, halved (selftest_theta() in pkg_msg.sv) */
+long long selftest_theta(unsigned long long state) {
+    return (long long)(state << 16) >> 17;
+}
+
+/* Folds the 12 response bytes of one result (cos then sin, LSB first) into the signature */
+unsigned int selftest_crc(unsigned int crc, long long cos_theta, long long sin_theta) {
+    for (int i = 0; i < 12; i++) {
+        unsigned char b = (unsigned char)(((i < 6) ? cos_theta : sin_theta) >> (8*(i % 6)));
+        crc = (crc << 8) ^ SELFTEST_CRC_TABLE.t[(crc >> 24) ^ b];
     }
+    return crc;
+}
+
+extern "C" void cordic_gref_selftest(const int          i_seed_bits,
+                                     const long long    i_seed,
+                                     const long long    i_count,
+                                     unsigned int*      o_signature,
+                                     long long*         o_cycles )
+{
+    unsigned long long state = (unsigned long long)i_seed & SELFTEST_LFSR_MASK;
+    unsigned int crc = 0xffffffff;
+    long long theta[8], cos_theta[8], sin_theta[8];
+    for (long long j = 0; j < i_count; j += 8) {
+        int n = (i_count - j < 8) ? (int)(i_count - j) : 8;
+        for (int k = 0; k < n; k++) {
+            theta[k] = selftest_theta(state);
+            state    = selftest_lfsr_step(state);
+        }
+        cordic_gref_sincos(theta, cos_theta, sin_theta, n, i_seed_bits);
+        for (int k = 0; k < n; k++)
+            crc = selftest_crc(crc, cos_theta[k], sin_theta[k]);
+    }
+    *o_signature = crc;
+    *o_cycles    = i_count + SELFTEST_LATENCY - i_seed_bits;
+}
 
-}
\ No newline at end of file
+extern "C" void cordic_gref_selftest_lanes(const int          i_seed_bits,
+                                           const int          i_lanes,
+                                           const long long    i_seed,
+                                           const long long    i_count,
+                                           unsigned int*      o_signature,
+                                           long long*         o_cycles )
+{
+    int latency = SELFTEST_LATENCY - i_seed_bits;
+    cordic_lanes_model lanes(i_lanes, latency);
+    std::vector<cordic_lanes_result_t> out;
+
+    /* Results wait in a ring indexed by angle number until the lane model hands them out */
+    size_t ring = (size_t)i_lanes * (latency + 1);
+    std::vector<long long> ring_cos(ring), ring_sin(ring);
+
+    unsigned long long state = (unsigned long long)i_seed & SELFTEST_LFSR_MASK;
+    unsigned int crc = 0xffffffff;
+    long long theta[CORDIC_MAX_LANES], cos_theta[CORDIC_MAX_LANES], sin_theta[CORDIC_MAX_LANES];
+    long long tags[CORDIC_MAX_LANES];
+    long long issued = 0, folded = 0, cycles = 0;
+    while (folded < i_count) {
+        int n = (i_count - issued < i_lanes) ? (int)(i_count - issued) : i_lanes;
+        for (int k = 0; k < n; k++) {
+            theta[k] = selftest_theta(state);
+            state    = selftest_lfsr_step(state);
+            tags[k]  = issued + k;
+        }
+        cordic_gref_sincos(theta, cos_theta, sin_theta, n, i_seed_bits);
+        for (int k = 0; k < n; k++) {
+            ring_cos[tags[k] % ring] = cos_theta[k];
+            ring_sin[tags[k] % ring] = sin_theta[k];
+        }
+        issued += n;
+
+        out.clear();
+        lanes.cycle(n, tags, out);
+        cycles++;
+        for (const cordic_lanes_result_t& r : out) {
+            crc = selftest_crc(crc, ring_cos[r.tag % ring], ring_sin[r.tag % ring]);
+            folded++;
+        }
+    }
+    *o_signature = crc;
+    *o_cycles    = cycles;
+}
+
+/* Message-level model of one CMD_SELFTEST message for a given CORDIC mode; o_cnt receives the
+   angle count of a valid message */
+static int gref_selftest(const int          seed_bits,
+                         const int          lanes,
+                         const int          i_len,
+                         const short int*   i_msg,
+                         char*              disabled,
+                         short int*         o_msg,
+                         long long*         o_cnt )
+{
+    unsigned char crc_8_calculated = 0, msg[SELFTEST_MSG_LEN];
+    GREF_PROF_TIMER(t);
+
+    /* Framing of every packet, header and cmd, then CRC */
+    if (i_len != SELFTEST_MSG_LEN || !crc_8_packets(i_msg, i_len, msg, &crc_8_calculated)
+        || msg[0] != BYTE_HEADER || msg[1] != CMD_SELFTEST) {
+        std::cout << "Error detected when extracting selftest seed or count byte." << std::endl;
+        GREF_PROF_ERROR(PROF_ERR_THETA, t);
+        set_err_msg(o_msg, o_msg + 1, o_msg + 2);
+        return 3;
+    }
+    if (crc_8_calculated) {
+        std::cout << "Error detected when extracting crc byte." << std::endl;
+        GREF_PROF_ERROR(PROF_ERR_CRC, t);
+        set_err_msg(o_msg, o_msg + 1, o_msg + 2);
+        return 3;
+    }
+    long long seed = 0, cnt = 0;
+    for (int i = 5; i >= 0; i--)
+        seed = (seed << 8) | msg[2 + i];
+    for (int i = 3; i >= 0; i--)
+        cnt = (cnt << 8) | msg[8 + i];
+    if (!cnt)
+        cnt = SELFTEST_MAX_CNT;
+    *o_cnt = cnt;
+    GREF_PROF_COUNT(PROF_CMD_SELFTEST, 1);
+    GREF_PROF_COUNT(PROF_ANGLES, cnt);
+    GREF_PROF_SECTION(PROF_DECODE, t);
+
+    /* The DUT never starts a self-test while disabled */
+    if (*disabled) {
+        GREF_PROF_COUNT(PROF_SILENT, 1);
+        return 0;
+    }
+
+    unsigned int signature;
+    long long cycles;
+    if (lanes == 1)
+        cordic_gref_selftest(seed_bits, seed, cnt, &signature, &cycles);
+    else
+        cordic_gref_selftest_lanes(seed_bits, lanes, seed, cnt, &signature, &cycles);
+    GREF_PROF_SECTION(PROF_CORDIC, t);
+
+    unsigned char out[12] = {BYTE_HEADER, CMD_SELFTEST};
+    for (int i = 0; i < 4; i++)
+        out[2 + i] = (unsigned char)(signature >> (8*i));
+    for (int i = 0; i < 6; i++)
+        out[6 + i] = (unsigned char)(cycles >> (8*i));
+    crc_8_calculated = 0;
+    set_packets(o_msg, out, 12, &crc_8_calculated);
+    set_packet(o_msg + 12, crc_8_calculated);
+    GREF_PROF_SECTION(PROF_ENCODE, t);
+    return SELFTEST_MSG_LEN;
+}
+
+/* Reentrant model instance (see cordic_gref.h). Nothing here is shared between instances. */
+struct cordic_gref_ctx {
+    int                         seed_bits;
+    int                         lanes;
+    char                        disabled;
+    unsigned long long          stats[GREF_NUM_STATS];
+    std::vector<unsigned char>  stream_msg;                 // gref_stream scratch
+    short int                   msg_in[GREF_IN_MSG_LEN];    // wire order to cordic_gref layout
+    short int                   msg_out[GREF_OUT_MSG_LEN];
+};
+
+extern "C" cordic_gref_ctx* cordic_gref_ctx_create(const int i_seed_bits) {
+    if (i_seed_bits < 0 || i_seed_bits > 44)
+        return NULL;
+    cordic_gref_ctx* ctx = new cordic_gref_ctx();
+    ctx->seed_bits = i_seed_bits;
+    ctx->lanes     = 1;
+    return ctx;
+}
+
+extern "C" int cordic_gref_ctx_set_lanes(cordic_gref_ctx* ctx, const int i_lanes) {
+    if (i_lanes < 1 || i_lanes > CORDIC_MAX_LANES)
+        return 0;
+    ctx->lanes = i_lanes;
+    return 1;
+}
+
+extern "C" void cordic_gref_ctx_destroy(cordic_gref_ctx* ctx) {
+    delete ctx;
+}
+
+extern "C" int cordic_gref_ctx_disabled(const cordic_gref_ctx* ctx) {
+    return ctx->disabled;
+}
+
+extern "C" void cordic_gref_ctx_rx_err(cordic_gref_ctx* ctx) {
+    ctx->disabled = 0;
+}
+
+extern "C" void cordic_gref_ctx_count_single(cordic_gref_ctx* ctx) {
+    ctx->stats[GREF_STAT_SINGLE]++;
+    ctx->stats[GREF_STAT_ANGLES]++;
+}
+
+extern "C" void cordic_gref_ctx_stats(const cordic_gref_ctx* ctx, unsigned long long* o_stats) {
+    memcpy(o_stats, ctx->stats, sizeof(ctx->stats));
+}
+
+extern "C" int cordic_gref_num_stats() {
+    return GREF_NUM_STATS;
+}
+
+/* Counts one request by the response the model gave it */
+static void count_response(cordic_gref_ctx* ctx, unsigned char cmd, long long num_theta, const short int* o_cmd) {
+    if (!(*o_cmd)) {
+        ctx->stats[GREF_STAT_SILENT]++;
+        return;
+    }
+    switch ((*o_cmd >> 1) & 0xff) {
+        case CMD_SINGLE_TRANS:  ctx->stats[GREF_STAT_SINGLE]++;     break;
+        case CMD_BURST_TRANS:   ctx->stats[GREF_STAT_BURST]++;      break;
+        case CMD_STREAM_TRANS:  ctx->stats[GREF_STAT_STREAM]++;     break;
+        case CMD_VECTOR_TRANS:  ctx->stats[GREF_STAT_VECTOR]++;     break;
+        case CMD_SELFTEST:      ctx->stats[GREF_STAT_SELFTEST]++;   break;
+        case CMD_DISABLE:       ctx->stats[GREF_STAT_DISABLE]++;    break;
+        case CMD_ENABLE:        ctx->stats[GREF_STAT_ENABLE]++;     break;
+        default:                ctx->stats[GREF_STAT_ERR]++;        return;
+    }
+    if (cmd == CMD_SINGLE_TRANS || cmd == CMD_BURST_TRANS || cmd == CMD_STREAM_TRANS || cmd == CMD_SELFTEST)
+        ctx->stats[GREF_STAT_ANGLES] += num_theta;
+}
+
+extern "C" int cordic_gref_ctx_process(cordic_gref_ctx*    ctx,
+                                       const int           i_len,
+                                       const short int*    i_msg,
+                                       short int*          o_msg )
+{
+    unsigned char cmd = (i_len > 1) ? (i_msg[1] >> 1) & 0xff : 0;
+    if (cmd == CMD_STREAM_TRANS) {
+        int len = gref_stream(ctx->seed_bits, i_len, i_msg, &ctx->disabled, o_msg, ctx->stream_msg);
+        int cnt = (len > 5) ? (len - 6) / (2*stream_result_bytes((o_msg[2] >> 1) & 0xff)) : 0;
+        short int silent = 0;
+        count_response(ctx, cmd, cnt, len ? o_msg + 1 : &silent);
+        return len;
+    }
+    if (cmd == CMD_SELFTEST) {
+        long long cnt = 0;
+        int len = gref_selftest(ctx->seed_bits, ctx->lanes, i_len, i_msg, &ctx->disabled, o_msg, &cnt);
+        short int silent = 0;
+        count_response(ctx, cmd, cnt, len ? o_msg + 1 : &silent);
+        return len;
+    }
+
+    /* Wire order (header, cmd, [burst cnt], thetas, crc) to the cordic_gref arguments; a message
+       of the wrong length fails the CRC or framing checks */
+    short int* in  = ctx->msg_in;
+    short int* out = ctx->msg_out;
+    int first = (cmd == CMD_BURST_TRANS) ? 3 : 2;
+    int num_theta = (i_len > first) ? i_len - 1 - first : 0;
+    memset(in, 0, sizeof(ctx->msg_in));
+    if (i_len < 3 || num_theta > 6*8) {
+        set_err_msg(o_msg, o_msg + 1, o_msg + 2);
+        ctx->stats[GREF_STAT_ERR]++;
+        return 3;
+    }
+    in[GREF_IN_HEADER]      = i_msg[0];
+    in[GREF_IN_CMD]         = i_msg[1];
+    in[GREF_IN_BURST_CNT]   = (cmd == CMD_BURST_TRANS) ? i_msg[2] : 0;
+    memcpy(in + GREF_IN_THETA, i_msg + first, sizeof(short int)*num_theta);
+    in[GREF_IN_CRC_8]       = i_msg[i_len - 1];
+    gref_msg(ctx->seed_bits, in[GREF_IN_HEADER], in[GREF_IN_CMD], in[GREF_IN_BURST_CNT], in + GREF_IN_THETA,
+             in[GREF_IN_CRC_8], &ctx->disabled, out + GREF_OUT_HEADER, out + GREF_OUT_CMD,
+             out + GREF_OUT_BURST_CNT, out + GREF_OUT_COS_THETA, out + GREF_OUT_SIN_THETA, out + GREF_OUT_CRC_8);
+    count_response(ctx, cmd, num_theta / 6, out + GREF_OUT_CMD);
+    if (!out[GREF_OUT_HEADER])
+        return 0;
+
+    /* Response in wire order: cos then sin per angle (magnitude then atan2 for VECTOR) */
+    int len = 0, n = 0;
+    unsigned char o_cmd = (out[GREF_OUT_CMD] >> 1) & 0xff;
+    o_msg[len++] = out[GREF_OUT_HEADER];
+    o_msg[len++] = out[GREF_OUT_CMD];
+    if (o_cmd == CMD_SINGLE_TRANS || o_cmd == CMD_VECTOR_TRANS)
+        n = 1;
+    if (o_cmd == CMD_BURST_TRANS) {
+        o_msg[len++] = out[GREF_OUT_BURST_CNT];
+        n = (out[GREF_OUT_BURST_CNT] >> 1) & 0xff;
+    }
+    for (int j = 0; j < n; j++) {
+        memcpy(o_msg + len, out + GREF_OUT_COS_THETA + 6*j, sizeof(short int)*6);
+        memcpy(o_msg + len + 6, out + GREF_OUT_SIN_THETA + 6*j, sizeof(short int)*6);
+        len += 12;
+    }
+    o_msg[len++] = out[GREF_OUT_CRC_8];
+    return len;
+}
+
+extern "C" int cordic_gref_ctx_batch(cordic_gref_ctx*     ctx,
+                                     const int            i_num_msgs,
+                                     const short int*     i_msgs,
+                                     short int*           o_msgs )
+{
+    int num_msgs = batch_num_msgs(i_num_msgs);
+    for (int n = 0; n < num_msgs; n++) {
+        const short int* i_msg = i_msgs + n*GREF_IN_MSG_LEN;
+        short int*       o_msg = o_msgs + n*GREF_OUT_MSG_LEN;
+        unsigned char    cmd   = (i_msg[GREF_IN_CMD] >> 1) & 0xff;
+        gref_msg(ctx->seed_bits,
+                 i_msg[GREF_IN_HEADER],
+                 i_msg[GREF_IN_CMD],
+                 i_msg[GREF_IN_BURST_CNT],
+                 i_msg + GREF_IN_THETA,
+                 i_msg[GREF_IN_CRC_8],
+                 &ctx->disabled,
+                 o_msg + GREF_OUT_HEADER,
+                 o_msg + GREF_OUT_CMD,
+                 o_msg + GREF_OUT_BURST_CNT,
+                 o_msg + GREF_OUT_COS_THETA,
+                 o_msg + GREF_OUT_SIN_THETA,
+                 o_msg + GREF_OUT_CRC_8);
+        count_response(ctx, cmd, (cmd == CMD_BURST_TRANS) ? (i_msg[GREF_IN_BURST_CNT] >> 1) & 0xff : 1,
+                       o_msg + GREF_OUT_CMD);
+    }
+    return num_msgs;
+}
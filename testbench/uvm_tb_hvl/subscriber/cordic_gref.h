@@ -0,0 +1,123 @@
+//
+// File:        cordic_gref.h
+// Author:      agent
+// Date:        10/2026
+// Description: Function declarations for the golden reference C++ implementation of CORDIC-UART
+//
+
+#ifndef CORDIC_GREF_H
+#define CORDIC_GREF_H
+
+/* UART packet and CRC-8 helpers */
+bool parity_calc(unsigned char i_data_frame);
+void extract_packet(short int packet, bool* start_bit, unsigned char* data_frame,
+                    bool* parity_bit, bool* stop_bit);
+void set_packet(short int* packet, unsigned char data_frame);
+void crc_8_calc(unsigned char* crc_8, unsigned char i_byte);
+void set_err_msg(short int* o_header, short int* o_cmd, short int* o_crc_8);
+
+/* Building blocks of the sin/cos models: the quadrant fold (z in 2.46 and the final negation) and
+   rotation stage i of x, y and z */
+void cordic_fold(long long theta, long long* z, bool* sign);
+void cordic_stage(int i, long long* x, long long* y, long long* z);
+
+/* CORDIC model, one angle */
+void cordic_sincos(long long* theta, long long* x, long long* y);
+
+/* CORDIC model, up to 8 angles of a burst evaluated in lockstep. Dispatches at runtime
+   to the widest kernel the CPU supports; every kernel is bit-exact with cordic_sincos(). */
+void cordic_sincos_burst(const long long* theta, long long* x, long long* y, int n);
+void cordic_sincos_burst_scalar(const long long* theta, long long* x, long long* y, int n);
+void cordic_sincos_burst_avx2(const long long* theta, long long* x, long long* y, int n);
+void cordic_sincos_burst_avx512(const long long* theta, long long* x, long long* y, int n);
+
+/* Hybrid (ROM-seeded) CORDIC model of cordic_sincos #(.SEED_BITS(seed_bits)): seed ROM entry
+   idx (cos/sin in 2.46, scaled by the gain of the stages that follow), the ROM lookup of a folded
+   angle (x, y from the ROM, z left with the remainder) and one angle */
+void cordic_seed_rom_entry(int stages, int seed_bits, int idx, long long* cos_seed, long long* sin_seed);
+void cordic_seed(int seed_bits, long long* z, long long* x, long long* y);
+void cordic_sincos_hybrid(long long* theta, long long* x, long long* y, int seed_bits);
+
+/* Vectoring-mode CORDIC model of cordic_vectoring #(.STAGES(48), .BITS(48)): magnitude (2.46) and
+   atan2(y, x) (4.44) of x, y in 2.46 */
+void cordic_vectoring(long long x, long long y, long long* magnitude, long long* atan);
+
+/* CORDIC model behind the message-level functions: cordic_sincos_burst() for seed_bits 0, else the
+   hybrid model of that SEED_BITS */
+void cordic_gref_sincos(const long long* theta, long long* x, long long* y, int n, int seed_bits);
+
+/* Message-level model (DPI-C entry points) of the plain pipeline, also used directly by the host
+   tools. The caller owns the DISABLE/ENABLE state. */
+extern "C" void cordic_gref(const short int i_header, const short int i_cmd, const short int i_burst_cnt,
+                            const short int* i_theta, const short int i_crc_8, char* disabled,
+                            short int* o_header, short int* o_cmd, short int* o_burst_cnt,
+                            short int* o_cos_theta, short int* o_sin_theta, short int* o_crc_8);
+/* Batched cordic_gref() over packed messages (cordic_gref_const.h layout). At most GREF_BATCH_MAX
+   messages are processed per call; a larger i_num_msgs is reported and only its first
+   GREF_BATCH_MAX messages are processed. Returns the number of messages processed. */
+extern "C" int cordic_gref_batch(const int i_num_msgs, const short int* i_msgs, char* disabled,
+                                 short int* o_msgs);
+
+/* CMD_STREAM_TRANS payload helpers: bytes per theta and per cos/sin result of a mode byte,
+   unpacking a theta and packing a truncated or rounded result (little-endian) */
+int stream_theta_bytes(unsigned char mode);
+int stream_result_bytes(unsigned char mode);
+long long stream_theta(const unsigned char* b, unsigned char mode);
+void stream_result(long long v, unsigned char mode, unsigned char* b);
+
+/* Message-level model of CMD_STREAM_TRANS, one packet per short int; returns the response length */
+extern "C" int cordic_gref_stream(const int i_len, const short int* i_msg, char* disabled,
+                                  short int* o_msg);
+
+/* CMD_SELFTEST model (cordic_selftest.sv): one step of the 48-bit angle LFSR, the theta of an LFSR
+   state, and one cos/sin result folded into the CRC-32 signature */
+unsigned long long selftest_lfsr_step(unsigned long long state);
+long long selftest_theta(unsigned long long state);
+unsigned int selftest_crc(unsigned int crc, long long cos_theta, long long sin_theta);
+
+/* Expected CMD_SELFTEST response fields for i_count angles (1..SELFTEST_MAX_CNT) from i_seed on
+   cordic_sincos #(.SEED_BITS(i_seed_bits)): the signature, and the cycle count of a run that
+   never stalls. Every angle goes through the CORDIC model, so 2^32 of them take minutes. */
+extern "C" void cordic_gref_selftest(const int i_seed_bits, const long long i_seed, const long long i_count,
+                                     unsigned int* o_signature, long long* o_cycles);
+
+/* cordic_gref_selftest() on i_lanes (1..CORDIC_MAX_LANES) lanes of cordic_lanes on i_clk: the
+   angles go through the lane model (cordic_lanes.h) and are folded in the order it reassembles
+   them, and the cycle count is that of the model. The signature is the same for any lane count. */
+extern "C" void cordic_gref_selftest_lanes(const int i_seed_bits, const int i_lanes, const long long i_seed,
+                                           const long long i_count, unsigned int* o_signature,
+                                           long long* o_cycles);
+
+/* Reentrant model instance for one DUT: owns the DISABLE/ENABLE state, the CORDIC mode (SEED_BITS,
+   0 for the plain pipeline), scratch buffers and per-command statistics (GREF_STAT_*). There is
+   no global state, so each simulation thread or DUT instance can run its own without locking.
+   create returns NULL for an unsupported seed_bits. set_lanes models CMD_SELFTEST on that many
+   lanes (top_module CORDIC_LANES, 1 by default) and returns 0 for an unsupported count. */
+struct cordic_gref_ctx;
+extern "C" cordic_gref_ctx* cordic_gref_ctx_create(const int i_seed_bits);
+extern "C" void cordic_gref_ctx_destroy(cordic_gref_ctx* ctx);
+extern "C" int cordic_gref_ctx_disabled(const cordic_gref_ctx* ctx);
+extern "C" void cordic_gref_ctx_stats(const cordic_gref_ctx* ctx, unsigned long long* o_stats);
+/* GREF_NUM_STATS, for simulators to check their copy of the statistics layout */
+extern "C" int cordic_gref_num_stats();
+extern "C" int cordic_gref_ctx_set_lanes(cordic_gref_ctx* ctx, const int i_lanes);
+
+/* uart_rx_msg reset by a parity or framing error (o_rx_err) or a crc mismatch (o_rx_msg_err),
+   which enables the pipelines again */
+extern "C" void cordic_gref_ctx_rx_err(cordic_gref_ctx* ctx);
+
+/* Counts a SINGLE whose response came from outside the model (golden vectors) in the statistics */
+extern "C" void cordic_gref_ctx_count_single(cordic_gref_ctx* ctx);
+
+/* One request message of any command, packets in wire order (header through crc), to the
+   response packets in wire order. o_msg is sized as for cordic_gref_stream(). Returns the number
+   of response packets, 0 when the disabled DUT stays silent. */
+extern "C" int cordic_gref_ctx_process(cordic_gref_ctx* ctx, const int i_len, const short int* i_msg,
+                                       short int* o_msg);
+
+/* cordic_gref_batch() on the instance's state and CORDIC mode, with the same GREF_BATCH_MAX limit
+   and return value */
+extern "C" int cordic_gref_ctx_batch(cordic_gref_ctx* ctx, const int i_num_msgs, const short int* i_msgs,
+                                     short int* o_msgs);
+
+#endif
@@ -5,16 +5,84 @@
 // Description: Constants header file for golden reference C++ implementation of CORDIC-UART 
 //
 
+#ifndef CORDIC_GREF_CONST_H
+#define CORDIC_GREF_CONST_H
+
 static const unsigned char POLY                = 0x9b;
 static const unsigned char BYTE_HEADER         = 0x5a;
 static const unsigned char CMD_SINGLE_TRANS    = 0xd1;
 static const unsigned char CMD_BURST_TRANS     = 0xd2;
+static const unsigned char CMD_STREAM_TRANS    = 0xd3;
+static const unsigned char CMD_VECTOR_TRANS    = 0xd4;
+static const unsigned char CMD_SELFTEST        = 0xd5;
 static const unsigned char CMD_DISABLE         = 0xe1;
 static const unsigned char CMD_ENABLE          = 0xe2;
 static const unsigned char CMD_ERR             = 0x01;
 
+// CMD_STREAM_TRANS mode byte: [1:0] result width, [2] round (else truncate), [4:3] theta width.
+// Widths are 16/24/32/48 bits, MSB-aligned to the 48-bit 4.44 theta and 2.46 cos/sin.
+static const unsigned char STREAM_WIDTH_16      = 0;
+static const unsigned char STREAM_WIDTH_24      = 1;
+static const unsigned char STREAM_WIDTH_32      = 2;
+static const unsigned char STREAM_WIDTH_48      = 3;
+static const unsigned char STREAM_MODE_ROUND    = 0x04;
+static const int STREAM_MODE_THETA_SHIFT        = 3;
+static const int STREAM_MAX_CNT                 = 65536;    // a count of 0 means 65536
+
+// CMD_SELFTEST request: header, cmd, seed (6 bytes), count (4 bytes, 0 means 2^32), crc. Response:
+// header, cmd, CRC-32 signature (4 bytes), cycles (6 bytes), crc. Angles come from a 48-bit Galois
+// LFSR (lfsr.sv) as the state halved; results are folded in as their 12 response bytes. Without
+// stalls the cycle count is ceil(count/lanes) + SELFTEST_LATENCY (less SEED_BITS in hybrid mode),
+// with top_module CORDIC_LANES lanes on i_clk.
+static const unsigned long long SELFTEST_LFSR_POLY  = 0x800000300001ULL;
+static const unsigned int       SELFTEST_CRC_POLY   = 0x04c11db7;
+static const long long          SELFTEST_MAX_CNT    = 1LL << 32;
+static const int                SELFTEST_LATENCY    = 50;       // 2 preprocess + 48 CORDIC stages
+static const int                SELFTEST_MSG_LEN    = 13;       // request and response
+
+// TX FIFO between uart_tx_msg and uart_tx (top_module TX_FIFO_DEPTH): the CORDIC pipelines hold
+// while fewer than TX_FIFO_MARGIN bytes are free, and up to TX_SKID_DEPTH message angles wait
+// (top_module SKID_DEPTH, see cordic_txfifo.h)
+static const int TX_FIFO_DEPTH          = 1024;
+static const int TX_FIFO_MARGIN         = 32;
+static const int TX_SKID_DEPTH          = 16;
+
+// Packed message layout used by cordic_gref_batch (one short int per UART packet). CMD_VECTOR_TRANS
+// carries x and y in the first 12 theta packets and answers magnitude in the first 6 cos packets,
+// atan2(y, x) in the first 6 sin packets.
+static const int GREF_BATCH_MAX         = 64;
+static const int GREF_IN_HEADER         = 0;
+static const int GREF_IN_CMD            = 1;
+static const int GREF_IN_BURST_CNT      = 2;
+static const int GREF_IN_THETA          = 3;
+static const int GREF_IN_CRC_8          = 51;
+static const int GREF_IN_MSG_LEN        = 52;
+static const int GREF_OUT_HEADER        = 0;
+static const int GREF_OUT_CMD           = 1;
+static const int GREF_OUT_BURST_CNT     = 2;
+static const int GREF_OUT_COS_THETA     = 3;
+static const int GREF_OUT_SIN_THETA     = 51;
+static const int GREF_OUT_CRC_8         = 99;
+static const int GREF_OUT_MSG_LEN       = 100;
+
+// cordic_gref_ctx statistics: requests by the response they got, and angles computed. Mirrored by
+// gref_stat_e in cordic_predictor.svh, which checks GREF_NUM_STATS at build_phase.
+enum cordic_gref_stat_t {
+    GREF_STAT_SINGLE,
+    GREF_STAT_BURST,
+    GREF_STAT_STREAM,
+    GREF_STAT_DISABLE,
+    GREF_STAT_ENABLE,
+    GREF_STAT_ERR,          // answered with CMD_ERR
+    GREF_STAT_SILENT,       // SINGLE/BURST/STREAM/VECTOR/SELFTEST while disabled, no response
+    GREF_STAT_ANGLES,
+    GREF_STAT_VECTOR,
+    GREF_STAT_SELFTEST,
+    GREF_NUM_STATS
+};
+
 // K
-static const long long K[48] = {
+static constexpr long long K[48] = {
     0x2d413cccfe78,
     0x287a26c49092,
     0x2744c374daf4,
@@ -67,7 +135,7 @@ static const long long K[48] = {
 
 // ARCTAN LUT
 
-static const long long ATAN[48] = {
+static constexpr long long ATAN[48] = {
     0x3243f6a8885a,
     0x1dac670561bb,
     0x0fadbafc9640,
@@ -125,4 +193,4 @@ static const long long PI 				= 0x3243f6a8885a;
 static const long long PI_MULT_3_DIV_2  = 0x4b65f1fccc87;
 static const long long PI_MULT_2 		= 0x6487ed5110b4;
 
-//
\ No newline at end of file
+#endif
@@ -0,0 +1,167 @@
+//
+// File:        cordic_gref_prof.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Profiling counters, section timers and convergence histogram of the reference
+//              model (see cordic_gref_prof.h). Timing uses the TSC on x86-64 and steady_clock
+//              nanoseconds elsewhere; the JSON "tick_unit" says which.
+//
+
+#include <stdio.h>
+
+#include "cordic_gref_prof.h"
+
+#ifdef CORDIC_GREF_PROFILE
+
+#include <atomic>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "cordic_gref_const.h"
+#include "cordic_gref.h"
+
+static const int   CONV_WIDTH_BITS[PROF_CONV_WIDTHS] = {16, 24, 32, 48};
+static const char* COUNTER_NAME[PROF_NUM_COUNTERS]   = {
+    "single", "burst", "stream", "vector", "selftest", "disable", "enable",
+    "header", "cmd", "burst_cnt", "theta", "crc", "stream_header", "stream_len",
+    "angles", "silent"
+};
+static const char* SECTION_NAME[PROF_NUM_SECTIONS]   = {"decode", "cordic", "encode"};
+
+static std::atomic<unsigned long long> g_counters[PROF_NUM_COUNTERS];
+static std::atomic<unsigned long long> g_section_calls[PROF_NUM_SECTIONS];
+static std::atomic<unsigned long long> g_section_ticks[PROF_NUM_SECTIONS];
+static std::atomic<unsigned long long> g_conv[PROF_CONV_WIDTHS][PROF_CONV_BINS];
+
+void gref_prof_count(gref_prof_counter_t c, unsigned long long n) {
+    g_counters[c].fetch_add(n, std::memory_order_relaxed);
+}
+
+unsigned long long gref_prof_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/* Adds the ticks since t to section s and restarts t */
+void gref_prof_section(gref_prof_section_t s, unsigned long long& t) {
+    unsigned long long now = gref_prof_ticks();
+    g_section_calls[s].fetch_add(1, std::memory_order_relaxed);
+    g_section_ticks[s].fetch_add(now - t, std::memory_order_relaxed);
+    t = now;
+}
+
+/* Stages of the pipeline (cordic_sincos() for seed_bits 0, else cordic_sincos_hybrid()) after which
+   x and y, truncated to each output width, no longer change. The seed ROM stands in for stages
+   0..seed_bits, so a hybrid result needs at least seed_bits + 1. The final negation of the folded
+   quadrants does not depend on the stage count and is left out. */
+static void convergence(long long theta, int seed_bits, int* stages) {
+    long long z, x, y;
+    bool sign;
+    cordic_fold(theta, &z, &sign);
+
+    int first = 0;
+    if (seed_bits) {
+        cordic_seed(seed_bits, &z, &x, &y);
+        first = seed_bits + 1;
+    } else {
+        x = K[47];
+        y = 0;
+    }
+    for (int w = 0; w < PROF_CONV_WIDTHS; w++)
+        stages[w] = first;
+    for (int i = first; i <= 47; i++) {
+        long long x0 = x, y0 = y;
+        cordic_stage(i, &x, &y, &z);
+        for (int w = 0; w < PROF_CONV_WIDTHS; w++) {
+            int drop = 48 - CONV_WIDTH_BITS[w];
+            if ((x >> drop) != (x0 >> drop) || (y >> drop) != (y0 >> drop))
+                stages[w] = i + 1;
+        }
+    }
+}
+
+/* Adds n angles of a seed_bits pipeline to the histogram of every output width */
+void gref_prof_convergence(const long long* theta, int n, int seed_bits) {
+    for (int k = 0; k < n; k++) {
+        int stages[PROF_CONV_WIDTHS];
+        convergence(theta[k], seed_bits, stages);
+        for (int w = 0; w < PROF_CONV_WIDTHS; w++)
+            g_conv[w][stages[w]].fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+extern "C" void cordic_gref_prof_reset() {
+    for (auto& c : g_counters)
+        c.store(0, std::memory_order_relaxed);
+    for (int s = 0; s < PROF_NUM_SECTIONS; s++) {
+        g_section_calls[s].store(0, std::memory_order_relaxed);
+        g_section_ticks[s].store(0, std::memory_order_relaxed);
+    }
+    for (auto& h : g_conv)
+        for (auto& b : h)
+            b.store(0, std::memory_order_relaxed);
+}
+
+extern "C" int cordic_gref_prof_dump(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (!f)
+        return 0;
+
+#if defined(__x86_64__) || defined(__i386__)
+    fprintf(f, "{\n  \"tick_unit\": \"tsc\",\n");
+#else
+    fprintf(f, "{\n  \"tick_unit\": \"ns\",\n");
+#endif
+
+    fprintf(f, "  \"commands\": {");
+    for (int c = PROF_CMD_SINGLE; c <= PROF_CMD_ENABLE; c++)
+        fprintf(f, "%s\"%s\": %llu", c == PROF_CMD_SINGLE ? "" : ", ", COUNTER_NAME[c], g_counters[c].load());
+    fprintf(f, "},\n  \"errors\": {");
+    for (int c = PROF_ERR_HEADER; c <= PROF_ERR_STREAM_LEN; c++)
+        fprintf(f, "%s\"%s\": %llu", c == PROF_ERR_HEADER ? "" : ", ", COUNTER_NAME[c], g_counters[c].load());
+    fprintf(f, "},\n  \"angles\": %llu,\n  \"silent\": %llu,\n",
+            g_counters[PROF_ANGLES].load(), g_counters[PROF_SILENT].load());
+
+    fprintf(f, "  \"sections\": {\n");
+    for (int s = 0; s < PROF_NUM_SECTIONS; s++) {
+        unsigned long long calls = g_section_calls[s].load(), ticks = g_section_ticks[s].load();
+        fprintf(f, "    \"%s\": {\"calls\": %llu, \"ticks\": %llu, \"ticks_per_call\": %.1f}%s\n",
+                SECTION_NAME[s], calls, ticks, calls ? (double)ticks / calls : 0.0,
+                s + 1 < PROF_NUM_SECTIONS ? "," : "");
+    }
+    fprintf(f, "  },\n");
+
+    /* Histogram: bin i counts the angles whose result is final after i stages */
+    fprintf(f, "  \"convergence\": {\n");
+    for (int w = 0; w < PROF_CONV_WIDTHS; w++) {
+        int max = 0;
+        fprintf(f, "    \"%d\": {\"hist\": [", CONV_WIDTH_BITS[w]);
+        for (int b = 0; b < PROF_CONV_BINS; b++) {
+            unsigned long long v = g_conv[w][b].load();
+            if (v)
+                max = b;
+            fprintf(f, "%s%llu", b ? ", " : "", v);
+        }
+        fprintf(f, "], \"max_stages\": %d}%s\n", max, w + 1 < PROF_CONV_WIDTHS ? "," : "");
+    }
+    fprintf(f, "  }\n}\n");
+    fclose(f);
+    return 1;
+}
+
+#else
+
+extern "C" void cordic_gref_prof_reset() {}
+
+extern "C" int cordic_gref_prof_dump(const char* path) {
+    (void)path;
+    return 0;
+}
+
+#endif
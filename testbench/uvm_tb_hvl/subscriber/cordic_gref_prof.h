@@ -0,0 +1,83 @@
+//
+// File:        cordic_gref_prof.h
+// Author:      agent
+// Date:        10/2026
+// Description: Optional profiling of the message-level reference model (gref_msg/gref_stream):
+//              per-command and per-error counters, cycle-counter timing of the decode, CORDIC and
+//              encode sections, and a per-angle histogram of the CORDIC stage after which the
+//              result stops changing at the output width.
+//
+//              Built only with -DCORDIC_GREF_PROFILE; otherwise every GREF_PROF_* macro expands
+//              to nothing and cordic_gref_prof_dump() just returns 0. Counters are relaxed atomics
+//              shared by all model instances, so cordic_gref_ctx users on several threads need no
+//              locking.
+//
+
+#ifndef CORDIC_GREF_PROF_H
+#define CORDIC_GREF_PROF_H
+
+enum gref_prof_counter_t {
+    PROF_CMD_SINGLE,
+    PROF_CMD_BURST,
+    PROF_CMD_STREAM,
+    PROF_CMD_VECTOR,
+    PROF_CMD_SELFTEST,
+    PROF_CMD_DISABLE,
+    PROF_CMD_ENABLE,
+    PROF_ERR_HEADER,            // header byte: framing or value
+    PROF_ERR_CMD,               // cmd byte: framing or unknown command
+    PROF_ERR_BURST_CNT,         // burst cnt byte: framing or outside 1..8
+    PROF_ERR_THETA,             // theta bytes (x/y, self-test seed and count): framing
+    PROF_ERR_CRC,               // crc byte: framing or CRC mismatch
+    PROF_ERR_STREAM_HEADER,     // stream message: framing, header or cmd
+    PROF_ERR_STREAM_LEN,        // stream message: length does not match the count, or CRC mismatch
+    PROF_ANGLES,                // angles through the CORDIC model (rotation mode, self-test included)
+    PROF_SILENT,                // valid SINGLE/BURST/STREAM/VECTOR/SELFTEST messages, disabled: no response
+    PROF_NUM_COUNTERS
+};
+
+enum gref_prof_section_t {
+    PROF_DECODE,                // packet checks, CRC and theta unpacking, error messages
+    PROF_CORDIC,                // cordic_gref_sincos(), cordic_vectoring()
+    PROF_ENCODE,                // response packets
+    PROF_NUM_SECTIONS
+};
+
+/* Histogram bins: 0..48 CORDIC stages, for each output width (16, 24, 32 and 48 bits) */
+static const int PROF_CONV_BINS   = 49;
+static const int PROF_CONV_WIDTHS = 4;
+
+/* Writes the profile as JSON to path. Returns 1 when written, 0 when profiling is compiled out
+   or the file cannot be opened. */
+extern "C" int cordic_gref_prof_dump(const char* path);
+
+/* Clears every counter, timer and histogram */
+extern "C" void cordic_gref_prof_reset();
+
+#ifdef CORDIC_GREF_PROFILE
+
+void               gref_prof_count(gref_prof_counter_t c, unsigned long long n);
+unsigned long long gref_prof_ticks();
+void               gref_prof_section(gref_prof_section_t s, unsigned long long& t);
+void               gref_prof_convergence(const long long* theta, int n, int seed_bits);
+
+#define GREF_PROF_COUNT(c, n)                   gref_prof_count(c, n)
+#define GREF_PROF_TIMER(t)                      unsigned long long t = gref_prof_ticks()
+#define GREF_PROF_RESTART(t)                    t = gref_prof_ticks()
+#define GREF_PROF_SECTION(s, t)                 gref_prof_section(s, t)
+#define GREF_PROF_CONVERGENCE(theta, n, sb)     gref_prof_convergence(theta, n, sb)
+
+#else
+
+#define GREF_PROF_COUNT(c, n)
+#define GREF_PROF_TIMER(t)
+#define GREF_PROF_RESTART(t)
+#define GREF_PROF_SECTION(s, t)
+#define GREF_PROF_CONVERGENCE(theta, n, sb)
+
+#endif
+
+/* Error branch: counts the error kind and closes the decode section */
+#define GREF_PROF_ERROR(c, t)   do { GREF_PROF_COUNT(c, 1); GREF_PROF_SECTION(PROF_DECODE, t); } while (0)
+
+#endif
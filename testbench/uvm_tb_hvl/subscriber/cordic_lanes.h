@@ -0,0 +1,63 @@
+//
+// File:        cordic_lanes.h
+// Author:      agent
+// Date:        10/2026
+// Description: Cycle model of cordic_lanes.sv with the lanes on i_clk (LANE_CLK_ASYNC = 0). It
+//              predicts the lane each theta goes to (round-robin from reset), the running cycle
+//              its result leaves, and the order the results are reassembled in, so a scoreboard
+//              can follow results through any number of lanes. Header only: the CMD_SELFTEST model
+//              in cordic_gref.cpp runs its angles through it for the signature order and the
+//              cycle count.
+//
+
+#ifndef CORDIC_LANES_H
+#define CORDIC_LANES_H
+
+#include <vector>
+
+static const int CORDIC_MAX_LANES = 8;
+
+struct cordic_lanes_result_t {
+    long long   tag;            // the caller's tag of the theta
+    int         lane;
+};
+
+class cordic_lanes_model {
+public:
+    /* latency: running cycles from a theta in to its result out (STAGES + 2, less SEED_BITS) */
+    cordic_lanes_model(int lanes, int latency)
+        : lanes_(lanes), latency_(latency), slots_(lanes, std::vector<long long>(latency, -1)) {}
+
+    /* Lane the next theta goes to */
+    int next_lane() const { return rr_in_; }
+
+    /* One running cycle: n thetas (0 to lanes, tags >= 0 in issue order) go in and the results
+       leaving this cycle are appended to out in reassembly order. Returns 0 if the done lanes are
+       not one rotation starting at the result pointer, which the RTL relies on. */
+    int cycle(int n, const long long* tags, std::vector<cordic_lanes_result_t>& out) {
+        int slot = (int)(t_ % latency_), done = 0, ok = 1;
+        for (int j = 0; j < lanes_; j++) {
+            int lane = (rr_out_ + j) % lanes_;
+            long long& tag = slots_[lane][slot];
+            if (tag < 0)
+                continue;
+            ok &= (j == done++);
+            out.push_back({ tag, lane });
+            tag = -1;
+        }
+        rr_out_ = (rr_out_ + done) % lanes_;
+        for (int j = 0; j < n; j++)
+            slots_[(rr_in_ + j) % lanes_][slot] = tags[j];
+        rr_in_ = (rr_in_ + n) % lanes_;
+        t_++;
+        return ok;
+    }
+
+private:
+    int                                 lanes_, latency_;
+    int                                 rr_in_ = 0, rr_out_ = 0;
+    long long                           t_ = 0;
+    std::vector<std::vector<long long>> slots_;     // [lane][cycle mod latency]: tag in flight, -1 none
+};
+
+#endif
@@ -0,0 +1,180 @@
+//
+// File:        cordic_sincos_param.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Runtime selection of the cordic_sincos<STAGES, BITS> instantiation matching the
+//              DUT parameters, and the DPI wrapper the testbench calls.
+//
+
+#ifndef CORDIC_GREF_STANDALONE
+#include "svdpi.h"
+#endif
+#include "cordic_sincos_param.h"
+#include "cordic_gref.h"
+
+using namespace cordic_param;
+
+typedef void (*cordic_sincos_fn)(long long theta, long long* x, long long* y);
+typedef void (*cordic_sincos_capture_fn)(long long theta, long long* x, long long* y,
+                                         cordic_stage_capture_t* cap);
+
+struct cordic_param_entry {
+    int stages;
+    int bits;
+    cordic_sincos_fn fn;
+    cordic_sincos_capture_fn capture_fn;
+};
+
+/* Configurations with an unrolled instantiation. Anything else falls back to the loop below. */
+#define CORDIC_PARAM_ENTRY(S, B) { S, B, &cordic_sincos<S, B>, &cordic_sincos<S, B> },
+#define CORDIC_PARAM_BITS(S) \
+    CORDIC_PARAM_ENTRY(S, 16) CORDIC_PARAM_ENTRY(S, 24) CORDIC_PARAM_ENTRY(S, 32) \
+    CORDIC_PARAM_ENTRY(S, 40) CORDIC_PARAM_ENTRY(S, 48)
+
+static const cordic_param_entry CORDIC_PARAM_TABLE[] = {
+    CORDIC_PARAM_BITS(16)
+    CORDIC_PARAM_BITS(24)
+    CORDIC_PARAM_BITS(32)
+    CORDIC_PARAM_BITS(40)
+    CORDIC_PARAM_BITS(48)
+};
+
+#undef CORDIC_PARAM_BITS
+#undef CORDIC_PARAM_ENTRY
+
+/* cordic_sincos_preprocess: fold theta into [-pi/2, pi/2] and scale it to 2 integer bits */
+static long long preprocess_loop(int bits, long long theta, bool* sign_out) {
+    long long t = trunc_bits(theta, bits);
+
+    long long z;
+    bool sign;
+    if (t > scale_const(PI_MULT_3_DIV_2, bits)) {
+        z = t - scale_const(PI_MULT_2, bits);   sign = 0;
+    } else if (t > scale_const(PI_DIV_2, bits)) {
+        z = t - scale_const(PI, bits);          sign = 1;
+    } else if (t < trunc_bits(-scale_const(PI_MULT_3_DIV_2, bits), bits)) {
+        z = t + scale_const(PI_MULT_2, bits);   sign = 0;
+    } else if (t < trunc_bits(-scale_const(PI_DIV_2, bits), bits)) {
+        z = t + scale_const(PI, bits);          sign = 1;
+    } else {
+        z = t;                                  sign = 0;
+    }
+    (*sign_out) = sign;
+    return trunc_bits(trunc_bits(z, bits) << 2, bits);
+}
+
+/* cordic_sincos_stage #(.STAGE(first)) through #(.STAGE(stages-1)), including the sign correction */
+static void stages_loop(int stages, int bits, int first, long long z, bool sign, long long cx, long long cy,
+                        long long* x, long long* y, cordic_stage_capture_t* cap) {
+    long long dx, dy, dz;
+    for (int i = first; i < stages; i++) {
+        int shift = (i < 63) ? i : 63;
+        if (z < 0) {
+            dx = cy >> shift;
+            dy = trunc_bits(-cx, bits) >> shift;
+            dz = scale_const(ATAN[i], bits);
+        } else {
+            dx = trunc_bits(-cy, bits) >> shift;
+            dy = cx >> shift;
+            dz = scale_const(-ATAN[i], bits);
+        }
+        cx = trunc_bits(cx + dx, bits);
+        cy = trunc_bits(cy + dy, bits);
+        if (cap)
+            stage_capture{*cap}.stage(i, cx, cy, trunc_bits(z + dz, bits), z < 0);
+        z  = trunc_bits(z + dz, bits);
+    }
+
+    if (sign) {
+        cx = trunc_bits(-cx, bits);
+        cy = trunc_bits(-cy, bits);
+        if (cap)
+            stage_capture{*cap}.sign_corrected(stages-1, cx, cy);
+    }
+    (*x) = cx;
+    (*y) = cy;
+}
+
+/* Generic model, one stage per loop iteration, every constant derived on the fly. cap may be NULL. */
+static void cordic_sincos_loop(int stages, int bits, long long theta, long long* x, long long* y,
+                               cordic_stage_capture_t* cap) {
+    bool sign;
+    long long z = preprocess_loop(bits, theta, &sign);
+    stages_loop(stages, bits, 0, z, sign, scale_const(K[stages-1], bits), 0, x, y, cap);
+}
+
+void cordic_sincos_hybrid_rt(int stages, int bits, int seed_bits, long long theta, long long* x, long long* y,
+                             cordic_stage_capture_t* cap) {
+    bool sign;
+    long long z = preprocess_loop(bits, theta, &sign);
+
+    // cordic_sincos_seed: round to the ROM grid, look up |idx|, keep the remainder
+    int shift = bits - 2 - seed_bits;
+    long long idx = trunc_bits(z + (1LL << (shift - 1)), bits) >> shift;
+    z = trunc_bits(z - idx * (1LL << shift), bits);
+    long long cos_seed, sin_seed;
+    cordic_seed_rom_entry(stages, seed_bits, (int)(idx < 0 ? -idx : idx), &cos_seed, &sin_seed);
+    long long cx = scale_const(cos_seed, bits);
+    long long cy = scale_const(sin_seed, bits);
+    if (idx < 0)
+        cy = trunc_bits(-cy, bits);
+
+    stages_loop(stages, bits, seed_bits + 1, z, sign, cx, cy, x, y, cap);
+}
+
+void cordic_sincos_rt(int stages, int bits, long long theta, long long* x, long long* y) {
+    for (const cordic_param_entry& e : CORDIC_PARAM_TABLE) {
+        if (e.stages == stages && e.bits == bits) {
+            e.fn(theta, x, y);
+            return;
+        }
+    }
+    cordic_sincos_loop(stages, bits, theta, x, y, NULL);
+}
+
+void cordic_sincos_rt(int stages, int bits, long long theta, long long* x, long long* y,
+                      cordic_stage_capture_t* cap) {
+    for (const cordic_param_entry& e : CORDIC_PARAM_TABLE) {
+        if (e.stages == stages && e.bits == bits) {
+            e.capture_fn(theta, x, y, cap);
+            return;
+        }
+    }
+    cordic_sincos_loop(stages, bits, theta, x, y, cap);
+}
+
+/* DPI entry point. i_theta is the BITS wide DUT input (4 integer bits) sign extended to 64 bits;
+   the results come back BITS wide (2 integer bits), sign extended. Returns 0 for parameters the
+   RTL does not support. */
+extern "C" int cordic_sincos_param(const int i_stages, const int i_bits, const long long i_theta,
+                                   long long* o_cos_theta, long long* o_sin_theta) {
+    if (i_stages < 1 || i_stages > MAX_STAGES || i_bits < 4 || i_bits > MAX_D_WIDTH)
+        return 0;
+    cordic_sincos_rt(i_stages, i_bits, i_theta, o_cos_theta, o_sin_theta);
+    return 1;
+}
+
+/* DPI entry point with per-stage capture. Entry i of o_stage_* holds the outputs of
+   cordic_sincos_stage #(.STAGE(i)) and o_stage_dir[i] its rotation direction (+1/-1); entries
+   from i_stages on are left untouched. */
+extern "C" int cordic_sincos_param_capture(const int i_stages, const int i_bits, const long long i_theta,
+                                           long long* o_cos_theta, long long* o_sin_theta,
+                                           long long* o_stage_cos, long long* o_stage_sin,
+                                           long long* o_stage_theta, signed char* o_stage_dir) {
+    if (i_stages < 1 || i_stages > MAX_STAGES || i_bits < 4 || i_bits > MAX_D_WIDTH)
+        return 0;
+    cordic_stage_capture_t cap = { o_stage_cos, o_stage_sin, o_stage_theta, o_stage_dir, 1 };
+    cordic_sincos_rt(i_stages, i_bits, i_theta, o_cos_theta, o_sin_theta, &cap);
+    return 1;
+}
+
+/* DPI entry point for the hybrid mode, cordic_sincos #(.STAGES, .BITS, .SEED_BITS(i_seed_bits)).
+   Returns 0 for parameters the RTL does not support. */
+extern "C" int cordic_sincos_param_hybrid(const int i_stages, const int i_bits, const int i_seed_bits,
+                                          const long long i_theta, long long* o_cos_theta, long long* o_sin_theta) {
+    if (i_stages < 1 || i_stages > MAX_STAGES || i_bits < 4 || i_bits > MAX_D_WIDTH
+        || i_seed_bits < 1 || i_seed_bits + 1 >= i_stages || i_bits - 2 - i_seed_bits < 1)
+        return 0;
+    cordic_sincos_hybrid_rt(i_stages, i_bits, i_seed_bits, i_theta, o_cos_theta, o_sin_theta, NULL);
+    return 1;
+}
@@ -0,0 +1,212 @@
+//
+// File:        cordic_sincos_param.h
+// Author:      agent
+// Date:        10/2026
+// Description: Compile-time parameterized model of cordic_sincos #(STAGES, BITS). Every constant
+//              the RTL derives from pkg_cordic_sincos (round(X, BITS) >>> (MAX_D_WIDTH - BITS)) is
+//              generated at compile time, the iterations are fully unrolled, and datapaths of 32
+//              bits or less are held in 32-bit words. STAGES in [1,48] and BITS in [4,48] compile;
+//              only cordic_sincos<48, 48> (the top_module configuration) is checked bit-exact,
+//              against cordic_sincos() in cordic_gref.cpp. Other pairs follow the RTL equations but
+//              have not been compared with a simulation of cordic_sincos at those parameters.
+//
+
+#ifndef CORDIC_SINCOS_PARAM_H
+#define CORDIC_SINCOS_PARAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+#include "cordic_gref_const.h"
+
+/* Per-stage capture buffers, structure of arrays. Entry i*stride holds the registered outputs of
+   cordic_sincos_stage #(.STAGE(i)) (o_cos, o_sin, o_theta, sign extended; the last stage includes
+   the preprocess sign correction as in the RTL) and the rotation direction the stage took: +1
+   when its i_theta was non-negative, -1 when it was negative. Each buffer needs
+   (STAGES-1)*stride+1 entries. A stride of N with the pointers offset by n captures angle n of a
+   batch of N. */
+struct cordic_stage_capture_t {
+    long long*      x;
+    long long*      y;
+    long long*      z;
+    signed char*    dir;
+    size_t          stride;
+};
+
+namespace cordic_param {
+
+/* Capture policies for cordic_sincos_impl::run(). The default records nothing and compiles away. */
+struct no_capture {
+    static inline void stage(int, long long, long long, long long, bool) {}
+    static inline void sign_corrected(int, long long, long long) {}
+};
+
+struct stage_capture {
+    cordic_stage_capture_t& cap;
+    inline void stage(int i, long long x, long long y, long long z, bool neg) {
+        size_t k = i * cap.stride;
+        cap.x[k]    = x;
+        cap.y[k]    = y;
+        cap.z[k]    = z;
+        cap.dir[k]  = neg ? -1 : 1;
+    }
+    inline void sign_corrected(int i, long long x, long long y) {
+        cap.x[i * cap.stride] = x;
+        cap.y[i * cap.stride] = y;
+    }
+};
+
+static constexpr int MAX_STAGES  = 48;
+static constexpr int MAX_D_WIDTH = 48;
+
+/* Keep the low n bits of v, sign extended (assignment to a logic signed [n-1:0]) */
+constexpr long long trunc_bits(long long v, int n) {
+    return (long long)((unsigned long long)v << (64 - n)) >> (64 - n);
+}
+
+/* pkg_cordic_sincos::round() */
+constexpr long long round_hdl(long long v, int bits) {
+    return bits >= MAX_D_WIDTH ? v : trunc_bits(v + (1LL << (MAX_D_WIDTH - bits - 1)), MAX_D_WIDTH);
+}
+
+/* round(v, BITS) >>> (MAX_D_WIDTH - BITS), assigned to a BITS wide signal */
+constexpr long long scale_const(long long v, int bits) {
+    return trunc_bits(round_hdl(v, bits) >> (MAX_D_WIDTH - bits), bits);
+}
+
+/* Constants of one cordic_sincos instance */
+template <int STAGES>
+struct cordic_tables_t {
+    long long atan_p[STAGES];     // delta_theta when theta is negative
+    long long atan_n[STAGES];     // delta_theta when theta is non-negative
+    long long k;                  // preprocess o_cos
+    long long pi_div_2, pi, pi_mult_3_div_2, pi_mult_2;
+};
+
+template <int STAGES>
+constexpr cordic_tables_t<STAGES> make_tables(int bits) {
+    cordic_tables_t<STAGES> tables = {};
+    for (int i = 0; i < STAGES; i++) {
+        tables.atan_p[i] = scale_const( ATAN[i], bits);
+        tables.atan_n[i] = scale_const(-ATAN[i], bits);
+    }
+    tables.k               = scale_const(K[STAGES-1], bits);
+    tables.pi_div_2        = scale_const(PI_DIV_2, bits);
+    tables.pi              = scale_const(PI, bits);
+    tables.pi_mult_3_div_2 = scale_const(PI_MULT_3_DIV_2, bits);
+    tables.pi_mult_2       = scale_const(PI_MULT_2, bits);
+    return tables;
+}
+
+template <int STAGES, int BITS>
+struct cordic_sincos_impl {
+    static_assert(STAGES >= 1 && STAGES <= MAX_STAGES, "STAGES must be in [1,48]");
+    static_assert(BITS >= 4 && BITS <= MAX_D_WIDTH, "BITS must be in [4,48]");
+
+    typedef typename std::conditional<(BITS <= 32), int32_t, int64_t>::type word_t;
+    typedef typename std::make_unsigned<word_t>::type uword_t;
+
+    static constexpr int WORD_BITS = 8 * sizeof(word_t);
+    static constexpr cordic_tables_t<STAGES> TABLES = make_tables<STAGES>(BITS);
+
+    /* Wrap a word_t result to BITS bits. Arithmetic goes through uword_t so it wraps instead of
+       overflowing, as the RTL does. */
+    static inline word_t wrap(uword_t v) {
+        return (word_t)(uword_t)(v << (WORD_BITS - BITS)) >> (WORD_BITS - BITS);
+    }
+
+    /* >>> STAGE; any shift of BITS-1 or more leaves only copies of the sign bit */
+    static inline word_t sra(word_t v, int shift) {
+        return v >> (shift < WORD_BITS - 1 ? shift : WORD_BITS - 1);
+    }
+
+    /* cordic_sincos_stage #(.STAGE(I)) */
+    template <int I, class Capture>
+    static inline void iterate(word_t& x, word_t& y, word_t& z, Capture& cap, std::integral_constant<int, I>) {
+        word_t dx, dy, dz;
+        bool neg = z < 0;
+        if (neg) {
+            dx = sra(y, I);
+            dy = sra(wrap(-(uword_t)x), I);
+            dz = (word_t)TABLES.atan_p[I];
+        } else {
+            dx = sra(wrap(-(uword_t)y), I);
+            dy = sra(x, I);
+            dz = (word_t)TABLES.atan_n[I];
+        }
+        x = wrap((uword_t)x + (uword_t)dx);
+        y = wrap((uword_t)y + (uword_t)dy);
+        z = wrap((uword_t)z + (uword_t)dz);
+        cap.stage(I, x, y, z, neg);
+        iterate(x, y, z, cap, std::integral_constant<int, I+1>());
+    }
+
+    template <class Capture>
+    static inline void iterate(word_t&, word_t&, word_t&, Capture&, std::integral_constant<int, STAGES>) {}
+
+    /* theta is BITS wide with 4 integer bits, cos/sin are BITS wide with 2 integer bits */
+    template <class Capture>
+    static inline void run(long long theta, long long* x, long long* y, Capture cap) {
+        word_t t = (word_t)trunc_bits(theta, BITS);
+
+        // cordic_sincos_preprocess, stage 2
+        word_t z;
+        bool sign;
+        if (t > (word_t)TABLES.pi_mult_3_div_2) {
+            z = wrap((uword_t)t - (uword_t)TABLES.pi_mult_2);   sign = 0;
+        } else if (t > (word_t)TABLES.pi_div_2) {
+            z = wrap((uword_t)t - (uword_t)TABLES.pi);          sign = 1;
+        } else if (t < (word_t)trunc_bits(-TABLES.pi_mult_3_div_2, BITS)) {
+            z = wrap((uword_t)t + (uword_t)TABLES.pi_mult_2);   sign = 0;
+        } else if (t < (word_t)trunc_bits(-TABLES.pi_div_2, BITS)) {
+            z = wrap((uword_t)t + (uword_t)TABLES.pi);          sign = 1;
+        } else {
+            z = t;                                              sign = 0;
+        }
+        z = wrap((uword_t)z << 2);
+
+        word_t cx = (word_t)TABLES.k;
+        word_t cy = 0;
+        iterate(cx, cy, z, cap, std::integral_constant<int, 0>());
+
+        if (sign) {
+            cx = wrap(-(uword_t)cx);
+            cy = wrap(-(uword_t)cy);
+            cap.sign_corrected(STAGES-1, cx, cy);
+        }
+        (*x) = cx;
+        (*y) = cy;
+    }
+};
+
+template <int STAGES, int BITS>
+constexpr cordic_tables_t<STAGES> cordic_sincos_impl<STAGES, BITS>::TABLES;
+
+} // namespace cordic_param
+
+/* CORDIC model of cordic_sincos #(.STAGES(STAGES), .BITS(BITS)), one angle */
+template <int STAGES, int BITS>
+inline void cordic_sincos(long long theta, long long* x, long long* y) {
+    cordic_param::cordic_sincos_impl<STAGES, BITS>::run(theta, x, y, cordic_param::no_capture());
+}
+
+/* Same, also writing every stage's outputs into cap */
+template <int STAGES, int BITS>
+inline void cordic_sincos(long long theta, long long* x, long long* y, cordic_stage_capture_t* cap) {
+    cordic_param::cordic_sincos_impl<STAGES, BITS>::run(theta, x, y, cordic_param::stage_capture{*cap});
+}
+
+/* Same model with STAGES and BITS known only at runtime. Dispatches to a compiled instantiation
+   when one exists for the pair, otherwise runs the iterations in a loop. The second form also
+   captures every stage into cap. */
+void cordic_sincos_rt(int stages, int bits, long long theta, long long* x, long long* y);
+void cordic_sincos_rt(int stages, int bits, long long theta, long long* x, long long* y,
+                      cordic_stage_capture_t* cap);
+
+/* Hybrid mode, cordic_sincos #(.STAGES(stages), .BITS(bits), .SEED_BITS(seed_bits)): the seed ROM
+   replaces stages 0..seed_bits and the loop runs the rest. cap (may be NULL) receives only the
+   stages that exist. */
+void cordic_sincos_hybrid_rt(int stages, int bits, int seed_bits, long long theta, long long* x, long long* y,
+                             cordic_stage_capture_t* cap);
+
+#endif
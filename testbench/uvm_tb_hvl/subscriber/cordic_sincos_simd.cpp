@@ -0,0 +1,139 @@
+//
+// File:        cordic_sincos_simd.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Vectorized CORDIC model for bursts. All lanes of a burst step through the
+//              48 iterations together, and the data-dependent rotation direction (z < 0)
+//              becomes a per-lane blend. AVX-512 holds all 8 lanes in one register, AVX2
+//              uses two. The kernels are compiled with target attributes and selected at
+//              runtime, so no special compiler flags are needed.
+//
+
+#ifndef CORDIC_GREF_STANDALONE
+#include "svdpi.h"
+#endif
+#include <string.h>
+
+#include "cordic_gref_const.h"
+#include "cordic_gref.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CORDIC_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+void cordic_sincos_burst_scalar(const long long* theta, long long* x, long long* y, int n) {
+    for (int i = 0; i < n; i++) {
+        long long t = theta[i];
+        cordic_sincos(&t, x + i, y + i);
+    }
+}
+
+#ifdef CORDIC_SIMD_X86
+
+/* Arithmetic right shift of 64-bit lanes; AVX2 only has the logical shift */
+__attribute__((target("avx2")))
+static inline __m256i sra_epi64_avx2(__m256i v, __m128i cnt) {
+    __m256i m = _mm256_cmpgt_epi64(_mm256_setzero_si256(), v);
+    return _mm256_xor_si256(_mm256_srl_epi64(_mm256_xor_si256(v, m), cnt), m);
+}
+
+__attribute__((target("avx2")))
+void cordic_sincos_burst_avx2(const long long* theta, long long* x, long long* y, int n) {
+    alignas(32) long long z_in[8] = {0}, x_out[8], y_out[8];
+    bool sign[8] = {0};
+    for (int i = 0; i < n; i++)
+        cordic_fold(theta[i], z_in + i, sign + i);
+
+    const __m256i zero = _mm256_setzero_si256();
+    for (int h = 0; h < 8; h += 4) {
+        __m256i vx = _mm256_set1_epi64x(K[47]);
+        __m256i vy = zero;
+        __m256i vz = _mm256_load_si256((const __m256i*)(z_in + h));
+        for (int i = 0; i <= 47; i++) {
+            __m128i cnt = _mm_cvtsi32_si128(i);
+            __m256i zneg = _mm256_cmpgt_epi64(zero, vz);
+            __m256i sel_y = _mm256_blendv_epi8(_mm256_sub_epi64(zero, vy), vy, zneg);
+            __m256i sel_x = _mm256_blendv_epi8(vx, _mm256_sub_epi64(zero, vx), zneg);
+            __m256i atan  = _mm256_set1_epi64x(ATAN[i]);
+            __m256i dz    = _mm256_blendv_epi8(_mm256_sub_epi64(zero, atan), atan, zneg);
+            vx = _mm256_add_epi64(vx, sra_epi64_avx2(sel_y, cnt));
+            vy = _mm256_add_epi64(vy, sra_epi64_avx2(sel_x, cnt));
+            vz = _mm256_add_epi64(vz, dz);
+        }
+        _mm256_store_si256((__m256i*)(x_out + h), vx);
+        _mm256_store_si256((__m256i*)(y_out + h), vy);
+    }
+
+    for (int i = 0; i < n; i++) {
+        x[i] = sign[i] ? -x_out[i] : x_out[i];
+        y[i] = sign[i] ? -y_out[i] : y_out[i];
+    }
+}
+
+__attribute__((target("avx512f")))
+void cordic_sincos_burst_avx512(const long long* theta, long long* x, long long* y, int n) {
+    alignas(64) long long z_in[8] = {0}, x_out[8], y_out[8];
+    bool sign[8] = {0};
+    for (int i = 0; i < n; i++)
+        cordic_fold(theta[i], z_in + i, sign + i);
+
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i vx = _mm512_set1_epi64(K[47]);
+    __m512i vy = zero;
+    __m512i vz = _mm512_load_si512(z_in);
+    for (int i = 0; i <= 47; i++) {
+        // Zero-masked with every lane selected: the unmasked shifts pass _mm512_undefined_epi32()
+        // through, which GCC 12 flags with -Wuninitialized
+        __m512i cnt = _mm512_set1_epi64(i);
+        __mmask8 zneg = _mm512_cmplt_epi64_mask(vz, zero);
+        __m512i sel_y = _mm512_mask_blend_epi64(zneg, _mm512_sub_epi64(zero, vy), vy);
+        __m512i sel_x = _mm512_mask_blend_epi64(zneg, vx, _mm512_sub_epi64(zero, vx));
+        __m512i atan  = _mm512_set1_epi64(ATAN[i]);
+        __m512i dz    = _mm512_mask_blend_epi64(zneg, _mm512_sub_epi64(zero, atan), atan);
+        vx = _mm512_add_epi64(vx, _mm512_maskz_srav_epi64(0xff, sel_y, cnt));
+        vy = _mm512_add_epi64(vy, _mm512_maskz_srav_epi64(0xff, sel_x, cnt));
+        vz = _mm512_add_epi64(vz, dz);
+    }
+    _mm512_store_si512(x_out, vx);
+    _mm512_store_si512(y_out, vy);
+
+    for (int i = 0; i < n; i++) {
+        x[i] = sign[i] ? -x_out[i] : x_out[i];
+        y[i] = sign[i] ? -y_out[i] : y_out[i];
+    }
+}
+
+#else
+
+void cordic_sincos_burst_avx2(const long long* theta, long long* x, long long* y, int n) {
+    cordic_sincos_burst_scalar(theta, x, y, n);
+}
+
+void cordic_sincos_burst_avx512(const long long* theta, long long* x, long long* y, int n) {
+    cordic_sincos_burst_scalar(theta, x, y, n);
+}
+
+#endif
+
+/* Runtime dispatch, resolved on first call */
+typedef void (*burst_kernel_t)(const long long*, long long*, long long*, int);
+
+static burst_kernel_t select_burst_kernel() {
+#ifdef CORDIC_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return cordic_sincos_burst_avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return cordic_sincos_burst_avx2;
+#endif
+    return cordic_sincos_burst_scalar;
+}
+
+void cordic_sincos_burst(const long long* theta, long long* x, long long* y, int n) {
+    static const burst_kernel_t kernel = select_burst_kernel();
+    if (n <= 1)
+        cordic_sincos_burst_scalar(theta, x, y, n);
+    else
+        kernel(theta, x, y, n);
+}
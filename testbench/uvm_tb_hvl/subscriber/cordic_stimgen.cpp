@@ -0,0 +1,238 @@
+//
+// File:        cordic_stimgen.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Coverage-directed stimulus generator (see cordic_stimgen.h)
+//
+
+#ifndef CORDIC_GREF_STANDALONE
+#include "svdpi.h"
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <random>
+
+#include "cordic_gref_const.h"
+#include "cordic_gref.h"
+#include "cordic_stimgen.h"
+
+enum bin_kind_t {
+    BIN_THETA,
+    BIN_BURST_CNT,
+    BIN_CORRUPT
+};
+
+struct bin_t {
+    const char* name;
+    bin_kind_t  kind;
+    long long   lo;             // inclusive range, or the STIMGEN_CORRUPT_* kind
+    long long   hi;
+    int         weight;
+};
+
+static const long long NEAR     = 256;              // LSBs either side of a fold boundary
+static const long long TINY     = 1LL << 20;        // |theta| below 2^-24 rad
+static const long long BIT_46   = 1LL << 46;
+
+/* Thetas are 4.44 and 48 bits wide; PI_MULT_2 < 2^47, so bit 46 set (or clear, when negative)
+   marks the magnitudes whose sign extension from bit 47 is least trivial */
+static const bin_t BINS[] = {
+    { "zero",               BIN_THETA,  0,                          0,                          4 },
+    { "pi_div_2",           BIN_THETA,  PI_DIV_2,                   PI_DIV_2,                   4 },
+    { "neg_pi_div_2",       BIN_THETA,  -PI_DIV_2,                  -PI_DIV_2,                  4 },
+    { "pi",                 BIN_THETA,  PI,                         PI,                         4 },
+    { "neg_pi",             BIN_THETA,  -PI,                        -PI,                        4 },
+    { "pi_mult_3_div_2",    BIN_THETA,  PI_MULT_3_DIV_2,            PI_MULT_3_DIV_2,            4 },
+    { "neg_pi_mult_3_div_2",BIN_THETA,  -PI_MULT_3_DIV_2,           -PI_MULT_3_DIV_2,           4 },
+    { "pi_mult_2",          BIN_THETA,  PI_MULT_2,                  PI_MULT_2,                  4 },
+    { "neg_pi_mult_2",      BIN_THETA,  -PI_MULT_2,                 -PI_MULT_2,                 4 },
+    { "near_pi_div_2",      BIN_THETA,  PI_DIV_2 - NEAR,            PI_DIV_2 + NEAR,            4 },
+    { "near_neg_pi_div_2",  BIN_THETA,  -PI_DIV_2 - NEAR,           -PI_DIV_2 + NEAR,           4 },
+    { "near_pi",            BIN_THETA,  PI - NEAR,                  PI + NEAR,                  4 },
+    { "near_neg_pi",        BIN_THETA,  -PI - NEAR,                 -PI + NEAR,                 4 },
+    { "near_pi_mult_3_div_2",     BIN_THETA, PI_MULT_3_DIV_2 - NEAR,  PI_MULT_3_DIV_2 + NEAR,   4 },
+    { "near_neg_pi_mult_3_div_2", BIN_THETA, -PI_MULT_3_DIV_2 - NEAR, -PI_MULT_3_DIV_2 + NEAR,  4 },
+    { "near_pi_mult_2",     BIN_THETA,  PI_MULT_2 - NEAR,           PI_MULT_2 - 1,              4 },
+    { "near_neg_pi_mult_2", BIN_THETA,  -PI_MULT_2 + 1,             -PI_MULT_2 + NEAR,          4 },
+    { "tiny_pos",           BIN_THETA,  1,                          TINY,                       4 },
+    { "tiny_neg",           BIN_THETA,  -TINY,                      -1,                         4 },
+    { "plus_one",           BIN_THETA,  1,                          1,                          2 },
+    { "minus_one",          BIN_THETA,  -1,                         -1,                         2 },
+    { "bit46_set",          BIN_THETA,  BIT_46,                     PI_MULT_2,                  4 },
+    { "neg_bit46_clear",    BIN_THETA,  -PI_MULT_2,                 -BIT_46 - 1,                4 },
+    // cordic_coverage THETA_n ranges
+    { "range_3pi2_to_2pi",  BIN_THETA,  PI_MULT_3_DIV_2,            PI_MULT_2 - 1,              16 },
+    { "range_pi_to_3pi2",   BIN_THETA,  PI,                         PI_MULT_3_DIV_2 - 1,        16 },
+    { "range_pi2_to_pi",    BIN_THETA,  PI_DIV_2,                   PI - 1,                     16 },
+    { "range_0_to_pi2",     BIN_THETA,  0,                          PI_DIV_2 - 1,               16 },
+    { "range_npi2_to_0",    BIN_THETA,  -PI_DIV_2,                  -1,                         16 },
+    { "range_n3pi2_to_npi2",BIN_THETA,  -PI_MULT_3_DIV_2,           -PI_DIV_2 - 1,              16 },
+    { "range_n2pi_to_n3pi2",BIN_THETA,  -PI_MULT_2 + 1,             -PI_MULT_3_DIV_2 - 1,       16 },
+    // cordic_coverage BURST_CNT
+    { "burst_cnt_one",      BIN_BURST_CNT, 1,                       1,                          1 },
+    { "burst_cnt_2_to_7",   BIN_BURST_CNT, 2,                       7,                          2 },
+    { "burst_cnt_max",      BIN_BURST_CNT, 8,                       8,                          1 },
+    { "corrupt_crc",        BIN_CORRUPT, STIMGEN_CORRUPT_CRC,       STIMGEN_CORRUPT_CRC,        1 },
+    { "corrupt_parity",     BIN_CORRUPT, STIMGEN_CORRUPT_PARITY,    STIMGEN_CORRUPT_PARITY,     1 },
+    { "corrupt_stop",       BIN_CORRUPT, STIMGEN_CORRUPT_STOP,      STIMGEN_CORRUPT_STOP,       1 },
+};
+static const int NUM_BINS = sizeof(BINS) / sizeof(BINS[0]);
+
+struct cordic_stimgen_t {
+    std::mt19937_64     rng;
+    int                 corrupt_pct[4];     // by STIMGEN_CORRUPT_* kind
+    long long           hits[NUM_BINS];
+};
+
+extern "C" cordic_stimgen_t* cordic_stimgen_create(const long long i_seed) {
+    cordic_stimgen_t* g = new cordic_stimgen_t();
+    g->rng.seed((unsigned long long)i_seed);
+    return g;
+}
+
+extern "C" void cordic_stimgen_destroy(cordic_stimgen_t* g) {
+    delete g;
+}
+
+extern "C" void cordic_stimgen_corrupt(cordic_stimgen_t* g, const int i_crc_pct, const int i_parity_pct,
+                                       const int i_stop_pct) {
+    g->corrupt_pct[STIMGEN_CORRUPT_CRC]     = i_crc_pct;
+    g->corrupt_pct[STIMGEN_CORRUPT_PARITY]  = i_parity_pct;
+    g->corrupt_pct[STIMGEN_CORRUPT_STOP]    = i_stop_pct;
+}
+
+int cordic_stimgen_theta_bin(long long theta, int first) {
+    for (int b = first; b < NUM_BINS; b++)
+        if (BINS[b].kind == BIN_THETA && theta >= BINS[b].lo && theta <= BINS[b].hi)
+            return b;
+    return -1;
+}
+
+/* Picks a bin of the given kind, each with weight / (1 + hits) */
+static int pick_bin(cordic_stimgen_t* g, bin_kind_t kind) {
+    double total = 0, w[NUM_BINS];
+    for (int b = 0; b < NUM_BINS; b++) {
+        w[b] = (BINS[b].kind == kind) ? BINS[b].weight / (1.0 + g->hits[b]) : 0;
+        total += w[b];
+    }
+    double r = std::uniform_real_distribution<double>(0, total)(g->rng);
+    int last = -1;
+    for (int b = 0; b < NUM_BINS; b++) {
+        if (w[b] == 0)
+            continue;
+        last = b;
+        if (r < w[b])
+            return b;
+        r -= w[b];
+    }
+    return last;
+}
+
+static long long draw(cordic_stimgen_t* g, int bin) {
+    return std::uniform_int_distribution<long long>(BINS[bin].lo, BINS[bin].hi)(g->rng);
+}
+
+extern "C" int cordic_stimgen_next(cordic_stimgen_t* g, const int i_cmd, short int* o_msg) {
+    unsigned char crc_8 = 0, cmd = (unsigned char)i_cmd;
+    int cnt = 0;
+    memset(o_msg, 0, sizeof(short int)*GREF_IN_MSG_LEN);
+
+    set_packet(o_msg + GREF_IN_HEADER, BYTE_HEADER);
+    crc_8_calc(&crc_8, BYTE_HEADER);
+    set_packet(o_msg + GREF_IN_CMD, cmd);
+    crc_8_calc(&crc_8, cmd);
+    if (cmd == CMD_SINGLE_TRANS)
+        cnt = 1;
+    if (cmd == CMD_BURST_TRANS) {
+        int b = pick_bin(g, BIN_BURST_CNT);
+        cnt = (int)draw(g, b);
+        g->hits[b]++;
+        set_packet(o_msg + GREF_IN_BURST_CNT, (unsigned char)cnt);
+        crc_8_calc(&crc_8, (unsigned char)cnt);
+    }
+    for (int j = 0; j < cnt; j++) {
+        long long theta = draw(g, pick_bin(g, BIN_THETA));
+        for (int b = cordic_stimgen_theta_bin(theta, 0); b >= 0; b = cordic_stimgen_theta_bin(theta, b + 1))
+            g->hits[b]++;
+        for (int i = 0; i < 6; i++) {
+            unsigned char byte = (unsigned char)(theta >> (8*i));
+            set_packet(o_msg + GREF_IN_THETA + 6*j + i, byte);
+            crc_8_calc(&crc_8, byte);
+        }
+    }
+
+    /* Corruption, at most one kind per message */
+    int kind = STIMGEN_CORRUPT_NONE, roll = std::uniform_int_distribution<int>(0, 99)(g->rng);
+    for (int k = STIMGEN_CORRUPT_CRC; k <= STIMGEN_CORRUPT_STOP && !kind; k++) {
+        if (roll < g->corrupt_pct[k])
+            kind = k;
+        roll -= g->corrupt_pct[k];
+    }
+    if (kind == STIMGEN_CORRUPT_CRC)
+        crc_8 ^= (unsigned char)(1 << std::uniform_int_distribution<int>(0, 7)(g->rng));
+    set_packet(o_msg + GREF_IN_CRC_8, crc_8);
+
+    if (kind == STIMGEN_CORRUPT_PARITY || kind == STIMGEN_CORRUPT_STOP) {
+        // Packets in wire order: header, cmd, burst cnt, thetas, crc
+        int slots[GREF_IN_MSG_LEN], n = 0;
+        slots[n++] = GREF_IN_HEADER;
+        slots[n++] = GREF_IN_CMD;
+        if (cmd == CMD_BURST_TRANS)
+            slots[n++] = GREF_IN_BURST_CNT;
+        for (int i = 0; i < 6*cnt; i++)
+            slots[n++] = GREF_IN_THETA + i;
+        slots[n++] = GREF_IN_CRC_8;
+
+        // Last packet the error can go in: the byte is dropped on a parity error but taken on a
+        // stop error, and must not start the first angle (or act on DISABLE/ENABLE)
+        int last = cnt ? (cmd == CMD_BURST_TRANS ? 3 : 2) + 5 : 1;
+        if (kind == STIMGEN_CORRUPT_STOP)
+            last--;
+        int k = std::uniform_int_distribution<int>(0, last)(g->rng);
+
+        // uart_rx_msg hunts for a header from the next packet on: move the error onto the last
+        // header byte there that is followed by a command byte, or leave the message intact
+        for (int i = k + 1; i + 1 < n; i++) {
+            unsigned char next = (o_msg[slots[i + 1]] >> 1) & 0xff;
+            if (((o_msg[slots[i]] >> 1) & 0xff) == BYTE_HEADER
+                && (next == CMD_SINGLE_TRANS || next == CMD_BURST_TRANS || next == CMD_STREAM_TRANS
+                    || next == CMD_VECTOR_TRANS || next == CMD_SELFTEST || next == CMD_DISABLE
+                    || next == CMD_ENABLE))
+                k = i;
+        }
+        if (k > last)
+            kind = STIMGEN_CORRUPT_NONE;
+        else
+            o_msg[slots[k]] ^= (kind == STIMGEN_CORRUPT_PARITY) ? (1 << 9) : (1 << 10);
+    }
+    for (int b = 0; b < NUM_BINS; b++)
+        if (kind && BINS[b].kind == BIN_CORRUPT && BINS[b].lo == kind)
+            g->hits[b]++;
+    return kind;
+}
+
+extern "C" int cordic_stimgen_num_bins() {
+    return NUM_BINS;
+}
+
+extern "C" const char* cordic_stimgen_bin_name(const int i_bin) {
+    return (i_bin >= 0 && i_bin < NUM_BINS) ? BINS[i_bin].name : "";
+}
+
+extern "C" long long cordic_stimgen_bin_hits(const cordic_stimgen_t* g, const int i_bin) {
+    return (i_bin >= 0 && i_bin < NUM_BINS) ? g->hits[i_bin] : 0;
+}
+
+extern "C" int cordic_stimgen_bins_hit(const cordic_stimgen_t* g) {
+    int n = 0;
+    for (int b = 0; b < NUM_BINS; b++)
+        n += g->hits[b] != 0;
+    return n;
+}
+
+extern "C" void cordic_stimgen_report(const cordic_stimgen_t* g) {
+    printf("cordic_stimgen: %d of %d bins hit\n", cordic_stimgen_bins_hit(g), NUM_BINS);
+    for (int b = 0; b < NUM_BINS; b++)
+        printf("    %-26s %12lld%s\n", BINS[b].name, g->hits[b], g->hits[b] ? "" : "  (not hit)");
+    fflush(stdout);
+}
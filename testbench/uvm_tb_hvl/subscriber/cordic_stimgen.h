@@ -0,0 +1,52 @@
+//
+// File:        cordic_stimgen.h
+// Author:      agent
+// Date:        10/2026
+// Description: Coverage-directed stimulus generator. Builds whole request messages in the packed
+//              cordic_gref_batch() input layout (GREF_IN_MSG_LEN packets). Thetas and burst counts
+//              are drawn from weighted bins aimed at the fixed-point corner cases: the exact fold
+//              boundaries, +/-2pi, tiny angles and the bit 46/47 sign extension edges, on top of
+//              the quadrant ranges of cordic_coverage. A bin's weight is divided by 1 + its hit
+//              count, so bins not yet hit are drawn first. Messages can optionally carry a
+//              corrupted CRC, parity or stop bit.
+//
+//              Each generator is independent (own RNG and hit counts), so one can be used per
+//              sequence or thread.
+//
+
+#ifndef CORDIC_STIMGEN_H
+#define CORDIC_STIMGEN_H
+
+// Corruption applied to a message, returned by cordic_stimgen_next()
+static const int STIMGEN_CORRUPT_NONE   = 0;
+static const int STIMGEN_CORRUPT_CRC    = 1;    // crc byte wrong, framing intact: o_rx_msg_err
+static const int STIMGEN_CORRUPT_PARITY = 2;    // one packet's parity bit flipped: o_rx_err
+static const int STIMGEN_CORRUPT_STOP   = 3;    // one packet's stop bit cleared, not the crc's: o_rx_err
+
+struct cordic_stimgen_t;
+
+/* DPI-C imports (cordic_stimgen.svh) */
+extern "C" cordic_stimgen_t* cordic_stimgen_create(const long long i_seed);
+extern "C" void cordic_stimgen_destroy(cordic_stimgen_t* g);
+
+/* Percent of messages to corrupt with each kind (0 by default). top_module drops a corrupted
+   message without a response. uart_rx_msg then hunts for a header in the packets after the
+   corrupted one, so none of them starts a message there. */
+extern "C" void cordic_stimgen_corrupt(cordic_stimgen_t* g, const int i_crc_pct, const int i_parity_pct,
+                                       const int i_stop_pct);
+
+/* Next message of command i_cmd (CMD_SINGLE_TRANS, CMD_BURST_TRANS, CMD_DISABLE or CMD_ENABLE)
+   into o_msg. Unused theta slots are 0. Returns the STIMGEN_CORRUPT_* kind applied. */
+extern "C" int cordic_stimgen_next(cordic_stimgen_t* g, const int i_cmd, short int* o_msg);
+
+/* Bins: names, hit counts, the number hit at least once, and a table printed to stdout */
+extern "C" int cordic_stimgen_num_bins();
+extern "C" const char* cordic_stimgen_bin_name(const int i_bin);
+extern "C" long long cordic_stimgen_bin_hits(const cordic_stimgen_t* g, const int i_bin);
+extern "C" int cordic_stimgen_bins_hit(const cordic_stimgen_t* g);
+extern "C" void cordic_stimgen_report(const cordic_stimgen_t* g);
+
+/* Bin of the theta bins that contain theta, -1 past the last one; start from first = 0 */
+int cordic_stimgen_theta_bin(long long theta, int first);
+
+#endif
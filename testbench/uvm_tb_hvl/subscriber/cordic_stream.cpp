@@ -0,0 +1,245 @@
+//
+// File:        cordic_stream.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Incremental CORDIC-UART stream decoder and response builder.
+//
+
+#include <stddef.h>
+#include <string.h>
+#include "cordic_gref_const.h"
+#include "cordic_gref.h"
+#include "cordic_crc8.h"
+#include "cordic_stream.h"
+
+/* Same names as cmd_seq_state_t in uart_rx_msg.sv. STATE_DISABLE and STATE_ENABLE consume no
+   bytes, so they fold into STATE_CRC_CHECK here. */
+enum {
+    STATE_HEADER,
+    STATE_CMD,
+    STATE_SINGLE_TRANS,
+    STATE_BURST_TRANS,
+    STATE_BURST_TRANS_II,
+    STATE_STREAM_TRANS,
+    STATE_STREAM_TRANS_II,
+    STATE_STREAM_TRANS_III,
+    STATE_STREAM_TRANS_IV,
+    STATE_SELFTEST,
+    STATE_CRC_CHECK
+};
+
+void cordic_stream_init(cordic_stream_t* s, cordic_stream_dir_t dir) {
+    // buf is only read up to buf_len, so leave it uninitialized; it is large
+    memset(s, 0, offsetof(cordic_stream_t, buf));
+    s->dir      = dir;
+    s->state    = STATE_HEADER;
+}
+
+/* Moves n bytes of the current frame past *p, copying them if the frame is being buffered */
+static inline void consume(cordic_stream_t* s, const unsigned char** p, size_t n) {
+    if (!s->frame_start) {
+        memcpy(s->buf + s->buf_len, *p, n);
+        s->buf_len += n;
+    }
+    (*p)        += n;
+    s->offset   += n;
+}
+
+static inline void finish_frame(cordic_stream_t* s, const unsigned char* p, cordic_frame_t* frame,
+                                cordic_frame_status_t status) {
+    (*frame)            = s->frame;
+    frame->bytes        = s->frame_start ? s->frame_start : s->buf;
+    frame->len          = s->frame_start ? (size_t)(p - s->frame_start) : s->buf_len;
+    frame->payload      = frame->bytes + (frame->cmd == CMD_BURST_TRANS ? 3 :
+                                          frame->cmd == CMD_STREAM_TRANS ? 5 : 2);
+    frame->status       = status;
+    if (status == CORDIC_FRAME_OK && crc_8_block(0, frame->bytes, frame->len))
+        frame->status   = CORDIC_FRAME_CRC_ERR;
+    s->state            = STATE_HEADER;
+}
+
+bool cordic_stream_next(cordic_stream_t* s, const unsigned char** p, const unsigned char* end,
+                        cordic_frame_t* frame) {
+    const size_t unit = (s->dir == CORDIC_STREAM_RX) ? 6 : 12;
+
+    while ((*p) < end) {
+        switch (s->state) {
+
+            case STATE_HEADER: {
+                const unsigned char* h = (const unsigned char*)memchr(*p, BYTE_HEADER, end - (*p));
+                size_t skip = h ? (size_t)(h - (*p)) : (size_t)(end - (*p));
+                s->dropped  += skip;
+                s->offset   += skip;
+                (*p)        += skip;
+                if (!h)
+                    break;
+                s->frame_start          = *p;
+                s->buf_len              = 0;
+                s->frame.offset         = s->offset;
+                s->frame.cmd            = 0;
+                s->frame.mode           = 0;
+                s->frame.num_theta      = 0;
+                consume(s, p, 1);
+                s->state                = STATE_CMD;
+                break;
+            }
+
+            case STATE_CMD: {
+                unsigned char cmd = **p;
+                consume(s, p, 1);
+                s->frame.cmd = cmd;
+                if (cmd == CMD_SINGLE_TRANS) {
+                    s->frame.num_theta  = 1;
+                    s->need             = unit;
+                    s->state            = STATE_SINGLE_TRANS;
+                } else if (cmd == CMD_BURST_TRANS) {
+                    s->state            = STATE_BURST_TRANS;
+                } else if (cmd == CMD_STREAM_TRANS) {
+                    s->state            = STATE_STREAM_TRANS;
+                } else if (cmd == CMD_SELFTEST) {
+                    // seed and count, or signature and cycles: 10 bytes either way
+                    s->need             = 10;
+                    s->state            = STATE_SELFTEST;
+                } else if (cmd == CMD_DISABLE || cmd == CMD_ENABLE
+                           || (s->dir == CORDIC_STREAM_TX && cmd == CMD_ERR)) {
+                    s->state            = STATE_CRC_CHECK;
+                } else {
+                    finish_frame(s, *p, frame, CORDIC_FRAME_BAD_CMD);
+                    return true;
+                }
+                break;
+            }
+
+            case STATE_BURST_TRANS: {
+                unsigned char burst_cnt = **p;
+                consume(s, p, 1);
+                s->frame.num_theta  = burst_cnt ? burst_cnt : 256;
+                s->need             = unit * s->frame.num_theta;
+                s->state            = STATE_BURST_TRANS_II;
+                break;
+            }
+
+            case STATE_STREAM_TRANS:
+                s->frame.mode       = **p;
+                consume(s, p, 1);
+                s->state            = STATE_STREAM_TRANS_II;
+                break;
+
+            case STATE_STREAM_TRANS_II:
+                s->frame.num_theta  = **p;
+                consume(s, p, 1);
+                s->state            = STATE_STREAM_TRANS_III;
+                break;
+
+            case STATE_STREAM_TRANS_III: {
+                int cnt = s->frame.num_theta | (**p << 8);
+                consume(s, p, 1);
+                s->frame.num_theta  = cnt ? cnt : STREAM_MAX_CNT;
+                s->need             = (size_t)s->frame.num_theta * ((s->dir == CORDIC_STREAM_RX)
+                                        ? stream_theta_bytes(s->frame.mode)
+                                        : 2 * stream_result_bytes(s->frame.mode));
+                s->state            = STATE_STREAM_TRANS_IV;
+                break;
+            }
+
+            case STATE_SINGLE_TRANS:
+            case STATE_BURST_TRANS_II:
+            case STATE_STREAM_TRANS_IV:
+            case STATE_SELFTEST: {
+                size_t take = (size_t)(end - (*p));
+                if (take > s->need)
+                    take = s->need;
+                consume(s, p, take);
+                s->need -= take;
+                if (!s->need)
+                    s->state = STATE_CRC_CHECK;
+                break;
+            }
+
+            case STATE_CRC_CHECK:
+                consume(s, p, 1);
+                finish_frame(s, *p, frame, CORDIC_FRAME_OK);
+                return true;
+        }
+    }
+
+    // Chunk ran out in the middle of a frame: keep what we have for the next call
+    if (s->state != STATE_HEADER && s->frame_start) {
+        s->buf_len = (size_t)(end - s->frame_start);
+        memcpy(s->buf, s->frame_start, s->buf_len);
+    }
+    s->frame_start = NULL;
+    return false;
+}
+
+bool cordic_stream_idle(const cordic_stream_t* s) {
+    return s->state == STATE_HEADER;
+}
+
+bool cordic_stream_push(cordic_stream_t* s, unsigned char byte, cordic_frame_t* frame) {
+    const unsigned char* p = &byte;
+    return cordic_stream_next(s, &p, p + 1, frame);
+}
+
+size_t cordic_stream_response(const cordic_frame_t* req, unsigned char* out) {
+    size_t len = 0;
+    out[len++] = BYTE_HEADER;
+    out[len++] = req->cmd;
+
+    if (req->cmd == CMD_STREAM_TRANS) {
+        for (int i = -3; i < 0; i++)
+            out[len++] = req->payload[i];
+
+        int theta_bytes = stream_theta_bytes(req->mode);
+        int result_bytes = stream_result_bytes(req->mode);
+        long long theta[8], cos_theta[8], sin_theta[8];
+        for (int j = 0; j < req->num_theta; j += 8) {
+            int n = (req->num_theta - j < 8) ? req->num_theta - j : 8;
+            for (int k = 0; k < n; k++)
+                theta[k] = stream_theta(req->payload + theta_bytes*(j + k), req->mode);
+            cordic_sincos_burst(theta, cos_theta, sin_theta, n);
+            for (int k = 0; k < n; k++) {
+                stream_result(cos_theta[k], req->mode, out + len);
+                stream_result(sin_theta[k], req->mode, out + len + result_bytes);
+                len += 2*result_bytes;
+            }
+        }
+    } else if (req->cmd == CMD_SELFTEST) {
+        long long seed = 0, cnt = 0, cycles;
+        unsigned int signature;
+        for (int i = 5; i >= 0; i--)
+            seed = (seed << 8) | req->payload[i];
+        for (int i = 3; i >= 0; i--)
+            cnt = (cnt << 8) | req->payload[6 + i];
+        cordic_gref_selftest(0, seed, cnt ? cnt : SELFTEST_MAX_CNT, &signature, &cycles);
+        for (int i = 0; i < 4; i++)
+            out[len++] = (unsigned char)(signature >> (8*i));
+        for (int i = 0; i < 6; i++)
+            out[len++] = (unsigned char)(cycles >> (8*i));
+    } else if (req->cmd == CMD_SINGLE_TRANS || req->cmd == CMD_BURST_TRANS) {
+        if (req->cmd == CMD_BURST_TRANS)
+            out[len++] = req->payload[-1];
+
+        long long theta[8], cos_theta[8], sin_theta[8];
+        for (int j = 0; j < req->num_theta; j += 8) {
+            int n = (req->num_theta - j < 8) ? req->num_theta - j : 8;
+            for (int k = 0; k < n; k++) {
+                const unsigned char* b = req->payload + 6*(j + k);
+                long long t = 0;
+                for (int i = 5; i >= 0; i--)
+                    t = (t << 8) | b[i];
+                theta[k] = (long long)((unsigned long long)t << 16) >> 16;
+            }
+            cordic_sincos_burst(theta, cos_theta, sin_theta, n);
+            for (int k = 0; k < n; k++) {
+                for (int i = 0; i < 6; i++)
+                    out[len++] = (unsigned char)(cos_theta[k] >> (8*i));
+                for (int i = 0; i < 6; i++)
+                    out[len++] = (unsigned char)(sin_theta[k] >> (8*i));
+            }
+        }
+    }
+
+    out[len] = crc_8_block(0, out, len);
+    return len + 1;
+}
@@ -0,0 +1,82 @@
+//
+// File:        cordic_stream.h
+// Author:      agent
+// Date:        10/2026
+// Description: Incremental decoder for raw CORDIC-UART byte streams. Request streams (host to
+//              device) are framed exactly like the cmd_seq_state machine in uart_rx_msg.sv:
+//              hunt for the header, decode cmd, collect burst cnt and thetas, check the CRC, and
+//              on any error go back to hunting from the next byte. Response streams (device to
+//              host) are framed the same way with 12 result bytes per angle (CMD_STREAM_TRANS:
+//              the theta and result widths its mode byte selects; CMD_SELFTEST: 10 payload bytes
+//              each way).
+//
+
+#ifndef CORDIC_STREAM_H
+#define CORDIC_STREAM_H
+
+#include <stddef.h>
+#include "cordic_gref_const.h"
+
+enum cordic_stream_dir_t {
+    CORDIC_STREAM_RX,       // requests, as seen by uart_rx_msg
+    CORDIC_STREAM_TX        // responses, as sent by uart_tx_msg
+};
+
+enum cordic_frame_status_t {
+    CORDIC_FRAME_OK,
+    CORDIC_FRAME_CRC_ERR,   // o_rx_msg_err in uart_rx_msg
+    CORDIC_FRAME_BAD_CMD    // unknown cmd byte, uart_rx_msg silently returns to STATE_HEADER
+};
+
+/* Largest frame: a CMD_STREAM_TRANS response of header, cmd, mode, 2 count bytes, 65536 results
+   of 12 bytes and crc. A burst cnt of 0 is counted down from 256 by uart_rx_msg and a stream
+   count of 0 from 65536, so they are decoded as 256 and 65536 angles. */
+static const size_t CORDIC_STREAM_MAX_FRAME = 5 + 12*STREAM_MAX_CNT + 1;
+
+/* One decoded frame. bytes points into the caller's buffer when the frame was contained in a
+   single chunk, otherwise into the decoder; either way it is valid until the next call. */
+struct cordic_frame_t {
+    const unsigned char*    bytes;      // header through crc
+    size_t                  len;
+    size_t                  offset;     // stream offset of the header byte
+    unsigned char           cmd;
+    unsigned char           mode;       // CMD_STREAM_TRANS mode byte, 0 otherwise
+    int                     num_theta;  // thetas (RX) or cos/sin pairs (TX)
+    const unsigned char*    payload;    // first theta (RX) or first cos (TX) byte; SELFTEST seed or signature
+    cordic_frame_status_t   status;
+};
+
+struct cordic_stream_t {
+    cordic_stream_dir_t     dir;
+    int                     state;
+    size_t                  offset;         // stream offset of the next input byte
+    size_t                  need;           // payload bytes still expected
+    size_t                  dropped;        // bytes discarded while hunting for a header
+    cordic_frame_t          frame;          // frame under construction
+    const unsigned char*    frame_start;    // start of the frame in the current chunk, or NULL
+    size_t                  buf_len;
+    unsigned char           buf[CORDIC_STREAM_MAX_FRAME];
+};
+
+void cordic_stream_init(cordic_stream_t* s, cordic_stream_dir_t dir);
+
+/* Consumes bytes from [*p, end) until a frame completes (returns true, *p just past it) or the
+   chunk runs out (returns false, *p == end). Whole-theta runs and header hunting are consumed
+   in bulk, so feeding large chunks is much faster than feeding single bytes. */
+bool cordic_stream_next(cordic_stream_t* s, const unsigned char** p, const unsigned char* end,
+                        cordic_frame_t* frame);
+
+/* True between frames, i.e. while uart_rx_msg would be in STATE_HEADER */
+bool cordic_stream_idle(const cordic_stream_t* s);
+
+/* Byte-at-a-time form of cordic_stream_next() */
+bool cordic_stream_push(cordic_stream_t* s, unsigned char byte, cordic_frame_t* frame);
+
+/* Builds the response the RTL sends for a well-formed request frame (results for SINGLE/BURST,
+   the signature and stall-free cycle count for SELFTEST, the acknowledgement for DISABLE/ENABLE)
+   and returns its length. Build it only from a frame
+   decoded in the CORDIC_STREAM_RX direction. out must hold
+   CORDIC_STREAM_MAX_FRAME bytes. */
+size_t cordic_stream_response(const cordic_frame_t* req, unsigned char* out);
+
+#endif
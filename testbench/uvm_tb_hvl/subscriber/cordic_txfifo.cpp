@@ -0,0 +1,217 @@
+//
+// File:        cordic_txfifo.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: TX FIFO occupancy and backpressure model of top_module (see cordic_txfifo.h).
+//
+
+#include <limits.h>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "cordic_gref_const.h"
+#include "cordic_gref.h"
+#include "cordic_txfifo.h"
+
+static const int PACKET_BITS        = 11;
+static const int MSG_BYTE_CYCLES    = 11;   // uart_tx_msg: one byte per CRC-8 update
+static const long long NEVER        = LLONG_MAX;
+
+/* One unit of response bytes, in wire order. Angle items are ready when their result leaves the
+   pipeline; the others (acknowledgements, errors, self-test results) at a fixed cycle. */
+struct txfifo_item_t {
+    bool        angle;
+    long long   t_arrive;       // angle: cycle its last theta byte is in
+    long long   t_ready;
+    int         bytes;
+};
+
+static unsigned char byte_of(short int packet) {
+    return (packet >> 1) & 0xff;
+}
+
+/* Splits one request's response into items. t_byte(k) is the cycle packet k of the request is in. */
+template <typename F>
+static void add_items(const short int* req, int len, const short int* rsp, int rsp_len, F t_byte,
+                      const cordic_txfifo_cfg_t& cfg, std::vector<txfifo_item_t>& items,
+                      std::vector<std::pair<long long, bool>>& enable_events) {
+    if (rsp_len == 0)
+        return;
+    unsigned char cmd = byte_of(req[1]), rsp_cmd = byte_of(rsp[1]);
+
+    if (rsp_cmd == CMD_DISABLE || rsp_cmd == CMD_ENABLE) {
+        // uart_rx_msg changes the pipeline enable and uart_tx_msg acknowledges once the cmd is in
+        enable_events.push_back(std::make_pair(t_byte(1), rsp_cmd == CMD_ENABLE));
+        items.push_back({ false, 0, t_byte(1) + 2, rsp_len });
+        return;
+    }
+    if (rsp_cmd == CMD_SELFTEST) {
+        long long cnt = 0;
+        for (int b = 0; b < 4; b++)
+            cnt |= (long long)byte_of(req[8 + b]) << (8 * b);
+        cnt = cnt ? cnt : SELFTEST_MAX_CNT;
+        long long cycles = (cnt + cfg.lanes - 1) / cfg.lanes + cfg.latency;
+        items.push_back({ false, 0, t_byte(len - 1) + cycles, rsp_len });
+        return;
+    }
+    if (rsp_cmd != cmd) {
+        items.push_back({ false, 0, t_byte(len - 1), rsp_len });
+        return;
+    }
+
+    // SINGLE, BURST, STREAM and VECTOR: the header goes with the first angle, the crc with the last
+    int n = 1, per = 12, first = 2, step = 6;
+    if (cmd == CMD_BURST_TRANS) {
+        n = byte_of(req[2]) ? byte_of(req[2]) : 256;
+        first = 3;
+    } else if (cmd == CMD_STREAM_TRANS) {
+        unsigned char mode = byte_of(req[2]);
+        n = byte_of(req[3]) | (byte_of(req[4]) << 8);
+        n = n ? n : STREAM_MAX_CNT;
+        per = 2 * stream_result_bytes(mode);
+        first = 5;
+        step = stream_theta_bytes(mode);
+    } else if (cmd == CMD_VECTOR_TRANS) {
+        step = 12;
+    }
+    int head = rsp_len - 1 - n * per;
+    for (int j = 0; j < n; j++)
+        items.push_back({ true, t_byte(first + step * (j + 1) - 1), NEVER,
+                          per + (j == 0 ? head : 0) + (j == n - 1 ? 1 : 0) });
+}
+
+extern "C" int cordic_txfifo_run(const cordic_txfifo_cfg_t* cfg, const int num_msgs, const int* msg_len,
+                                 const short int* msgs, const long long* t_send,
+                                 cordic_txfifo_stats_t* stats) {
+    *stats = cordic_txfifo_stats_t();
+
+    // Response items and pipeline enable changes, from the message-level model
+    std::unique_ptr<cordic_gref_ctx, void (*)(cordic_gref_ctx*)> gref(cordic_gref_ctx_create(cfg->seed_bits),
+                                                                       cordic_gref_ctx_destroy);
+    if (!gref || !cordic_gref_ctx_set_lanes(gref.get(), cfg->lanes))
+        return 0;
+    std::vector<short int> rsp(5 + 12*STREAM_MAX_CNT + 1);
+    std::vector<txfifo_item_t> items;
+    std::vector<std::pair<long long, bool>> enable_events;
+    double packet_cycles = (double)PACKET_BITS * cfg->clk_freq / cfg->baud_rate;
+    long long t_line = 0;
+    for (int i = 0, pos = 0; i < num_msgs; pos += msg_len[i++]) {
+        long long t_start = std::max(t_line, t_send ? t_send[i] : 0);
+        auto t_byte = [&](int k) { return t_start + (long long)((k + 1) * packet_cycles); };
+        int rsp_len = cordic_gref_ctx_process(gref.get(), msg_len[i], msgs + pos, rsp.data());
+        add_items(msgs + pos, msg_len[i], rsp.data(), rsp_len, t_byte, *cfg, items, enable_events);
+        t_line = t_byte(msg_len[i] - 1);
+    }
+
+    // Cycle-stepped top_module: skid, pipelines, uart_tx_msg, FIFO and uart_tx
+    long long tx_byte_cycles = (long long)packet_cycles + 2;
+    std::deque<std::pair<long long, size_t>> pipe;      // due running cycle, item
+    std::deque<size_t> skid;
+    size_t next_angle = 0, next_item = 0, next_enable = 0;
+    long long run_cycles = 0, next_emit = 0, line_free = 0, t = 0;
+    int count = 0, emit_bytes = 0;
+    bool enabled = true;
+
+    auto next_angle_item = [&]() {
+        while (next_angle < items.size() && !items[next_angle].angle)
+            next_angle++;
+    };
+    next_angle_item();
+
+    for (;;) {
+        while (next_enable < enable_events.size() && enable_events[next_enable].first <= t)
+            enabled = enable_events[next_enable++].second;
+
+        bool stall = count > cfg->depth - cfg->margin;
+        bool run = enabled && !stall;
+        stats->stall_cycles += enabled && stall;
+        // As registered in top_module: a result leaving this cycle is still in flight
+        bool slot = run && pipe.empty() && emit_bytes == 0;
+
+        // Pipelines: results leave after latency running cycles
+        if (run) {
+            run_cycles++;
+            while (!pipe.empty() && pipe.front().first <= run_cycles) {
+                items[pipe.front().second].t_ready = t;
+                pipe.pop_front();
+            }
+        }
+
+        // Skid ahead of the pipelines: an angle issues while none is in flight and uart_tx_msg is
+        // not writing bytes, the waiting ones first; one arriving with the skid full (as it was at
+        // the start of the cycle) or the pipelines disabled is lost
+        bool skid_full = (int)skid.size() >= cfg->skid;
+        long long issue = -1;
+        if (slot && !skid.empty()) {
+            issue = (long long)skid.front();
+            skid.pop_front();
+        }
+        if (next_angle < items.size() && items[next_angle].t_arrive <= t) {
+            size_t a = next_angle++;
+            next_angle_item();
+            if (enabled && slot && issue < 0) {
+                issue = (long long)a;
+            } else if (enabled && !skid_full) {
+                skid.push_back(a);
+                stats->skid_angles++;
+                stats->skid_peak = std::max(stats->skid_peak, (int)skid.size());
+            } else {
+                stats->lost_angles++;
+                stats->lost_bytes += items[a].bytes;
+                items[a].bytes = 0;
+                items[a].t_ready = t;
+            }
+        }
+        if (issue >= 0)
+            pipe.push_back(std::make_pair(run_cycles + cfg->latency, (size_t)issue));
+
+        // uart_tx_msg writes the response bytes of one item after another
+        if (emit_bytes == 0 && next_item < items.size() && items[next_item].t_ready <= t) {
+            emit_bytes = items[next_item++].bytes;
+            next_emit = std::max(next_emit, t);
+        }
+        if (emit_bytes > 0 && next_emit <= t) {
+            if (count == cfg->depth)
+                stats->lost_bytes++;
+            else
+                count++;
+            emit_bytes--;
+            next_emit = t + MSG_BYTE_CYCLES;
+        }
+        stats->peak_count = std::max(stats->peak_count, count);
+
+        // uart_tx takes a byte whenever the line is free
+        if (count > 0 && line_free <= t) {
+            count--;
+            stats->tx_bytes++;
+            line_free = t + tx_byte_cycles;
+        }
+
+        // Done, or held by a DISABLE that is never lifted
+        if (emit_bytes == 0 && count == 0
+            && (next_item == items.size()
+                || (!enabled && next_enable == enable_events.size() && items[next_item].t_ready == NEVER))) {
+            stats->cycles = std::max(line_free, t);
+            break;
+        }
+
+        // Nothing in flight: skip to the next arrival, ready item or enable change
+        if (pipe.empty() && skid.empty() && emit_bytes == 0 && count == 0) {
+            long long t_next = NEVER;
+            if (next_angle < items.size())
+                t_next = std::min(t_next, items[next_angle].t_arrive);
+            if (next_item < items.size() && !items[next_item].angle)
+                t_next = std::min(t_next, items[next_item].t_ready);
+            if (next_enable < enable_events.size())
+                t_next = std::min(t_next, enable_events[next_enable].first);
+            if (t_next != NEVER && t_next > t + 1) {
+                t = t_next;
+                continue;
+            }
+        }
+        t++;
+    }
+    return stats->lost_bytes == 0;
+}
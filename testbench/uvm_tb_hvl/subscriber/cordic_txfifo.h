@@ -0,0 +1,53 @@
+//
+// File:        cordic_txfifo.h
+// Author:      agent
+// Date:        10/2026
+// Description: Occupancy model of the TX FIFO in top_module. Replays a sequence of request
+//              messages as they arrive on i_rx, pushes each response's bytes into the FIFO at the
+//              uart_tx_msg rate as its angles leave the CORDIC pipeline, drains one byte per UART
+//              packet time, and applies the backpressure of top_module: one angle is in flight at a
+//              time and issues only while uart_tx_msg is not writing bytes, the pipelines hold
+//              while fewer than margin bytes are free, angles that cannot issue wait in a skid of
+//              skid entries, and one arriving with the skid full is lost (o_tx_overrun).
+//
+//              Timing is cycle-stepped but approximate (the UART byte and uart_tx_msg byte periods,
+//              not their exact phases), which is enough to size TX_FIFO_DEPTH for a traffic
+//              pattern and to know whether a test at that rate may lose bytes.
+//
+
+#ifndef CORDIC_TXFIFO_H
+#define CORDIC_TXFIFO_H
+
+#include "cordic_gref_const.h"
+
+struct cordic_txfifo_cfg_t {
+    long long   clk_freq        = 100000000;
+    long long   baud_rate       = 3000000;
+    int         depth           = TX_FIFO_DEPTH;
+    int         margin          = TX_FIFO_MARGIN;
+    int         skid            = TX_SKID_DEPTH;
+    int         latency         = SELFTEST_LATENCY;     // running cycles from start to done
+    int         seed_bits       = 0;                    // CORDIC mode of the model instance
+    int         lanes           = 1;                    // top_module CORDIC_LANES
+};
+
+struct cordic_txfifo_stats_t {
+    long long   cycles;         // until the last response byte has left o_tx
+    int         peak_count;     // highest FIFO occupancy
+    long long   stall_cycles;   // cycles the pipelines were held by the FIFO
+    long long   skid_angles;    // angles that waited in the skid
+    int         skid_peak;      // most angles waiting at once
+    long long   lost_angles;    // angles dropped with the skid full or the pipelines disabled
+    long long   lost_bytes;     // response bytes dropped, by lost angles or a full FIFO
+    long long   tx_bytes;       // response bytes sent
+};
+
+/* Runs num_msgs request messages (packets in wire order, msg_len[i] packets each, concatenated
+   in msgs) through a fresh model instance. t_send[i] is the cycle the host starts sending message
+   i, or t_send is NULL for back-to-back messages at the full line rate; either way a message
+   starts no earlier than the end of the previous one. Returns 1 when no byte was lost. */
+extern "C" int cordic_txfifo_run(const cordic_txfifo_cfg_t* cfg, const int num_msgs, const int* msg_len,
+                                 const short int* msgs, const long long* t_send,
+                                 cordic_txfifo_stats_t* stats);
+
+#endif
@@ -0,0 +1,220 @@
+//
+// File:        cordic_vec.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Golden vector file writer and memory-mapped reader.
+//
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "cordic_gref_const.h"
+#include "cordic_gref.h"
+#include "cordic_crc8.h"
+#include "cordic_vec.h"
+
+static_assert(sizeof(cordic_vec_hdr_t) == 64, "vector file header must stay 64 bytes");
+static_assert(sizeof(cordic_vec_rec_t) == 48, "vector file record must stay 48 bytes");
+
+static const char CORDIC_VEC_MAGIC[8] = { 'C', 'O', 'R', 'D', 'V', 'E', 'C', 0 };
+
+struct cordic_vec_t {
+    const unsigned char*    base;
+    size_t                  size;
+    const cordic_vec_rec_t* recs;
+    long long               num_records;
+    int                     seed_bits;
+};
+
+struct cordic_vec_writer_t {
+    FILE*               f;
+    cordic_vec_hdr_t    hdr;
+};
+
+static void init_hdr(cordic_vec_hdr_t* hdr, unsigned long long num_records, unsigned long long seed,
+                     int seed_bits) {
+    memset(hdr, 0, sizeof(*hdr));
+    memcpy(hdr->magic, CORDIC_VEC_MAGIC, sizeof(hdr->magic));
+    hdr->version        = CORDIC_VEC_VERSION;
+    hdr->byte_order     = CORDIC_VEC_BYTE_ORDER;
+    hdr->hdr_len        = sizeof(cordic_vec_hdr_t);
+    hdr->rec_len        = sizeof(cordic_vec_rec_t);
+    hdr->stages         = 48;
+    hdr->bits           = 48;
+    hdr->num_records    = num_records;
+    hdr->seed           = seed;
+    hdr->seed_bits      = seed_bits;
+}
+
+/* Record contents once cos/sin are known */
+static void fill_rec(long long theta, long long cos_theta, long long sin_theta, cordic_vec_rec_t* rec) {
+    memset(rec, 0, sizeof(*rec));
+    rec->theta      = theta;
+    rec->cos_theta  = cos_theta;
+    rec->sin_theta  = sin_theta;
+
+    rec->request[0] = BYTE_HEADER;
+    rec->request[1] = CMD_SINGLE_TRANS;
+    for (int i = 0; i < 6; i++)
+        rec->request[2+i] = (unsigned char)(theta >> (8*i));
+    rec->request[8] = crc_8_block(0, rec->request, 8);
+
+    rec->response[0] = BYTE_HEADER;
+    rec->response[1] = CMD_SINGLE_TRANS;
+    for (int i = 0; i < 6; i++) {
+        rec->response[2+i] = (unsigned char)(cos_theta >> (8*i));
+        rec->response[8+i] = (unsigned char)(sin_theta >> (8*i));
+    }
+    rec->response[14] = crc_8_block(0, rec->response, 14);
+}
+
+void cordic_vec_make_rec(long long theta, int seed_bits, cordic_vec_rec_t* rec) {
+    long long cos_theta, sin_theta;
+    cordic_gref_sincos(&theta, &cos_theta, &sin_theta, 1, seed_bits);
+    fill_rec(theta, cos_theta, sin_theta, rec);
+}
+
+cordic_vec_writer_t* cordic_vec_create(const char* path, unsigned long long seed, int seed_bits) {
+    FILE* f = fopen(path, "wb");
+    if (!f)
+        return NULL;
+    cordic_vec_writer_t* w = new cordic_vec_writer_t;
+    w->f = f;
+    init_hdr(&w->hdr, 0, seed, seed_bits);
+    // Placeholder header, rewritten with the record count on close
+    if (fwrite(&w->hdr, sizeof(w->hdr), 1, f) != 1) {
+        fclose(f);
+        delete w;
+        return NULL;
+    }
+    return w;
+}
+
+int cordic_vec_append(cordic_vec_writer_t* w, const long long* theta, size_t n) {
+    long long cos_theta[8], sin_theta[8];
+    cordic_vec_rec_t recs[8];
+    for (size_t j = 0; j < n; j += 8) {
+        int m = (n - j < 8) ? (int)(n - j) : 8;
+        cordic_gref_sincos(theta + j, cos_theta, sin_theta, m, (int)w->hdr.seed_bits);
+        for (int k = 0; k < m; k++)
+            fill_rec(theta[j+k], cos_theta[k], sin_theta[k], &recs[k]);
+        if (fwrite(recs, sizeof(cordic_vec_rec_t), m, w->f) != (size_t)m)
+            return -1;
+        w->hdr.num_records += m;
+    }
+    return 0;
+}
+
+int cordic_vec_close_writer(cordic_vec_writer_t* w) {
+    int rc = (fseek(w->f, 0, SEEK_SET) || fwrite(&w->hdr, sizeof(w->hdr), 1, w->f) != 1) ? -1 : 0;
+    if (fclose(w->f))
+        rc = -1;
+    delete w;
+    return rc;
+}
+
+extern "C" cordic_vec_t* cordic_vec_open(const char* path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) || (size_t)st.st_size < sizeof(cordic_vec_hdr_t)) {
+        fprintf(stderr, "%s: not a vector file (too short)\n", path);
+        close(fd);
+        return NULL;
+    }
+    void* base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        perror(path);
+        return NULL;
+    }
+
+    const cordic_vec_hdr_t* hdr = (const cordic_vec_hdr_t*)base;
+    const char* err = NULL;
+    if (memcmp(hdr->magic, CORDIC_VEC_MAGIC, sizeof(hdr->magic)))
+        err = "not a vector file (bad magic)";
+    else if (hdr->byte_order != CORDIC_VEC_BYTE_ORDER)
+        err = "written on a host of the other byte order";
+    else if (hdr->version != CORDIC_VEC_VERSION)
+        err = "unsupported version";
+    else if (hdr->hdr_len != sizeof(cordic_vec_hdr_t) || hdr->rec_len != sizeof(cordic_vec_rec_t))
+        err = "unexpected header or record size";
+    else if (hdr->stages != 48 || hdr->bits != 48 || hdr->seed_bits > 44)
+        err = "generated for a different CORDIC configuration";
+    else if (hdr->num_records > (st.st_size - sizeof(cordic_vec_hdr_t)) / sizeof(cordic_vec_rec_t))
+        err = "truncated";
+    if (err) {
+        fprintf(stderr, "%s: %s\n", path, err);
+        munmap(base, st.st_size);
+        return NULL;
+    }
+
+    madvise(base, st.st_size, MADV_SEQUENTIAL);
+    cordic_vec_t* v = new cordic_vec_t;
+    v->base         = (const unsigned char*)base;
+    v->size         = st.st_size;
+    v->recs         = (const cordic_vec_rec_t*)(v->base + sizeof(cordic_vec_hdr_t));
+    v->num_records  = (long long)hdr->num_records;
+    v->seed_bits    = (int)hdr->seed_bits;
+    return v;
+}
+
+extern "C" void cordic_vec_close(cordic_vec_t* v) {
+    if (!v)
+        return;
+    munmap((void*)v->base, v->size);
+    delete v;
+}
+
+extern "C" long long cordic_vec_count(const cordic_vec_t* v) {
+    return v ? v->num_records : 0;
+}
+
+extern "C" int cordic_vec_seed_bits(const cordic_vec_t* v) {
+    return v ? v->seed_bits : 0;
+}
+
+const cordic_vec_rec_t* cordic_vec_get(const cordic_vec_t* v, long long index) {
+    if (!v || index < 0 || index >= v->num_records)
+        return NULL;
+    return v->recs + index;
+}
+
+extern "C" long long cordic_vec_theta(const cordic_vec_t* v, long long index) {
+    const cordic_vec_rec_t* rec = cordic_vec_get(v, index);
+    return rec ? rec->theta : 0;
+}
+
+extern "C" int cordic_vec_request(const cordic_vec_t* v, long long index, short int* o_msg) {
+    const cordic_vec_rec_t* rec = cordic_vec_get(v, index);
+    if (!rec)
+        return -1;
+
+    unsigned char crc_8 = 0;
+    memset(o_msg, 0, GREF_IN_MSG_LEN * sizeof(short int));
+    set_packets(o_msg + GREF_IN_HEADER, rec->request, 2, &crc_8);
+    set_packets(o_msg + GREF_IN_THETA, rec->request + 2, 6, &crc_8);
+    set_packet(o_msg + GREF_IN_CRC_8, rec->request[8]);
+    return 0;
+}
+
+extern "C" int cordic_vec_expected(const cordic_vec_t* v, long long index, short int* o_msg) {
+    const cordic_vec_rec_t* rec = cordic_vec_get(v, index);
+    if (!rec)
+        return -1;
+
+    // Same packets cordic_gref_batch() produces for an enabled SINGLE
+    unsigned char crc_8 = 0;
+    memset(o_msg, 0, GREF_OUT_MSG_LEN * sizeof(short int));
+    set_packets(o_msg + GREF_OUT_HEADER, rec->response, 2, &crc_8);
+    set_packets(o_msg + GREF_OUT_COS_THETA, rec->response + 2, 6, &crc_8);
+    set_packets(o_msg + GREF_OUT_SIN_THETA, rec->response + 8, 6, &crc_8);
+    set_packet(o_msg + GREF_OUT_CRC_8, rec->response[14]);
+    return 0;
+}
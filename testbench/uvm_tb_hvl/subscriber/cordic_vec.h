@@ -0,0 +1,79 @@
+//
+// File:        cordic_vec.h
+// Author:      agent
+// Date:        10/2026
+// Description: Golden vector files. A vector file holds pre-computed SINGLE transactions: theta,
+//              the model's cos/sin and the exact request and response frames the RTL sees and
+//              sends. Records are fixed size so any vector is found by index, and the file is
+//              memory-mapped by the reader, so one vector set can be shared by many regressions
+//              without recomputing the model. The responses are those of one CORDIC configuration
+//              (seed_bits, 0 for the plain pipeline), which the reader has to match.
+//
+//              Layout, all fields in host byte order (checked with byte_order on open):
+//                  cordic_vec_hdr_t    64 bytes
+//                  cordic_vec_rec_t    48 bytes each, num_records of them
+//              A simulator without DPI-C can read the file directly with $fread at offset
+//              64 + 48*index.
+//
+
+#ifndef CORDIC_VEC_H
+#define CORDIC_VEC_H
+
+#include <stddef.h>
+
+static const unsigned int CORDIC_VEC_VERSION    = 1;
+static const unsigned int CORDIC_VEC_BYTE_ORDER = 0x01020304;
+
+struct cordic_vec_hdr_t {
+    char                magic[8];       // "CORDVEC\0"
+    unsigned int        version;
+    unsigned int        byte_order;     // CORDIC_VEC_BYTE_ORDER as written by the host
+    unsigned int        hdr_len;        // sizeof(cordic_vec_hdr_t)
+    unsigned int        rec_len;        // sizeof(cordic_vec_rec_t)
+    unsigned int        stages;         // CORDIC stages and data width of the model
+    unsigned int        bits;
+    unsigned long long  num_records;
+    unsigned long long  seed;           // generator seed, informational
+    unsigned int        seed_bits;      // SEED_BITS of the hybrid model, 0 (older files too) plain
+    unsigned char       reserved[12];
+};
+
+struct cordic_vec_rec_t {
+    long long           theta;          // 4.44 fixed point, sign extended
+    long long           cos_theta;      // 2.46 fixed point, sign extended
+    long long           sin_theta;
+    unsigned char       request[9];     // header, CMD_SINGLE_TRANS, 6 theta bytes, crc
+    unsigned char       response[15];   // header, CMD_SINGLE_TRANS, 6 cos bytes, 6 sin bytes, crc
+};
+
+struct cordic_vec_t;
+struct cordic_vec_writer_t;
+
+/* Writer: records are appended in order and the header is finalized on close. Returns NULL or
+   -1 on I/O errors (errno is set). */
+cordic_vec_writer_t* cordic_vec_create(const char* path, unsigned long long seed, int seed_bits);
+int cordic_vec_append(cordic_vec_writer_t* w, const long long* theta, size_t n);
+int cordic_vec_close_writer(cordic_vec_writer_t* w);
+
+/* Fills one record from theta using the reference model of seed_bits */
+void cordic_vec_make_rec(long long theta, int seed_bits, cordic_vec_rec_t* rec);
+
+/* Reader (also DPI-C imports, cordic_vec.svh). cordic_vec_open() maps the file and validates
+   the header, printing the reason and returning NULL if it is not a usable vector file. */
+extern "C" cordic_vec_t* cordic_vec_open(const char* path);
+extern "C" void cordic_vec_close(cordic_vec_t* v);
+extern "C" long long cordic_vec_count(const cordic_vec_t* v);
+extern "C" int cordic_vec_seed_bits(const cordic_vec_t* v);
+
+/* Record by index, or NULL if index is out of range */
+const cordic_vec_rec_t* cordic_vec_get(const cordic_vec_t* v, long long index);
+
+/* DPI-C helpers. cordic_vec_theta() returns the theta of a record (0 if out of range).
+   cordic_vec_request() and cordic_vec_expected() write the request and the response of a record
+   as packed cordic_gref_batch() input (GREF_IN_MSG_LEN packets) and output (GREF_OUT_MSG_LEN
+   packets) messages. Both return 0, or -1 if index is out of range. */
+extern "C" long long cordic_vec_theta(const cordic_vec_t* v, long long index);
+extern "C" int cordic_vec_request(const cordic_vec_t* v, long long index, short int* o_msg);
+extern "C" int cordic_vec_expected(const cordic_vec_t* v, long long index, short int* o_msg);
+
+#endif
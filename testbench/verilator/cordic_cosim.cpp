@@ -0,0 +1,529 @@
+//
+// File:        cordic_cosim.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Verilator co-simulation regression harness for top_module. Runs the same constrained-
+//              random mix as cordic_vseq (SINGLE, BURST, VECTOR and DISABLE/ENABLE pairs under
+//              weighted arbitration, plus the directed SINGLEs and VECTORs) with STREAM messages
+//              (random mode, 1 to STREAM_RAND_CNT angles, then every mode with one angle and one
+//              with a count of 0 for STREAM_MAX_CNT angles) and a few SELFTEST runs mixed in, drives every packet onto i_rx one bit at a time at BAUD_RATE, samples
+//              o_tx mid-bit like uart_if, and checks each response packet against a
+//              cordic_gref_ctx model instance. As in cordic_driver, no response is expected for a
+//              SINGLE or BURST sent while the DUT is disabled.
+//
+//              --window N sends N requests back to back before collecting their responses (a
+//              SELFTEST still goes alone), the maximum-rate traffic of a pipelined host; STREAMs
+//              in the window fill the skid ahead of the pipelines fastest. Every seed's request
+//              timing is then replayed through the TX FIFO model (cordic_txfifo.h) for its peak
+//              FIFO and skid occupancy, and a seed fails if the DUT raises o_tx_overrun.
+//
+//              Each seed runs in its own VerilatedContext, so --jobs seeds run in parallel across
+//              cores. The model itself can also be multi-threaded with --threads at verilate time;
+//              keep jobs x threads within the core count. Reports transactions/sec per seed and in
+//              total, and exits non-zero on any mismatch, timeout, rx error or TX overrun. With the model built
+//              with -DCORDIC_GREF_PROFILE, --profile FILE writes its profile (cordic_gref_prof.h)
+//              for all seeds together.
+//
+//              Build (from testbench/verilator, Verilator 4.210 or later):
+//                  verilator --cc --exe --build -j 0 -O3 --threads 1 -Wno-fatal --top-module top_module
+//                      -GCLK_FREQ=100000000 -GBAUD_RATE=3000000 -GTX_FIFO_DEPTH=1024 -GCORDIC_LANES=1
+//                      -f cosim.f
+//                      -CFLAGS "-std=c++14 -O2 -DCORDIC_GREF_STANDALONE -I../../uvm_tb_hvl/subscriber"
+//                      -LDFLAGS -pthread -o cordic_cosim
+//              Run:    ./obj_dir/cordic_cosim [--seeds 8] [--seed 1] [--jobs N] [--single 100]
+//                      [--burst 100] [--stream 30] [--vector 100] [--dis-en 30] [--selftest 10]
+//                      [--window 1] [--profile FILE]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "verilated.h"
+#include "Vtop_module.h"
+
+#include "cordic_gref_const.h"
+#include "cordic_gref.h"
+#include "cordic_gref_prof.h"
+#include "cordic_txfifo.h"
+
+// Must match the -G overrides of the verilator command
+static const unsigned long long CLK_FREQ    = 100000000;
+static const unsigned long long BAUD_RATE   = 3000000;
+static const int FIFO_DEPTH                 = TX_FIFO_DEPTH;
+static const int CORDIC_LANES               = 1;    // lanes on i_clk (CORDIC_LANE_CLK_ASYNC = 0)
+
+static const int PACKET_BITS        = 11;
+static const int RESET_CYCLES       = 10;
+// Cycles a response may take to start after the request's last bit (CORDIC latency, a full TX
+// FIFO drain and a SELFTEST of SELFTEST_MAX_ANGLES are well inside this)
+static const long long RESPONSE_TIMEOUT = 200000;
+// Idle cycles waited after a request that gets no response, to catch an unexpected one
+static const long long QUIET_CYCLES     = 2000;
+static const int MAX_REPORTED       = 5;
+
+// cordic_vseq sequence priorities (SEQ_ARB_WEIGHTED)
+static const int WEIGHT_SINGLE      = 100;
+static const int WEIGHT_BURST       = 100;
+static const int WEIGHT_VECTOR      = 100;
+static const int WEIGHT_DIS_EN      = 30;
+static const int WEIGHT_SELFTEST    = 10;
+static const int WEIGHT_STREAM      = 30;
+// Angles per random STREAM message; the 16-bit thetas of a short one arrive faster than any other
+// message's and exercise the skid in front of the pipelines
+static const int STREAM_RAND_CNT    = 64;
+// Mode byte values: result width, round, theta width
+static const int STREAM_MODES       = 32;
+// Angles per SELFTEST run, kept short so the model's expected signature stays cheap
+static const int SELFTEST_MAX_ANGLES = 4096;
+
+struct cosim_cfg_t {
+    int         seeds           = 8;
+    unsigned    base_seed       = 1;
+    int         jobs            = 0;
+    int         num_single      = 100;
+    int         num_burst       = 100;
+    int         num_stream      = 30;
+    int         num_vector      = 100;
+    int         num_dis_en      = 30;
+    int         num_selftest    = 10;
+    int         window          = 1;
+};
+
+struct item_t {
+    unsigned char   cmd;
+    int             burst_cnt;      // angle count for CMD_SELFTEST and CMD_STREAM_TRANS
+    long long       theta[8];       // x and y for CMD_VECTOR_TRANS, the seed for CMD_SELFTEST
+    unsigned char   stream_mode;
+    std::vector<long long> stream_theta;
+};
+
+struct seed_result_t {
+    unsigned    seed;
+    long long   transactions;
+    long long   angles;
+    long long   cycles;
+    long long   mismatches;
+    long long   timeouts;
+    long long   rx_errs;
+    long long   overruns;
+    int         fifo_peak;      // TX FIFO model
+    int         skid_peak;
+    double      seconds;
+};
+
+/* Bit-level UART transmitter onto i_rx: packets back to back, one bit per baud period */
+class uart_line_driver {
+public:
+    void push(short int packet) { packets.push_back(packet); }
+    bool idle() const { return packets.empty() && bit < 0; }
+
+    // Level of the line for the next clock cycle
+    unsigned char tick() {
+        if (bit < 0) {
+            if (packets.empty())
+                return 1;
+            packet = packets.front();
+            packets.pop_front();
+            bit = 0;
+            phase = 0;
+        } else if ((phase += BAUD_RATE) >= CLK_FREQ) {
+            phase -= CLK_FREQ;
+            if (++bit == PACKET_BITS) {
+                bit = -1;
+                return tick();
+            }
+        }
+        return (packet >> bit) & 1;
+    }
+
+private:
+    std::deque<short int>   packets;
+    short int               packet = 0;
+    int                     bit = -1;
+    unsigned long long      phase = 0;
+};
+
+/* Bit-level UART receiver of o_tx: waits for a start bit edge and samples mid-bit */
+class uart_line_monitor {
+public:
+    std::vector<short int> packets;
+
+    bool busy() const { return bit >= 0; }
+
+    void tick(unsigned char line) {
+        if (bit < 0) {
+            if (prev && !line) {
+                bit = 0;
+                packet = 0;
+                phase = CLK_FREQ / 2;
+            }
+        } else if ((phase += BAUD_RATE) >= CLK_FREQ) {
+            phase -= CLK_FREQ;
+            packet |= (short int)((line & 1) << bit);
+            if (++bit == PACKET_BITS) {
+                packets.push_back(packet);
+                bit = -1;
+            }
+        }
+        prev = line;
+    }
+
+private:
+    short int               packet = 0;
+    int                     bit = -1;
+    unsigned long long      phase = 0;
+    unsigned char           prev = 1;
+};
+
+static short int packet_of(unsigned char data) {
+    short int packet = 0;
+    set_packet(&packet, data);
+    return packet;
+}
+
+/* cordic_vseq: single, burst, vector and disable/enable sequences (and ones of streams and
+   self-tests) started in parallel, one item granted at a time with probability proportional to the sequence priority */
+static std::vector<item_t> make_items(const cosim_cfg_t& cfg, std::mt19937_64& rng) {
+    static const long long ONE = 1LL << 46;
+    static const long long VECTOR_DIRECTED[5][2] = { {-ONE, 0}, {-ONE, -1}, {0, ONE}, {0, -ONE}, {0, 0} };
+    static const int NUM_SEQS = 6;
+    std::deque<item_t> seqs[NUM_SEQS];
+    std::uniform_int_distribution<long long> theta_dist(-PI_MULT_2, PI_MULT_2);
+    std::uniform_int_distribution<long long> xy_dist(-ONE, ONE);
+    std::uniform_int_distribution<int> cnt_dist(1, 8);
+    std::uniform_int_distribution<int> selftest_dist(1, SELFTEST_MAX_ANGLES);
+    std::uniform_int_distribution<long long> seed_dist(1, (1LL << 48) - 1);
+    std::uniform_int_distribution<int> mode_dist(0, 31);
+    std::uniform_int_distribution<int> stream_dist(1, STREAM_RAND_CNT);
+
+    for (int n = 0; n < cfg.num_single + 2; n++) {
+        item_t it = { CMD_SINGLE_TRANS, 1, {0} };
+        // Directed 2pi and -2pi after the random items
+        it.theta[0] = (n < cfg.num_single) ? theta_dist(rng) : (n == cfg.num_single) ? PI_MULT_2 : -PI_MULT_2;
+        seqs[0].push_back(it);
+    }
+    for (int n = 0; n < cfg.num_burst; n++) {
+        item_t it = { CMD_BURST_TRANS, cnt_dist(rng), {0} };
+        for (int j = 0; j < 8; j++)
+            it.theta[j] = theta_dist(rng);
+        seqs[1].push_back(it);
+    }
+    for (int n = 0; n < cfg.num_dis_en; n++) {
+        seqs[2].push_back({ CMD_DISABLE, 0, {0} });
+        seqs[2].push_back({ CMD_ENABLE, 0, {0} });
+    }
+    for (int n = 0; n < cfg.num_vector + 5; n++) {
+        item_t it = { CMD_VECTOR_TRANS, 0, {0} };
+        // Directed fold edges, y axis and origin after the random items
+        it.theta[0] = (n < cfg.num_vector) ? xy_dist(rng) : VECTOR_DIRECTED[n - cfg.num_vector][0];
+        it.theta[1] = (n < cfg.num_vector) ? xy_dist(rng) : VECTOR_DIRECTED[n - cfg.num_vector][1];
+        seqs[3].push_back(it);
+    }
+    for (int n = 0; n < cfg.num_selftest; n++) {
+        // The first run is a single angle, the rest random lengths
+        item_t it = { CMD_SELFTEST, n ? selftest_dist(rng) : 1, {0} };
+        it.theta[0] = seed_dist(rng);
+        seqs[4].push_back(it);
+    }
+    for (int n = 0; cfg.num_stream && n < cfg.num_stream + STREAM_MODES + 1; n++) {
+        // Directed single-angle messages of every mode and a full-length one after the random items
+        item_t it = { CMD_STREAM_TRANS, (n < cfg.num_stream) ? stream_dist(rng) :
+                                        (n < cfg.num_stream + STREAM_MODES) ? 1 : STREAM_MAX_CNT, {0} };
+        it.stream_mode = (unsigned char)((n >= cfg.num_stream && n < cfg.num_stream + STREAM_MODES)
+                                         ? n - cfg.num_stream : mode_dist(rng));
+        for (int j = 0; j < it.burst_cnt; j++)
+            it.stream_theta.push_back(theta_dist(rng));
+        seqs[5].push_back(it);
+    }
+
+    static const int WEIGHTS[NUM_SEQS] = { WEIGHT_SINGLE, WEIGHT_BURST, WEIGHT_DIS_EN, WEIGHT_VECTOR,
+                                           WEIGHT_SELFTEST, WEIGHT_STREAM };
+    std::vector<item_t> items;
+    for (;;) {
+        int total = 0;
+        for (int s = 0; s < NUM_SEQS; s++)
+            total += seqs[s].empty() ? 0 : WEIGHTS[s];
+        if (!total)
+            break;
+        int pick = std::uniform_int_distribution<int>(0, total - 1)(rng);
+        for (int s = 0; s < NUM_SEQS; s++) {
+            if (seqs[s].empty())
+                continue;
+            if (pick < WEIGHTS[s]) {
+                items.push_back(seqs[s].front());
+                seqs[s].pop_front();
+                break;
+            }
+            pick -= WEIGHTS[s];
+        }
+    }
+    return items;
+}
+
+/* Request packets of an item, in cordic_driver order */
+static std::vector<short int> request_packets(const item_t& it) {
+    std::vector<short int> req;
+    unsigned char crc_8 = 0;
+    auto put = [&](unsigned char b) {
+        req.push_back(packet_of(b));
+        crc_8_calc(&crc_8, b);
+    };
+
+    put(BYTE_HEADER);
+    put(it.cmd);
+    if (it.cmd == CMD_BURST_TRANS)
+        put((unsigned char)it.burst_cnt);
+    if (it.cmd == CMD_STREAM_TRANS) {
+        // The top theta bytes of each angle, as cordic_client sends them
+        int n = stream_theta_bytes(it.stream_mode);
+        put(it.stream_mode);
+        // STREAM_MAX_CNT goes as a count of 0
+        put((unsigned char)it.burst_cnt);
+        put((unsigned char)(it.burst_cnt >> 8));
+        for (long long theta : it.stream_theta)
+            for (int b = 6 - n; b < 6; b++)
+                put((unsigned char)(theta >> (8 * b)));
+    }
+    int words = (it.cmd == CMD_VECTOR_TRANS) ? 2 : (it.cmd == CMD_SELFTEST) ? 1 :
+                (it.cmd == CMD_DISABLE || it.cmd == CMD_ENABLE || it.cmd == CMD_STREAM_TRANS) ? 0 : it.burst_cnt;
+    for (int j = 0; j < words; j++)
+        for (int b = 0; b < 6; b++)
+            put((unsigned char)(it.theta[j] >> (8 * b)));
+    if (it.cmd == CMD_SELFTEST)
+        for (int b = 0; b < 4; b++)
+            put((unsigned char)(it.burst_cnt >> (8 * b)));
+    put(crc_8);
+    return req;
+}
+
+static std::mutex g_print_mutex;
+
+static seed_result_t run_seed(const cosim_cfg_t& cfg, unsigned seed) {
+    seed_result_t res = { seed, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0.0 };
+    std::mt19937_64 rng(seed);
+    std::vector<item_t> items = make_items(cfg, rng);
+
+    std::unique_ptr<VerilatedContext> ctx(new VerilatedContext);
+    ctx->randSeed((int)seed);
+    std::unique_ptr<Vtop_module> top(new Vtop_module(ctx.get(), "top_module"));
+    uart_line_driver drv;
+    uart_line_monitor mon;
+    unsigned char rx_err_prev = 0, rx_msg_err_prev = 0;
+    // Each seed has its own model instance, so the workers share no model state
+    std::unique_ptr<cordic_gref_ctx, void (*)(cordic_gref_ctx*)> gref(cordic_gref_ctx_create(0),
+                                                                       cordic_gref_ctx_destroy);
+    cordic_gref_ctx_set_lanes(gref.get(), CORDIC_LANES);
+    std::vector<short int> rsp(5 + 12*STREAM_MAX_CNT + 1);
+    // Every request and the cycle it was queued, for the TX FIFO model
+    std::vector<short int> sent;
+    std::vector<int> sent_len;
+    std::vector<long long> sent_cycle;
+
+    auto cycle = [&]() {
+        top->i_rx = drv.tick();
+        top->i_clk = top->i_lane_clk = 0;
+        top->eval();
+        ctx->timeInc(5);
+        top->i_clk = top->i_lane_clk = 1;
+        top->eval();
+        ctx->timeInc(5);
+        mon.tick(top->o_tx);
+        res.rx_errs += (top->o_rx_err && !rx_err_prev) + (top->o_rx_msg_err && !rx_msg_err_prev);
+        rx_err_prev     = top->o_rx_err;
+        rx_msg_err_prev = top->o_rx_msg_err;
+        res.cycles++;
+    };
+
+    auto report = [&](const char* what, long long n, const item_t& it) {
+        if (res.mismatches + res.timeouts > MAX_REPORTED)
+            return;
+        std::lock_guard<std::mutex> lock(g_print_mutex);
+        printf("seed %u transaction %lld (cmd 0x%02x cnt %d): %s\n", seed, n, it.cmd, it.burst_cnt, what);
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    top->i_rst_n = 0;
+    for (int i = 0; i < RESET_CYCLES; i++)
+        cycle();
+    top->i_rst_n = 1;
+    for (int i = 0; i < RESET_CYCLES; i++)
+        cycle();
+
+    for (long long n = 0, end; n < (long long)items.size(); n = end) {
+        const item_t& it = items[n];
+        // A window of requests back to back; the self-test owns the CORDIC, so it goes alone
+        end = n + 1;
+        if (it.cmd != CMD_SELFTEST)
+            while (end < (long long)items.size() && end - n < cfg.window && items[end].cmd != CMD_SELFTEST)
+                end++;
+        std::vector<short int> expected;
+        for (long long k = n; k < end; k++) {
+            std::vector<short int> req = request_packets(items[k]);
+            for (short int p : req)
+                drv.push(p);
+            int len = cordic_gref_ctx_process(gref.get(), (int)req.size(), req.data(), rsp.data());
+            expected.insert(expected.end(), rsp.begin(), rsp.begin() + len);
+            sent.insert(sent.end(), req.begin(), req.end());
+            sent_len.push_back((int)req.size());
+            sent_cycle.push_back(res.cycles);
+        }
+
+        // Send the request while collecting the response, as the driver's fork/join does
+        mon.packets.clear();
+        while (!drv.idle())
+            cycle();
+        // The timeout bounds the idle gap before and between response packets
+        long long idle = 0;
+        size_t seen = 0;
+        for (;;) {
+            if (!mon.busy() && (expected.empty() ? idle >= QUIET_CYCLES
+                                                 : mon.packets.size() >= expected.size()))
+                break;
+            if (idle >= RESPONSE_TIMEOUT)
+                break;
+            cycle();
+            idle = (mon.busy() || mon.packets.size() != seen) ? 0 : idle + 1;
+            seen = mon.packets.size();
+        }
+
+        if (mon.packets.size() < expected.size()) {
+            res.timeouts++;
+            report("response timed out", n, it);
+        } else if (mon.packets != expected) {
+            res.mismatches++;
+            for (size_t k = 0; k < std::max(mon.packets.size(), expected.size()); k++) {
+                short int got = k < mon.packets.size() ? mon.packets[k] : -1;
+                short int exp = k < expected.size() ? expected[k] : -1;
+                if (got != exp) {
+                    char what[96];
+                    snprintf(what, sizeof(what), "packet %zu is 0x%03x, expected 0x%03x (%zu of %zu received)",
+                             k, got & 0x7ff, exp & 0x7ff, mon.packets.size(), expected.size());
+                    report(what, n, it);
+                    break;
+                }
+            }
+        }
+        for (long long k = n; k < end; k++) {
+            res.transactions++;
+            if (items[k].cmd == CMD_SINGLE_TRANS || items[k].cmd == CMD_BURST_TRANS
+                || items[k].cmd == CMD_STREAM_TRANS || items[k].cmd == CMD_SELFTEST)
+                res.angles += items[k].burst_cnt;
+        }
+    }
+    if (top->o_tx_overrun) {
+        res.overruns++;
+        report("o_tx_overrun set", (long long)items.size() - 1, items.back());
+    }
+
+    cordic_txfifo_cfg_t fifo_cfg;
+    fifo_cfg.clk_freq   = CLK_FREQ;
+    fifo_cfg.baud_rate  = BAUD_RATE;
+    fifo_cfg.depth      = FIFO_DEPTH;
+    fifo_cfg.lanes      = CORDIC_LANES;
+    cordic_txfifo_stats_t fifo;
+    cordic_txfifo_run(&fifo_cfg, (int)sent_len.size(), sent_len.data(), sent.data(), sent_cycle.data(), &fifo);
+    res.fifo_peak = fifo.peak_count;
+    res.skid_peak = fifo.skid_peak;
+
+    top->final();
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
+
+static int usage(const char* prog) {
+    fprintf(stderr, "Usage: %s [--seeds N] [--seed S] [--jobs N] [--single N] [--burst N] [--stream N]"
+                    " [--vector N] [--dis-en N] [--selftest N] [--window N] [--profile FILE]\n", prog);
+    return 2;
+}
+
+int main(int argc, char** argv) {
+    cosim_cfg_t cfg;
+    const char* profile = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--seeds") && i + 1 < argc)
+            cfg.seeds = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            cfg.base_seed = (unsigned)strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--jobs") && i + 1 < argc)
+            cfg.jobs = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--single") && i + 1 < argc)
+            cfg.num_single = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--burst") && i + 1 < argc)
+            cfg.num_burst = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--stream") && i + 1 < argc)
+            cfg.num_stream = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--vector") && i + 1 < argc)
+            cfg.num_vector = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--dis-en") && i + 1 < argc)
+            cfg.num_dis_en = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--selftest") && i + 1 < argc)
+            cfg.num_selftest = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--window") && i + 1 < argc)
+            cfg.window = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--profile") && i + 1 < argc)
+            profile = argv[++i];
+        else
+            return usage(argv[0]);
+    }
+    if (cfg.seeds < 1 || cfg.num_single < 0 || cfg.num_burst < 0 || cfg.num_stream < 0 || cfg.num_vector < 0
+        || cfg.num_dis_en < 0 || cfg.num_selftest < 0 || cfg.window < 1)
+        return usage(argv[0]);
+    if (cfg.jobs < 1)
+        cfg.jobs = std::max(1u, std::thread::hardware_concurrency());
+    cfg.jobs = std::min(cfg.jobs, cfg.seeds);
+
+    std::vector<seed_result_t> results(cfg.seeds);
+    std::atomic<int> next(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int j = 0; j < cfg.jobs; j++)
+        workers.emplace_back([&]() {
+            for (int s; (s = next++) < cfg.seeds; ) {
+                results[s] = run_seed(cfg, cfg.base_seed + s);
+                const seed_result_t& r = results[s];
+                std::lock_guard<std::mutex> lock(g_print_mutex);
+                printf("seed %-6u %6lld transactions %7lld angles %11lld cycles %8.2f s %8.1f trans/s "
+                       "%5.2f Mcycles/s fifo peak %4d  %s\n", r.seed, r.transactions, r.angles, r.cycles,
+                       r.seconds, r.transactions / r.seconds, r.cycles / r.seconds / 1e6, r.fifo_peak,
+                       (r.mismatches || r.timeouts || r.rx_errs || r.overruns) ? "FAIL" : "PASS");
+                fflush(stdout);
+            }
+        });
+    for (std::thread& w : workers)
+        w.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    seed_result_t total = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0.0 };
+    for (const seed_result_t& r : results) {
+        total.transactions += r.transactions;
+        total.angles       += r.angles;
+        total.cycles       += r.cycles;
+        total.mismatches   += r.mismatches;
+        total.timeouts     += r.timeouts;
+        total.rx_errs      += r.rx_errs;
+        total.overruns     += r.overruns;
+        total.fifo_peak     = std::max(total.fifo_peak, r.fifo_peak);
+        total.skid_peak     = std::max(total.skid_peak, r.skid_peak);
+    }
+    printf("\n%d seeds on %d jobs: %lld transactions (%lld angles) in %.2f s, %.1f trans/s, %.2f Mcycles/s\n",
+           cfg.seeds, cfg.jobs, total.transactions, total.angles, seconds, total.transactions / seconds,
+           total.cycles / seconds / 1e6);
+    bool fail = total.mismatches || total.timeouts || total.rx_errs || total.overruns;
+    printf("TX FIFO peak %d of %d bytes, skid peak %d of %d angles (model)\n", total.fifo_peak, FIFO_DEPTH,
+           total.skid_peak, TX_SKID_DEPTH);
+    printf("mismatches %lld, timeouts %lld, rx errors %lld, tx overruns %lld: %s\n", total.mismatches,
+           total.timeouts, total.rx_errs, total.overruns, fail ? "FAIL" : "PASS");
+    if (profile && !cordic_gref_prof_dump(profile))
+        fprintf(stderr, "%s not written (model built without -DCORDIC_GREF_PROFILE?)\n", profile);
+    return fail ? 1 : 0;
+}
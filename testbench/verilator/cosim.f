@@ -0,0 +1,32 @@
+//
+// File:        cosim.f
+// Author:      agent
+// Date:        10/2026
+// Description: Verilator co-simulation file list (see cordic_cosim.cpp for the build command)
+//
+
+../../hdl/cordic_sincos/pkg_cordic_sincos.sv
+../../hdl/cordic_sincos/cordic_sincos_preprocess.sv
+../../hdl/cordic_sincos/cordic_sincos_stage.sv
+../../hdl/cordic_sincos/cordic_sincos_seed.sv
+../../hdl/cordic_sincos/cordic_sincos.sv
+../../hdl/cordic_sincos/cordic_lanes.sv
+../../hdl/cordic_sincos/cordic_vectoring_stage.sv
+../../hdl/cordic_sincos/cordic_vectoring.sv
+../../hdl/utils/lfsr.sv
+../../hdl/utils/bram.sv
+../../hdl/utils/sync_fifo.sv
+../../hdl/utils/async_fifo.sv
+../../hdl/utils/uart_rx.sv
+../../hdl/utils/uart_tx.sv
+../../hdl/utils/pkg_msg.sv
+../../hdl/utils/cordic_selftest.sv
+../../hdl/utils/uart_rx_msg.sv
+../../hdl/utils/uart_tx_msg.sv
+../../hdl/utils/top_module.sv
+cordic_cosim.cpp
+../uvm_tb_hvl/subscriber/cordic_gref.cpp
+../uvm_tb_hvl/subscriber/cordic_sincos_simd.cpp
+../uvm_tb_hvl/subscriber/cordic_crc8.cpp
+../uvm_tb_hvl/subscriber/cordic_gref_prof.cpp
+../uvm_tb_hvl/subscriber/cordic_txfifo.cpp
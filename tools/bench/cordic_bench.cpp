@@ -0,0 +1,284 @@
+//
+// File:        cordic_bench.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Benchmarks of the reference model hot paths: ns/angle of the CORDIC kernels,
+//              ns/byte of the packet and CRC-8 helpers, and ns/message of cordic_gref() for
+//              SINGLE and for BURST at every burst cnt. Results are written as JSON so runs on
+//              different revisions can be compared.
+//
+//              Every case is timed over --reps runs of at least --min-ms each; the JSON holds
+//              the minimum and the median of the runs.
+//
+//              Build (from tools/bench):
+//                  g++ -std=c++14 -O2 -DCORDIC_GREF_STANDALONE -I../../testbench/uvm_tb_hvl/subscriber
+//                      cordic_bench.cpp ../../testbench/uvm_tb_hvl/subscriber/cordic_gref.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_sincos_simd.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_sincos_param.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_crc8.cpp -o cordic_bench
+//              Run:    ./cordic_bench [--out results.json] [--label rev] [--reps 7] [--min-ms 50]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cordic_gref_const.h"
+#include "cordic_gref.h"
+#include "cordic_crc8.h"
+#include "cordic_sincos_param.h"
+
+static const int NUM_INPUTS = 4096;     // inputs cycled through by every case
+
+struct bench_result_t {
+    std::string group;
+    std::string name;
+    std::string unit;                   // what one op is: angle, byte or msg
+    double      ns_min;
+    double      ns_median;
+    long long   ops;                    // ops per timed run
+};
+
+static int      g_reps      = 7;
+static double   g_min_ms    = 50.0;
+static volatile long long g_sink;
+
+/* Times body(ops) and returns ns per op. ops is grown until one run lasts at least g_min_ms. */
+static bench_result_t run_case(const char* group, const char* name, const char* unit,
+                               const std::function<long long(long long)>& body) {
+    typedef std::chrono::steady_clock clk;
+    long long ops = 1024;
+    while (true) {
+        clk::time_point t0 = clk::now();
+        g_sink = body(ops);
+        double ms = std::chrono::duration<double, std::milli>(clk::now() - t0).count();
+        if (ms >= g_min_ms)
+            break;
+        ops = (ms < g_min_ms / 16) ? ops * 16 : (long long)(ops * 1.2 * g_min_ms / ms);
+    }
+
+    std::vector<double> ns;
+    for (int r = 0; r < g_reps; r++) {
+        clk::time_point t0 = clk::now();
+        g_sink = body(ops);
+        ns.push_back(std::chrono::duration<double, std::nano>(clk::now() - t0).count() / ops);
+    }
+    std::sort(ns.begin(), ns.end());
+
+    bench_result_t res = { group, name, unit, ns.front(), ns[ns.size() / 2], ops };
+    fprintf(stderr, "%-10s %-28s %10.2f ns/%s\n", group, name, res.ns_median, unit);
+    return res;
+}
+
+/* Random thetas over the full input range [-2pi, 2pi] */
+static std::vector<long long> make_thetas(std::mt19937_64& rng) {
+    std::vector<long long> theta(NUM_INPUTS);
+    for (long long& t : theta)
+        t = (long long)(rng() % (2 * PI_MULT_2 + 1)) - PI_MULT_2;
+    return theta;
+}
+
+/* One well-formed request in cordic_gref() argument form */
+struct gref_msg_t {
+    short int header, cmd, burst_cnt, crc_8;
+    short int theta[48];
+};
+
+static gref_msg_t make_msg(unsigned char cmd, int burst_cnt, const long long* theta) {
+    gref_msg_t m;
+    unsigned char crc = 0;
+    memset(&m, 0, sizeof(m));
+    set_packet(&m.header, BYTE_HEADER);
+    crc_8_calc(&crc, BYTE_HEADER);
+    set_packet(&m.cmd, cmd);
+    crc_8_calc(&crc, cmd);
+    if (cmd == CMD_BURST_TRANS) {
+        set_packet(&m.burst_cnt, (unsigned char)burst_cnt);
+        crc_8_calc(&crc, (unsigned char)burst_cnt);
+    }
+    for (int j = 0; j < burst_cnt; j++)
+        set_packets(m.theta + 6*j, (const unsigned char*)(theta + j), 6, &crc);
+    set_packet(&m.crc_8, crc);
+    return m;
+}
+
+static void write_json(FILE* f, const char* label, const std::vector<bench_result_t>& results) {
+    fprintf(f, "{\n");
+    fprintf(f, "  \"label\": \"%s\",\n", label);
+    fprintf(f, "  \"compiler\": \"%s\",\n", __VERSION__);
+    fprintf(f, "  \"reps\": %d,\n", g_reps);
+    fprintf(f, "  \"min_ms\": %.1f,\n", g_min_ms);
+    fprintf(f, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const bench_result_t& r = results[i];
+        fprintf(f, "    {\"group\": \"%s\", \"name\": \"%s\", \"unit\": \"%s\", "
+                   "\"ns_min\": %.3f, \"ns_median\": %.3f, \"ops\": %lld}%s\n",
+                r.group.c_str(), r.name.c_str(), r.unit.c_str(), r.ns_min, r.ns_median, r.ops,
+                (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+    const char* out_path = NULL;
+    const char* label = "";
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--out") && i + 1 < argc)
+            out_path = argv[++i];
+        else if (!strcmp(argv[i], "--label") && i + 1 < argc)
+            label = argv[++i];
+        else if (!strcmp(argv[i], "--reps") && i + 1 < argc)
+            g_reps = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--min-ms") && i + 1 < argc)
+            g_min_ms = std::max(1.0, atof(argv[++i]));
+        else {
+            fprintf(stderr, "Usage: %s [--out results.json] [--label rev] [--reps N] [--min-ms MS]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::mt19937_64 rng(1);
+    std::vector<long long> theta = make_thetas(rng);
+    std::vector<unsigned char> bytes(NUM_INPUTS);
+    std::vector<short int> packets(NUM_INPUTS);
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        bytes[i] = (unsigned char)rng();
+        set_packet(&packets[i], bytes[i]);
+    }
+    std::vector<bench_result_t> results;
+
+    // CORDIC kernels, ns/angle
+    results.push_back(run_case("cordic", "cordic_sincos", "angle", [&](long long ops) {
+        long long acc = 0, x, y;
+        for (long long i = 0; i < ops; i++) {
+            cordic_sincos(&theta[i % NUM_INPUTS], &x, &y);
+            acc += x ^ y;
+        }
+        return acc;
+    }));
+    results.push_back(run_case("cordic", "cordic_sincos<48,48>", "angle", [&](long long ops) {
+        long long acc = 0, x, y;
+        for (long long i = 0; i < ops; i++) {
+            cordic_sincos<48, 48>(theta[i % NUM_INPUTS], &x, &y);
+            acc += x ^ y;
+        }
+        return acc;
+    }));
+    results.push_back(run_case("cordic", "cordic_sincos<48,48> capture", "angle", [&](long long ops) {
+        long long acc = 0, x, y, sx[48], sy[48], sz[48];
+        signed char dir[48];
+        cordic_stage_capture_t cap = { sx, sy, sz, dir, 1 };
+        for (long long i = 0; i < ops; i++) {
+            cordic_sincos<48, 48>(theta[i % NUM_INPUTS], &x, &y, &cap);
+            acc += x ^ sz[i % 48];
+        }
+        return acc;
+    }));
+    struct { const char* name; void (*fn)(const long long*, long long*, long long*, int); bool ok; } kernels[] = {
+        { "cordic_sincos_burst",        cordic_sincos_burst,        true },
+        { "cordic_sincos_burst_scalar", cordic_sincos_burst_scalar, true },
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+        { "cordic_sincos_burst_avx2",   cordic_sincos_burst_avx2,   __builtin_cpu_supports("avx2") != 0 },
+        { "cordic_sincos_burst_avx512", cordic_sincos_burst_avx512, __builtin_cpu_supports("avx512f") != 0 },
+#endif
+    };
+    for (auto& k : kernels) {
+        if (!k.ok)
+            continue;
+        results.push_back(run_case("cordic", k.name, "angle", [&](long long ops) {
+            long long acc = 0, x[8], y[8];
+            for (long long i = 0; i < ops; i += 8) {
+                k.fn(&theta[i % NUM_INPUTS], x, y, 8);
+                acc += x[0] ^ y[7];
+            }
+            return acc;
+        }));
+    }
+
+    // Packet and CRC-8 helpers, ns/byte
+    results.push_back(run_case("packet", "crc_8_calc", "byte", [&](long long ops) {
+        unsigned char crc = 0;
+        for (long long i = 0; i < ops; i++)
+            crc_8_calc(&crc, bytes[i % NUM_INPUTS]);
+        return (long long)crc;
+    }));
+    results.push_back(run_case("packet", "crc_8_block", "byte", [&](long long ops) {
+        unsigned char crc = 0;
+        for (long long i = 0; i < ops; i += NUM_INPUTS)
+            crc = crc_8_block(crc, bytes.data(), NUM_INPUTS);
+        return (long long)crc;
+    }));
+    results.push_back(run_case("packet", "parity_calc", "byte", [&](long long ops) {
+        long long acc = 0;
+        for (long long i = 0; i < ops; i++)
+            acc += parity_calc(bytes[i % NUM_INPUTS]);
+        return acc;
+    }));
+    results.push_back(run_case("packet", "extract_packet", "byte", [&](long long ops) {
+        long long acc = 0;
+        bool start, parity, stop;
+        unsigned char data;
+        for (long long i = 0; i < ops; i++) {
+            extract_packet(packets[i % NUM_INPUTS], &start, &data, &parity, &stop);
+            acc += data + start + parity + stop;
+        }
+        return acc;
+    }));
+    results.push_back(run_case("packet", "set_packet", "byte", [&](long long ops) {
+        long long acc = 0;
+        short int p;
+        for (long long i = 0; i < ops; i++) {
+            set_packet(&p, bytes[i % NUM_INPUTS]);
+            acc += p;
+        }
+        return acc;
+    }));
+    results.push_back(run_case("packet", "crc_8_packets", "byte", [&](long long ops) {
+        unsigned char crc = 0, data[NUM_INPUTS];
+        long long acc = 0;
+        for (long long i = 0; i < ops; i += NUM_INPUTS)
+            acc += crc_8_packets(packets.data(), NUM_INPUTS, data, &crc);
+        return acc + crc;
+    }));
+
+    // Full message encode/decode through cordic_gref(), ns/msg
+    std::vector<gref_msg_t> msgs;
+    for (int burst_cnt = 0; burst_cnt <= 8; burst_cnt++) {
+        const int num_msgs = 256;
+        msgs.clear();
+        for (int m = 0; m < num_msgs; m++) {
+            const long long* t = &theta[(m * 8) % (NUM_INPUTS - 8)];
+            msgs.push_back(burst_cnt ? make_msg(CMD_BURST_TRANS, burst_cnt, t)
+                                     : make_msg(CMD_SINGLE_TRANS, 1, t));
+        }
+        std::string name = burst_cnt ? "burst_" + std::to_string(burst_cnt) : "single";
+        results.push_back(run_case("cordic_gref", name.c_str(), "msg", [&](long long ops) {
+            short int o_header, o_cmd, o_burst_cnt, o_crc_8, o_cos[48], o_sin[48];
+            char disabled = 0;
+            long long acc = 0;
+            for (long long i = 0; i < ops; i++) {
+                const gref_msg_t& m = msgs[i % num_msgs];
+                cordic_gref(m.header, m.cmd, m.burst_cnt, m.theta, m.crc_8, &disabled,
+                            &o_header, &o_cmd, &o_burst_cnt, o_cos, o_sin, &o_crc_8);
+                acc += o_crc_8;
+            }
+            return acc;
+        }));
+    }
+
+    FILE* f = out_path ? fopen(out_path, "w") : stdout;
+    if (!f) {
+        perror(out_path);
+        return 1;
+    }
+    write_json(f, label, results);
+    if (out_path)
+        fclose(f);
+    return 0;
+}
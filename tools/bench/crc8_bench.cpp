@@ -0,0 +1,124 @@
+//
+// File:        crc8_bench.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Microbenchmark of the CRC-8/parity engine against the bit-serial implementation
+//              it replaced. Reports bytes/sec for raw byte streams and for runs of 11-bit UART
+//              packets (framing check + data extraction + CRC).
+//
+//              Build (from tools/bench):
+//                  g++ -std=c++14 -O2 -DCORDIC_GREF_STANDALONE -I../../testbench/uvm_tb_hvl/subscriber
+//                      crc8_bench.cpp ../../testbench/uvm_tb_hvl/subscriber/cordic_crc8.cpp -o crc8_bench
+//              Run:    ./crc8_bench [num_bytes]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+
+#include "cordic_crc8.h"
+
+/* Bit-loop odd parity, as previously used by the model */
+static bool parity_serial(unsigned char i_data_frame) {
+    bool parity = 1;
+    for (int i = 0; i < 8; i++) {
+        parity ^= (i_data_frame & 1);
+        i_data_frame >>= 1;
+    }
+    return parity;
+}
+
+/* Packet-by-packet framing check, as previously done per field in cordic_gref() */
+static bool crc_8_packets_serial(const short int* packets, size_t n, unsigned char* data, unsigned char* crc_8) {
+    bool ok = true;
+    for (size_t i = 0; i < n; i++) {
+        bool start  = packets[i] & 1;
+        data[i]     = (packets[i] >> 1) & 0xff;
+        bool parity = (packets[i] >> 9) & 1;
+        bool stop   = (packets[i] >> 10) & 1;
+        (*crc_8)    = crc_8_serial(*crc_8, data + i, 1);
+        ok &= (!start && (parity_serial(data[i]) == parity) && stop);
+    }
+    return ok;
+}
+
+template <typename F>
+static double time_it(F f, int reps) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; r++)
+        f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count();
+}
+
+static void report(const char* name, double secs, size_t bytes) {
+    printf("  %-28s %10.1f MB/s\n", name, bytes / secs / 1e6);
+}
+
+int main(int argc, char** argv) {
+    size_t len = (argc > 1) ? strtoull(argv[1], NULL, 0) : (1 << 20);
+    const int reps = 20;
+
+    std::vector<unsigned char> data(len), scratch(len);
+    std::vector<short int> packets(len);
+    unsigned int seed = 1;
+    for (size_t i = 0; i < len; i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = seed >> 16;
+    }
+    unsigned char crc_init = 0;
+    set_packets(packets.data(), data.data(), len, &crc_init);
+
+    /* Cross-check every implementation before timing */
+    unsigned char c_serial = crc_8_serial(0, data.data(), len);
+    unsigned char c_byte = 0;
+    for (size_t i = 0; i < len; i++)
+        c_byte = crc_8_byte(c_byte, data[i]);
+    unsigned char c_block = crc_8_block(0, data.data(), len);
+    unsigned char c_pkt = 0, c_pkt_serial = 0;
+    bool ok = crc_8_packets(packets.data(), len, scratch.data(), &c_pkt);
+    ok &= crc_8_packets_serial(packets.data(), len, scratch.data(), &c_pkt_serial);
+    for (int b = 0; b < 256; b++)
+        ok &= (parity_odd(b) == parity_serial(b));
+    if (!ok || c_serial != c_byte || c_serial != c_block || c_serial != c_pkt || c_serial != c_pkt_serial) {
+        printf("CRC-8 implementations disagree.\n");
+        return 1;
+    }
+
+    volatile unsigned char sink = 0;
+    size_t total = len * reps;
+    printf("CRC-8 over %zu bytes x %d reps (crc = 0x%02x)\n", len, reps, c_serial);
+
+    report("bytes: bit-serial", time_it([&] { sink = crc_8_serial(0, data.data(), len); }, reps), total);
+    report("bytes: table", time_it([&] {
+        unsigned char c = 0;
+        for (size_t i = 0; i < len; i++)
+            c = crc_8_byte(c, data[i]);
+        sink = c;
+    }, reps), total);
+    report("bytes: slice-by-4", time_it([&] { sink = crc_8_block(0, data.data(), len); }, reps), total);
+    report("packets: per-field serial", time_it([&] {
+        unsigned char c = 0;
+        sink = crc_8_packets_serial(packets.data(), len, scratch.data(), &c) + c;
+    }, reps), total);
+    report("packets: one pass", time_it([&] {
+        unsigned char c = 0;
+        sink = crc_8_packets(packets.data(), len, scratch.data(), &c) + c;
+    }, reps), total);
+    report("parity: bit loop", time_it([&] {
+        unsigned char p = 0;
+        for (size_t i = 0; i < len; i++)
+            p ^= parity_serial(data[i]);
+        sink = p;
+    }, reps), total);
+    report("parity: popcount", time_it([&] {
+        unsigned char p = 0;
+        for (size_t i = 0; i < len; i++)
+            p ^= parity_odd(data[i]);
+        sink = p;
+    }, reps), total);
+
+    (void)sink;
+    return 0;
+}
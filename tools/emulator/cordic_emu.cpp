@@ -0,0 +1,518 @@
+//
+// File:        cordic_emu.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Software emulator of the CORDIC-UART device on a Linux pseudo-terminal, for load
+//              testing clients without an Arty-A7. Requests are answered by the C++ golden
+//              reference model (cordic_gref), so the emulator speaks the same protocol the UVM
+//              testbench checks: header 0x5a, SINGLE/BURST/STREAM/DISABLE/ENABLE, CRC-8, and the
+//              header + CMD_ERR (0x01) + CRC response for malformed messages.
+//
+//              Threads: one RX thread reads the pty, frames messages and tracks the DISABLE state,
+//              a pool of workers evaluates the model, and one TX thread writes responses back in
+//              request order. In paced mode (default) bytes are timed as on the real link:
+//              11 bits per byte at --baud in both directions, and a response starts --latency
+//              clock cycles after the angle it depends on has been received. --unpaced answers
+//              as fast as the host can read.
+//
+//              Build (from tools/emulator):
+//                  g++ -std=c++14 -O2 -pthread -DCORDIC_GREF_STANDALONE -I../../testbench/uvm_tb_hvl/subscriber
+//                      cordic_emu.cpp ../../testbench/uvm_tb_hvl/subscriber/cordic_gref.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_sincos_simd.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_crc8.cpp -o cordic_emu
+//              Run:    ./cordic_emu [--link /tmp/cordic0] [--unpaced] [--baud 3000000]
+//                                   [--clk 100000000] [--latency 48] [--workers N]
+//              Then point the client at the printed /dev/pts/N (or the --link path).
+//
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cordic_gref_const.h"
+#include "cordic_gref.h"
+#include "cordic_crc8.h"
+
+static const int BITS_PER_BYTE = 11;    // start, 8 data, parity, stop
+
+struct emu_cfg_t {
+    bool        paced           = true;
+    double      baud            = 3000000.0;
+    double      clk_hz          = 100000000.0;
+    int         latency_cycles  = 48;
+    int         workers         = 0;
+    const char* link            = NULL;
+};
+
+/* One framed request. t_resp is the time the device would begin its response. */
+struct request_t {
+    unsigned long               seq;
+    std::vector<unsigned char>  bytes;
+    char                        disabled;
+    long long                   t_resp;
+};
+
+struct response_t {
+    std::vector<unsigned char>  bytes;
+    long long                   t_resp;
+};
+
+struct emu_stats_t {
+    std::atomic<unsigned long> requests {0};
+    std::atomic<unsigned long> angles {0};
+    std::atomic<unsigned long> responses {0};
+    std::atomic<unsigned long> err_responses {0};
+    std::atomic<unsigned long> silent {0};          // SINGLE/BURST/STREAM while disabled
+    std::atomic<unsigned long> dropped_bytes {0};   // discarded while hunting for a header
+    std::atomic<unsigned long> rx_bytes {0};
+    std::atomic<unsigned long> tx_bytes {0};
+};
+
+static std::atomic<bool> g_stop {false};
+static emu_cfg_t    g_cfg;
+static emu_stats_t  g_stats;
+static int          g_master = -1;
+static long long    g_byte_ns = 0;
+static long long    g_latency_ns = 0;
+
+/* Work queue between the RX thread and the workers */
+static std::mutex               g_req_mtx;
+static std::condition_variable  g_req_cv;
+static std::deque<request_t>    g_req_q;
+
+/* Reorder buffer between the workers and the TX thread */
+static std::mutex                           g_resp_mtx;
+static std::condition_variable              g_resp_cv;
+static std::map<unsigned long, response_t>  g_resp_q;
+
+static long long now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void sleep_until_ns(long long t) {
+    struct timespec ts;
+    ts.tv_sec  = t / 1000000000LL;
+    ts.tv_nsec = t % 1000000000LL;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR && !g_stop) {}
+}
+
+static void on_signal(int) {
+    g_stop = true;
+}
+
+static void submit(request_t& req) {
+    g_stats.requests++;
+    {
+        std::lock_guard<std::mutex> lock(g_req_mtx);
+        g_req_q.push_back(std::move(req));
+    }
+    g_req_cv.notify_one();
+}
+
+/* Frames messages the way uart_rx_msg does (hunt for the header, then cmd, burst cnt or stream
+   mode and count, thetas, crc). Messages the model rejects before their end (bad cmd or burst cnt) are handed over as
+   soon as that byte arrives, and framing restarts at the next header. */
+static void rx_thread() {
+    enum { RX_HEADER, RX_CMD, RX_BURST_CNT, RX_STREAM_MODE, RX_STREAM_CNT, RX_STREAM_CNT_II,
+           RX_THETA, RX_CRC } state = RX_HEADER;
+    unsigned long seq = 0;
+    char disabled = 0;
+    int theta_left = 0, theta_cnt = 0, theta_bytes = 6;
+    long long t_line = 0;
+    request_t req;
+    unsigned char buf[4096];
+
+    while (!g_stop) {
+        struct pollfd pfd = { g_master, POLLIN, 0 };
+        int rc = poll(&pfd, 1, 100);
+        if (rc <= 0)
+            continue;
+        ssize_t n = read(g_master, buf, sizeof(buf));
+        if (n <= 0) {
+            if (n < 0 && errno != EAGAIN && errno != EINTR && errno != EIO)
+                perror("read");
+            continue;
+        }
+        long long t_read = now_ns();
+        g_stats.rx_bytes += n;
+
+        for (ssize_t i = 0; i < n; i++) {
+            unsigned char b = buf[i];
+
+            // Time at which the stop bit of this byte has been received
+            long long t_rx = g_cfg.paced ? std::max(t_line, t_read) + g_byte_ns : t_read;
+            t_line = t_rx;
+
+            bool done = false;
+            switch (state) {
+                case RX_HEADER:
+                    if (b != BYTE_HEADER) {
+                        g_stats.dropped_bytes++;
+                        break;
+                    }
+                    req.bytes.clear();
+                    req.bytes.push_back(b);
+                    req.disabled = disabled;
+                    state = RX_CMD;
+                    break;
+                case RX_CMD:
+                    req.bytes.push_back(b);
+                    theta_bytes = 6;
+                    if (b == CMD_SINGLE_TRANS) {
+                        theta_left = 6;
+                        theta_cnt = 0;
+                        state = RX_THETA;
+                    } else if (b == CMD_BURST_TRANS) {
+                        state = RX_BURST_CNT;
+                    } else if (b == CMD_STREAM_TRANS) {
+                        state = RX_STREAM_MODE;
+                    } else if (b == CMD_DISABLE || b == CMD_ENABLE) {
+                        // uart_tx_msg starts the acknowledgement as soon as the cmd is decoded
+                        req.t_resp = t_rx + 2 * (long long)(1e9 / g_cfg.clk_hz);
+                        state = RX_CRC;
+                    } else {
+                        req.t_resp = t_rx + g_latency_ns;
+                        done = true;
+                    }
+                    break;
+                case RX_BURST_CNT:
+                    req.bytes.push_back(b);
+                    if (b >= 1 && b <= 8) {
+                        theta_left = 6 * b;
+                        theta_cnt = 0;
+                        state = RX_THETA;
+                    } else {
+                        req.t_resp = t_rx + g_latency_ns;
+                        done = true;
+                    }
+                    break;
+                case RX_STREAM_MODE:
+                    req.bytes.push_back(b);
+                    theta_bytes = stream_theta_bytes(b);
+                    state = RX_STREAM_CNT;
+                    break;
+                case RX_STREAM_CNT:
+                    req.bytes.push_back(b);
+                    state = RX_STREAM_CNT_II;
+                    break;
+                case RX_STREAM_CNT_II: {
+                    req.bytes.push_back(b);
+                    int cnt = req.bytes[3] | (b << 8);
+                    theta_left = theta_bytes * (cnt ? cnt : STREAM_MAX_CNT);
+                    theta_cnt = 0;
+                    state = RX_THETA;
+                    break;
+                }
+                case RX_THETA:
+                    req.bytes.push_back(b);
+                    // The response header goes out once the first angle leaves the pipeline
+                    if (++theta_cnt == theta_bytes)
+                        req.t_resp = t_rx + g_latency_ns;
+                    if (--theta_left == 0)
+                        state = RX_CRC;
+                    break;
+                case RX_CRC:
+                    req.bytes.push_back(b);
+                    done = true;
+                    break;
+            }
+
+            if (done) {
+                // Track DISABLE/ENABLE here so that the workers can run out of order
+                unsigned char cmd = req.bytes[1];
+                if ((cmd == CMD_DISABLE || cmd == CMD_ENABLE) && req.bytes.size() == 3
+                    && crc_8_block(0, req.bytes.data(), req.bytes.size()) == 0)
+                    disabled = (cmd == CMD_DISABLE);
+                if (!g_cfg.paced)
+                    req.t_resp = t_rx;
+                req.seq = seq++;
+                submit(req);
+                req = request_t();
+                state = RX_HEADER;
+            }
+        }
+    }
+}
+
+/* Runs one framed CMD_STREAM_TRANS request through cordic_gref_stream */
+static void evaluate_stream(const request_t& req, response_t& resp) {
+    std::vector<short int> i_msg(req.bytes.size());
+    // Room for the response to the count actually requested (3 packets for the error message)
+    int cnt = req.bytes.size() > 4 ? req.bytes[3] | (req.bytes[4] << 8) : 1;
+    std::vector<short int> o_msg(5 + 12*(cnt ? cnt : STREAM_MAX_CNT) + 1);
+    for (size_t i = 0; i < req.bytes.size(); i++)
+        set_packet(&i_msg[i], req.bytes[i]);
+    char disabled = req.disabled;
+    int n = cordic_gref_stream((int)i_msg.size(), i_msg.data(), &disabled, o_msg.data());
+
+    resp.t_resp = req.t_resp;
+    resp.bytes.resize(n);
+    for (int i = 0; i < n; i++)
+        resp.bytes[i] = (o_msg[i] >> 1) & 0xff;
+    if (n == 0)
+        g_stats.silent++;
+    else if (resp.bytes[1] == CMD_ERR)
+        g_stats.err_responses++;
+    else
+        g_stats.angles += (n - 6) / (2 * stream_result_bytes(req.bytes[2]));
+}
+
+/* Runs one framed request through cordic_gref and serializes its response */
+static void evaluate(const request_t& req, response_t& resp) {
+    if (req.bytes.size() > 1 && req.bytes[1] == CMD_STREAM_TRANS) {
+        evaluate_stream(req, resp);
+        return;
+    }
+
+    short int i_header = 0, i_cmd = 0, i_burst_cnt = 0, i_crc_8 = 0;
+    short int i_theta[48] = {0};
+    short int o_header, o_cmd, o_burst_cnt, o_crc_8;
+    short int o_cos_theta[48], o_sin_theta[48];
+    unsigned char crc = 0;
+    char disabled = req.disabled;
+
+    const unsigned char* p = req.bytes.data();
+    size_t len = req.bytes.size();
+    size_t pos = 0, num_theta = 0;
+
+    set_packet(&i_header, p[pos++]);
+    if (pos < len)
+        set_packet(&i_cmd, p[pos++]);
+    if (len > 2 && p[1] == CMD_BURST_TRANS)
+        set_packet(&i_burst_cnt, p[pos++]);
+    if (len > pos + 1) {
+        num_theta = (len - pos - 1) / 6;
+        set_packets(i_theta, p + pos, 6 * num_theta, &crc);
+        pos += 6 * num_theta;
+    }
+    if (pos < len)
+        set_packet(&i_crc_8, p[pos]);
+
+    cordic_gref(i_header, i_cmd, i_burst_cnt, i_theta, i_crc_8, &disabled,
+                &o_header, &o_cmd, &o_burst_cnt, o_cos_theta, o_sin_theta, &o_crc_8);
+
+    resp.t_resp = req.t_resp;
+    resp.bytes.clear();
+    if (o_header == 0) {
+        g_stats.silent++;
+        return;
+    }
+
+    unsigned char cmd = (o_cmd >> 1) & 0xff;
+    resp.bytes.push_back((o_header >> 1) & 0xff);
+    resp.bytes.push_back(cmd);
+    if (cmd == CMD_BURST_TRANS)
+        resp.bytes.push_back((o_burst_cnt >> 1) & 0xff);
+    if (cmd == CMD_SINGLE_TRANS || cmd == CMD_BURST_TRANS) {
+        for (size_t j = 0; j < num_theta; j++) {
+            for (int k = 0; k < 6; k++)
+                resp.bytes.push_back((o_cos_theta[6*j + k] >> 1) & 0xff);
+            for (int k = 0; k < 6; k++)
+                resp.bytes.push_back((o_sin_theta[6*j + k] >> 1) & 0xff);
+        }
+        g_stats.angles += num_theta;
+    }
+    resp.bytes.push_back((o_crc_8 >> 1) & 0xff);
+
+    if (cmd == CMD_ERR)
+        g_stats.err_responses++;
+}
+
+static void worker_thread() {
+    while (true) {
+        request_t req;
+        {
+            std::unique_lock<std::mutex> lock(g_req_mtx);
+            g_req_cv.wait(lock, [] { return g_stop || !g_req_q.empty(); });
+            if (g_req_q.empty())
+                return;
+            req = std::move(g_req_q.front());
+            g_req_q.pop_front();
+        }
+
+        response_t resp;
+        evaluate(req, resp);
+
+        {
+            std::lock_guard<std::mutex> lock(g_resp_mtx);
+            g_resp_q[req.seq] = std::move(resp);
+        }
+        g_resp_cv.notify_one();
+    }
+}
+
+static bool write_all(const unsigned char* p, size_t n) {
+    while (n > 0) {
+        ssize_t w = write(g_master, p, n);
+        if (w < 0) {
+            if (errno == EINTR || errno == EAGAIN)
+                continue;
+            perror("write");
+            return false;
+        }
+        p += w;
+        n -= w;
+        g_stats.tx_bytes += w;
+    }
+    return true;
+}
+
+/* Writes responses in request order. In paced mode every byte is released when its stop bit
+   would have been sent; bytes that are already due are written together. */
+static void tx_thread() {
+    unsigned long next_seq = 0;
+    long long t_line = 0;
+
+    while (true) {
+        response_t resp;
+        {
+            std::unique_lock<std::mutex> lock(g_resp_mtx);
+            g_resp_cv.wait(lock, [&] { return g_stop || g_resp_q.count(next_seq); });
+            if (g_stop)
+                return;
+            resp = std::move(g_resp_q[next_seq]);
+            g_resp_q.erase(next_seq);
+        }
+        next_seq++;
+
+        if (resp.bytes.empty())
+            continue;
+        g_stats.responses++;
+
+        if (!g_cfg.paced) {
+            write_all(resp.bytes.data(), resp.bytes.size());
+            continue;
+        }
+
+        long long t_start = std::max(resp.t_resp, t_line);
+        size_t sent = 0, n = resp.bytes.size();
+        while (sent < n && !g_stop) {
+            long long t_due = t_start + (long long)(sent + 1) * g_byte_ns;
+            long long t_now = now_ns();
+            if (t_now < t_due) {
+                sleep_until_ns(t_due);
+                t_now = now_ns();
+            }
+            if (t_now < t_due)
+                continue;
+            size_t due = std::min(n, (size_t)((t_now - t_start) / g_byte_ns));
+            if (!write_all(resp.bytes.data() + sent, due - sent))
+                break;
+            sent = due;
+        }
+        t_line = t_start + (long long)n * g_byte_ns;
+    }
+}
+
+static void usage(const char* prog) {
+    fprintf(stderr, "Usage: %s [--link PATH] [--unpaced] [--baud N] [--clk HZ] [--latency CYCLES] [--workers N]\n", prog);
+    exit(1);
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--unpaced"))
+            g_cfg.paced = false;
+        else if (!strcmp(argv[i], "--link") && i + 1 < argc)
+            g_cfg.link = argv[++i];
+        else if (!strcmp(argv[i], "--baud") && i + 1 < argc)
+            g_cfg.baud = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--clk") && i + 1 < argc)
+            g_cfg.clk_hz = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--latency") && i + 1 < argc)
+            g_cfg.latency_cycles = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--workers") && i + 1 < argc)
+            g_cfg.workers = atoi(argv[++i]);
+        else
+            usage(argv[0]);
+    }
+    if (g_cfg.baud <= 0 || g_cfg.clk_hz <= 0 || g_cfg.latency_cycles < 0)
+        usage(argv[0]);
+    if (g_cfg.workers <= 0)
+        g_cfg.workers = std::max(1u, std::thread::hardware_concurrency());
+
+    g_byte_ns    = (long long)(1e9 * BITS_PER_BYTE / g_cfg.baud);
+    g_latency_ns = (long long)(1e9 * g_cfg.latency_cycles / g_cfg.clk_hz);
+
+    // Open the pty pair. The slave stays open here so the master keeps working while clients
+    // come and go.
+    g_master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (g_master < 0 || grantpt(g_master) || unlockpt(g_master)) {
+        perror("posix_openpt");
+        return 1;
+    }
+    const char* slave_name = ptsname(g_master);
+    int slave = open(slave_name, O_RDWR | O_NOCTTY);
+    if (slave < 0) {
+        perror("open slave");
+        return 1;
+    }
+    struct termios tio;
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+
+    if (g_cfg.link) {
+        unlink(g_cfg.link);
+        if (symlink(slave_name, g_cfg.link)) {
+            perror("symlink");
+            return 1;
+        }
+    }
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    printf("CORDIC-UART emulator on %s%s%s (%s, %d workers)\n", slave_name,
+           g_cfg.link ? " -> " : "", g_cfg.link ? g_cfg.link : "",
+           g_cfg.paced ? "paced" : "unpaced", g_cfg.workers);
+    if (g_cfg.paced)
+        printf("%.0f baud (%lld ns/byte), %d cycle latency at %.0f Hz\n",
+               g_cfg.baud, g_byte_ns, g_cfg.latency_cycles, g_cfg.clk_hz);
+    fflush(stdout);
+
+    std::thread rx(rx_thread);
+    std::thread tx(tx_thread);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < g_cfg.workers; i++)
+        workers.emplace_back(worker_thread);
+
+    rx.join();
+    g_req_cv.notify_all();
+    g_resp_cv.notify_all();
+    for (std::thread& w : workers)
+        w.join();
+    tx.join();
+
+    printf("\nrequests %lu, angles %lu, responses %lu, error responses %lu, silent (disabled) %lu\n",
+           g_stats.requests.load(), g_stats.angles.load(), g_stats.responses.load(),
+           g_stats.err_responses.load(), g_stats.silent.load());
+    printf("rx bytes %lu (%lu dropped while hunting for header), tx bytes %lu\n",
+           g_stats.rx_bytes.load(), g_stats.dropped_bytes.load(), g_stats.tx_bytes.load());
+
+    if (g_cfg.link)
+        unlink(g_cfg.link);
+    close(slave);
+    close(g_master);
+    return 0;
+}
@@ -0,0 +1,186 @@
+//
+// File:        cordic_hybrid.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Seed ROM generator and tradeoff report for the hybrid (ROM-seeded) mode of
+//              cordic_sincos (SEED_BITS > 0, see cordic_sincos_seed.sv).
+//
+//              rom     writes the $readmemh file for cordic_sincos #(.STAGES, .SEED_BITS): line n
+//                      holds {cos, sin} of n*2^-SEED_BITS as two 48-bit 2.46 words, pre-scaled by
+//                      the gain of the CORDIC stages that follow (cordic_seed_rom_entry()).
+//              report  compares the plain pipeline with a range of SEED_BITS: latency, CORDIC stages,
+//                      ROM size and BRAM18 count, LUT/FF estimates, and error against long double
+//                      sincosl() over random thetas in [-2pi, 2pi]. It also checks that the 48-bit
+//                      reference (cordic_sincos_hybrid) and the parameterized model agree.
+//
+//              LUT/FF figures are counted from the RTL structure (one LUT per adder bit, add/sub
+//              select folded in), not taken from a Vivado run; BRAM18 counts assume 7-series
+//              simple dual port widths (512x36, 1Kx18, 2Kx9, ...).
+//
+//              Build (from tools/hybrid):
+//                  g++ -std=c++14 -O2 -DCORDIC_GREF_STANDALONE -I../../testbench/uvm_tb_hvl/subscriber
+//                      cordic_hybrid.cpp ../../testbench/uvm_tb_hvl/subscriber/cordic_gref.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_sincos_param.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_sincos_simd.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_crc8.cpp -o cordic_hybrid
+//              Run:    ./cordic_hybrid rom [--stages 48] [--seed-bits 8] [-o FILE]
+//                      ./cordic_hybrid report [--count N] [--seed S]
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+
+#include "cordic_gref_const.h"
+#include "cordic_gref.h"
+#include "cordic_sincos_param.h"
+
+static const int STAGES             = 48;
+static const int BITS               = 48;
+static const int PREPROCESS_CYCLES  = 2;    // cordic_sincos_preprocess registers
+static const int REPORT_SEED_BITS[] = { 0, 4, 6, 8, 10, 12 };
+
+static int usage(const char* prog) {
+    fprintf(stderr, "Usage: %s rom [--stages 48] [--seed-bits 8] [-o FILE]\n"
+                    "       %s report [--count N] [--seed S]\n", prog, prog);
+    return 2;
+}
+
+static int write_rom(int stages, int seed_bits, const char* path) {
+    if (seed_bits < 1 || seed_bits + 1 >= stages || stages > 48 || seed_bits > 16) {
+        fprintf(stderr, "seed bits must be within [1, min(16, stages-2)]\n");
+        return 2;
+    }
+    FILE* f = path ? fopen(path, "w") : stdout;
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+    int depth = 1 << (seed_bits + 1);
+    for (int n = 0; n < depth; n++) {
+        long long c, s;
+        cordic_seed_rom_entry(stages, seed_bits, n, &c, &s);
+        fprintf(f, "%012llx%012llx\n", (unsigned long long)c & 0xffffffffffffULL,
+                (unsigned long long)s & 0xffffffffffffULL);
+    }
+    if (path)
+        fclose(f);
+    return 0;
+}
+
+/* BRAM18 primitives for a depth x width ROM in simple dual port mode */
+static int bram18_count(int depth, int width) {
+    static const int SDP_WIDTH[] = { 36, 18, 9, 4, 2, 1 };
+    int d = 512;
+    for (int w : SDP_WIDTH) {
+        if (depth <= d)
+            return (width + w - 1) / w;
+        d *= 2;
+    }
+    return -1;
+}
+
+struct err_t {
+    double      max;
+    double      sum;
+    double      sum_sq;
+};
+
+static void add_err(err_t& e, long long v, long double ref) {
+    double d = (double)fabsl(ldexpl((long double)v, -46) - ref) * ldexp(1.0, 46);
+    e.max    = fmax(e.max, d);
+    e.sum   += d;
+    e.sum_sq += d * d;
+}
+
+static int report(long long count, unsigned long long seed) {
+    printf("# cordic_sincos plain vs hybrid (STAGES %d, BITS %d)\n\n", STAGES, BITS);
+    printf("%lld random thetas in [-2pi, 2pi] (seed %llu). Errors are in output LSBs (2^-46) against "
+           "long double sincosl(), cos and sin together. Latency is i_start to o_done in cycles.\n\n",
+           count, seed);
+    printf("| SEED_BITS | latency | CORDIC stages | ROM        | BRAM18 | LUT (est.) | FF (est.) | max err | mean err | RMS err |\n");
+    printf("|-----------|---------|---------------|------------|--------|------------|-----------|---------|----------|---------|\n");
+
+    long long mismatches = 0;
+    for (int seed_bits : REPORT_SEED_BITS) {
+        int first   = seed_bits ? seed_bits + 1 : 0;
+        int stages  = STAGES - first;
+        int latency = PREPROCESS_CYCLES + (seed_bits ? 1 : 0) + stages;
+
+        // Each stage: three BITS-wide add/subs and their registers; the last one also negates
+        int luts = stages * 3 * BITS + 2 * BITS;
+        int ffs  = stages * (3 * BITS + 2);
+        int depth = seed_bits ? 1 << (seed_bits + 1) : 0;
+        int brams = seed_bits ? bram18_count(depth, 2 * 48) : 0;
+        if (seed_bits) {
+            // Rounding add, remainder subtract (low SHIFT+1 bits only), |idx|, sin negation
+            luts += BITS + (seed_bits + 3) + (seed_bits + 1) + BITS;
+            ffs  += BITS + 3;
+        }
+
+        err_t err = {0, 0, 0};
+        std::mt19937_64 rng(seed);
+        for (long long k = 0; k < count; k++) {
+            long long t = (long long)(rng() % (2 * PI_MULT_2 + 1)) - PI_MULT_2;
+            long long x, y;
+            if (seed_bits) {
+                cordic_sincos_hybrid(&t, &x, &y, seed_bits);
+                long long px, py;
+                cordic_sincos_hybrid_rt(STAGES, BITS, seed_bits, t, &px, &py, NULL);
+                mismatches += (px != x || py != y);
+            } else {
+                cordic_sincos(&t, &x, &y);
+            }
+            long double s, c;
+            sincosl(ldexpl((long double)t, -44), &s, &c);
+            add_err(err, x, c);
+            add_err(err, y, s);
+        }
+
+        char rom[32] = "-";
+        if (seed_bits)
+            snprintf(rom, sizeof(rom), "%d x 96", depth);
+        printf("| %9d | %7d | %13d | %-10s | %6d | %10d | %9d | %7.1f | %8.2f | %7.2f |\n",
+               seed_bits, latency, stages, rom, brams, luts, ffs, err.max,
+               err.sum / (2.0 * count), sqrt(err.sum_sq / (2.0 * count)));
+    }
+
+    printf("\nEach seed bit removes one CORDIC stage and one cycle of latency at the cost of doubling the ROM; "
+           "accuracy improves slightly, since the ROM entries are exact to 2^-46 and fewer truncating "
+           "stages remain. ROMs of 64 entries or fewer would map to distributed LUT RAM instead "
+           "of BRAM.\n");
+    printf("\nhybrid reference vs parameterized model: %lld mismatches\n", mismatches);
+    return mismatches ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2)
+        return usage(argv[0]);
+
+    int stages = STAGES, seed_bits = 8;
+    long long count = 1000000;
+    unsigned long long seed = 1;
+    const char* out = NULL;
+    for (int i = 2; i < argc; i++) {
+        if (!strcmp(argv[i], "--stages") && i + 1 < argc)
+            stages = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed-bits") && i + 1 < argc)
+            seed_bits = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--count") && i + 1 < argc)
+            count = atoll(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc)
+            out = argv[++i];
+        else
+            return usage(argv[0]);
+    }
+
+    if (!strcmp(argv[1], "rom"))
+        return write_rom(stages, seed_bits, out);
+    if (!strcmp(argv[1], "report") && count > 0)
+        return report(count, seed);
+    return usage(argv[0]);
+}
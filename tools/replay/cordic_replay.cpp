@@ -0,0 +1,395 @@
+//
+// File:        cordic_replay.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Offline replay of captured CORDIC-UART serial logs. The request log (host to
+//              device) is memory-mapped and decoded with the same framing as uart_rx_msg, every
+//              well-formed SINGLE/BURST/STREAM/SELFTEST request is recomputed with the reference
+//              model (SELFTEST with the cycle count of a run that never stalls), and, if the
+//              response log (device to host) is given, the recomputed responses are compared byte
+//              for byte against what the device sent. Reports frame and error statistics and the
+//              first mismatches.
+//
+//              The logs are raw byte captures, one direction per file. Pairing follows the RTL:
+//              malformed requests get no response, a CRC error re-enables the pipeline, and
+//              SINGLE/BURST requests get no response while the device is disabled. Malformed
+//              response frames (e.g. cut short by a request CRC error) are counted and skipped.
+//
+//              Build (from tools/replay):
+//                  g++ -std=c++14 -O2 -pthread -DCORDIC_GREF_STANDALONE -I../../testbench/uvm_tb_hvl/subscriber
+//                      cordic_replay.cpp ../../testbench/uvm_tb_hvl/subscriber/cordic_stream.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_gref.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_sincos_simd.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_crc8.cpp -o cordic_replay
+//              Run:    ./cordic_replay [-j threads] [-n max_reported] rx.log [tx.log]
+//
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "cordic_gref_const.h"
+#include "cordic_gref.h"
+#include "cordic_crc8.h"
+#include "cordic_stream.h"
+
+/* Decoded frame, located by offset in the mapped log */
+struct frame_rec_t {
+    size_t                  offset;
+    unsigned int            len;
+    unsigned char           cmd;
+    unsigned char           status;
+    unsigned char           mode;
+    unsigned int            num_theta;
+};
+
+struct log_t {
+    const unsigned char*    data;
+    size_t                  size;
+};
+
+struct decode_stats_t {
+    size_t frames[256];     // well-formed frames per cmd
+    size_t crc_err;
+    size_t bad_cmd;
+    size_t dropped;
+};
+
+struct mismatch_t {
+    size_t req_idx;
+    size_t resp_idx;
+};
+
+static bool map_log(const char* path, log_t* log) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return false;
+    }
+    struct stat st;
+    fstat(fd, &st);
+    log->size = st.st_size;
+    log->data = NULL;
+    if (log->size) {
+        void* m = mmap(NULL, log->size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+        if (m == MAP_FAILED) {
+            perror("mmap");
+            close(fd);
+            return false;
+        }
+        madvise(m, log->size, MADV_SEQUENTIAL);
+        log->data = (const unsigned char*)m;
+    }
+    close(fd);
+    return true;
+}
+
+/* Frames of one segment of a log. Segments after the first are decoded speculatively from
+   STATE_HEADER at their first byte; stop is an offset at or past the segment end at which the
+   decoder was between frames. */
+struct segment_t {
+    size_t                      begin, end, stop;
+    std::vector<frame_rec_t>    frames;
+};
+
+static void add_frame(std::vector<frame_rec_t>& frames, const cordic_frame_t& f) {
+    frame_rec_t r = { f.offset, (unsigned int)f.len, f.cmd, (unsigned char)f.status, f.mode,
+                      (unsigned int)f.num_theta };
+    frames.push_back(r);
+}
+
+static void decode_segment(const log_t& log, cordic_stream_dir_t dir, segment_t& seg) {
+    cordic_stream_t* s = new cordic_stream_t;
+    cordic_stream_init(s, dir);
+    s->offset = seg.begin;
+
+    const unsigned char* p = log.data + seg.begin;
+    cordic_frame_t f;
+    seg.frames.reserve((seg.end - seg.begin) / 16);
+    while (cordic_stream_next(s, &p, log.data + seg.end, &f))
+        add_frame(seg.frames, f);
+    seg.stop = seg.end;
+
+    // Finish the frame that straddles the segment end
+    if (!cordic_stream_idle(s)) {
+        if (cordic_stream_next(s, &p, log.data + log.size, &f)) {
+            add_frame(seg.frames, f);
+            seg.stop = f.offset + f.len;
+        } else {
+            seg.stop = log.size;
+        }
+    }
+    delete s;
+}
+
+/* Whether a decoder that ran over seg is between frames at offset x */
+static bool seg_idle_at(const segment_t& seg, size_t x) {
+    std::vector<frame_rec_t>::const_iterator it = std::lower_bound(seg.frames.begin(), seg.frames.end(), x,
+        [](const frame_rec_t& r, size_t off) { return r.offset < off; });
+    return it == seg.frames.begin() || (it - 1)->offset + (it - 1)->len <= x;
+}
+
+/* Decodes a whole log on num_threads threads. Every segment is decoded independently, then the
+   segments are joined in order: from the offset x where the true decoder is known to be between
+   frames, a segment's frames are used as-is if its speculative decoder was also between frames
+   at x; otherwise the log is decoded sequentially from x until both agree. Framing only depends
+   on the bytes since the last idle point, so once they agree they stay in step. */
+static void decode_log(const log_t& log, cordic_stream_dir_t dir, int num_threads,
+                       std::vector<frame_rec_t>& frames, decode_stats_t& stats) {
+    size_t num_seg = std::max<size_t>(1, std::min<size_t>(num_threads, log.size / (1 << 20)));
+    std::vector<segment_t> segs(num_seg);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < num_seg; t++) {
+        segs[t].begin   = log.size * t / num_seg;
+        segs[t].end     = log.size * (t + 1) / num_seg;
+        workers.emplace_back(decode_segment, std::cref(log), dir, std::ref(segs[t]));
+    }
+    for (std::thread& w : workers)
+        w.join();
+
+    cordic_stream_t* s = new cordic_stream_t;
+    size_t x = 0;
+    for (size_t t = 0; t < num_seg; t++) {
+        const segment_t& seg = segs[t];
+        if (x >= seg.stop)
+            continue;
+        if (!seg_idle_at(seg, x)) {
+            cordic_stream_init(s, dir);
+            s->offset = x;
+            const unsigned char* p = log.data + x;
+            cordic_frame_t f;
+            while (true) {
+                if (!cordic_stream_next(s, &p, log.data + log.size, &f)) {
+                    x = log.size;
+                    break;
+                }
+                add_frame(frames, f);
+                x = f.offset + f.len;
+                if (x >= seg.stop || seg_idle_at(seg, x))
+                    break;
+            }
+            if (x >= seg.stop)
+                continue;
+        }
+        std::vector<frame_rec_t>::const_iterator it = std::lower_bound(seg.frames.begin(), seg.frames.end(), x,
+            [](const frame_rec_t& r, size_t off) { return r.offset < off; });
+        frames.insert(frames.end(), it, seg.frames.end());
+        x = seg.stop;
+    }
+    delete s;
+
+    memset(&stats, 0, sizeof(stats));
+    size_t framed = 0;
+    for (const frame_rec_t& r : frames) {
+        framed += r.len;
+        if (r.status == CORDIC_FRAME_OK)
+            stats.frames[r.cmd]++;
+        else if (r.status == CORDIC_FRAME_CRC_ERR)
+            stats.crc_err++;
+        else
+            stats.bad_cmd++;
+    }
+    stats.dropped = log.size - framed;
+}
+
+static cordic_frame_t to_frame(const log_t& log, const frame_rec_t& r) {
+    cordic_frame_t f;
+    f.bytes     = log.data + r.offset;
+    f.len       = r.len;
+    f.offset    = r.offset;
+    f.cmd       = r.cmd;
+    f.mode      = r.mode;
+    f.num_theta = r.num_theta;
+    f.payload   = f.bytes + (r.cmd == CMD_BURST_TRANS ? 3 : r.cmd == CMD_STREAM_TRANS ? 5 : 2);
+    f.status    = (cordic_frame_status_t)r.status;
+    return f;
+}
+
+/* Length of the RTL's response to a well-formed request */
+static size_t response_len(const frame_rec_t& req) {
+    if (req.cmd == CMD_SINGLE_TRANS)
+        return 2 + 12 + 1;
+    if (req.cmd == CMD_BURST_TRANS)
+        return 3 + 12 * (size_t)req.num_theta + 1;
+    if (req.cmd == CMD_STREAM_TRANS)
+        return 5 + 2 * stream_result_bytes(req.mode) * (size_t)req.num_theta + 1;
+    if (req.cmd == CMD_SELFTEST)
+        return SELFTEST_MSG_LEN;
+    return 3;
+}
+
+static void print_stats(const char* name, const decode_stats_t& st, size_t bytes, double secs) {
+    printf("%s: %zu bytes decoded in %.3f s (%.2f GB/s)\n", name, bytes, secs, bytes / secs / 1e9);
+    printf("    SINGLE %zu, BURST %zu, STREAM %zu, SELFTEST %zu, DISABLE %zu, ENABLE %zu, ERR %zu\n",
+           st.frames[CMD_SINGLE_TRANS], st.frames[CMD_BURST_TRANS], st.frames[CMD_STREAM_TRANS], st.frames[CMD_SELFTEST],
+           st.frames[CMD_DISABLE], st.frames[CMD_ENABLE], st.frames[CMD_ERR]);
+    printf("    CRC error frames %zu, bad cmd frames %zu, bytes outside frames %zu\n",
+           st.crc_err, st.bad_cmd, st.dropped);
+}
+
+static void print_hex(const char* label, const unsigned char* p, size_t n) {
+    printf("        %s", label);
+    for (size_t i = 0; i < n && i < 40; i++)
+        printf("%02x", p[i]);
+    printf("%s\n", n > 40 ? "..." : "");
+}
+
+int main(int argc, char** argv) {
+    int num_threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t max_report = 10;
+    const char* paths[2] = { NULL, NULL };
+    int num_paths = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-j") && i + 1 < argc)
+            num_threads = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc)
+            max_report = strtoul(argv[++i], NULL, 0);
+        else if (argv[i][0] != '-' && num_paths < 2)
+            paths[num_paths++] = argv[i];
+        else
+            num_paths = -1;
+        if (num_paths < 0)
+            break;
+    }
+    if (num_paths < 1) {
+        fprintf(stderr, "Usage: %s [-j threads] [-n max_reported] rx.log [tx.log]\n", argv[0]);
+        return 2;
+    }
+
+    typedef std::chrono::steady_clock clk;
+    log_t rx_log = {}, tx_log = {};
+    if (!map_log(paths[0], &rx_log) || (paths[1] && !map_log(paths[1], &tx_log)))
+        return 2;
+
+    // Decode both directions
+    std::vector<frame_rec_t> reqs, resps;
+    decode_stats_t rx_stats, tx_stats;
+    clk::time_point t0 = clk::now();
+    decode_log(rx_log, CORDIC_STREAM_RX, num_threads, reqs, rx_stats);
+    double rx_secs = std::chrono::duration<double>(clk::now() - t0).count();
+    print_stats(paths[0], rx_stats, rx_log.size, rx_secs);
+    if (paths[1]) {
+        t0 = clk::now();
+        decode_log(tx_log, CORDIC_STREAM_TX, num_threads, resps, tx_stats);
+        double tx_secs = std::chrono::duration<double>(clk::now() - t0).count();
+        print_stats(paths[1], tx_stats, tx_log.size, tx_secs);
+    }
+
+    // Requests the device answers, in order. uart_rx_msg re-enables the pipeline on a CRC error;
+    // an unknown cmd returns to STATE_HEADER without touching it.
+    std::vector<size_t> expected;
+    bool disabled = false;
+    for (size_t i = 0; i < reqs.size(); i++) {
+        const frame_rec_t& r = reqs[i];
+        if (r.status == CORDIC_FRAME_CRC_ERR) {
+            disabled = false;
+            continue;
+        }
+        if (r.status != CORDIC_FRAME_OK)
+            continue;
+        if (r.cmd == CMD_DISABLE || r.cmd == CMD_ENABLE) {
+            disabled = (r.cmd == CMD_DISABLE);
+            expected.push_back(i);
+        } else if (!disabled) {
+            expected.push_back(i);
+        }
+    }
+
+    // Pair the responses with the expected requests in order. CMD_ERR frames come from the
+    // reference model (e.g. the emulator), never from the RTL, and are skipped. A malformed frame
+    // of the expected length is a corrupted response to that request; any other malformed frame
+    // is a response the RTL cut short after a request CRC error.
+    std::vector<size_t> received;
+    size_t num_unexpected = 0;
+    for (size_t i = 0; i < resps.size(); i++) {
+        const frame_rec_t& r = resps[i];
+        if (r.status == CORDIC_FRAME_OK && r.cmd == CMD_ERR)
+            continue;
+        if (received.size() == expected.size()) {
+            num_unexpected += (r.status == CORDIC_FRAME_OK);
+            continue;
+        }
+        if (r.status != CORDIC_FRAME_OK && r.len != response_len(reqs[expected[received.size()]]))
+            continue;
+        received.push_back(i);
+    }
+
+    // Recompute (and compare) in parallel over contiguous slices of the expected responses
+    size_t num_pairs = paths[1] ? received.size() : expected.size();
+    std::vector<std::vector<mismatch_t>> mismatches(num_threads);
+    std::atomic<size_t> angles(0), num_mismatch(0);
+
+    t0 = clk::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < num_threads; t++) {
+        workers.emplace_back([&, t] {
+            size_t lo = num_pairs * t / num_threads, hi = num_pairs * (t + 1) / num_threads;
+            std::vector<unsigned char> out(CORDIC_STREAM_MAX_FRAME);
+            size_t n_angles = 0, n_mismatch = 0;
+            for (size_t k = lo; k < hi; k++) {
+                cordic_frame_t req = to_frame(rx_log, reqs[expected[k]]);
+                size_t len = cordic_stream_response(&req, out.data());
+                if (req.cmd == CMD_SINGLE_TRANS || req.cmd == CMD_BURST_TRANS || req.cmd == CMD_STREAM_TRANS)
+                    n_angles += req.num_theta;
+                if (!paths[1])
+                    continue;
+                const frame_rec_t& r = resps[received[k]];
+                if (len != r.len || memcmp(out.data(), tx_log.data + r.offset, len)) {
+                    if (n_mismatch++ < max_report)
+                        mismatches[t].push_back({ expected[k], received[k] });
+                }
+            }
+            angles += n_angles;
+            num_mismatch += n_mismatch;
+        });
+    }
+    for (std::thread& w : workers)
+        w.join();
+    double check_secs = std::chrono::duration<double>(clk::now() - t0).count();
+
+    printf("recomputed %zu responses (%zu angles) in %.3f s on %d threads (%.2f GB/s of requests, %.1f M angles/s)\n",
+           num_pairs, angles.load(), check_secs, num_threads, rx_log.size / check_secs / 1e9,
+           angles.load() / check_secs / 1e6);
+
+    int rc = 0;
+    if (paths[1]) {
+        printf("compared %zu responses: %zu mismatches\n", num_pairs, num_mismatch.load());
+        if (expected.size() != received.size() || num_unexpected) {
+            printf("expected %zu responses, %zu missing, %zu unexpected\n", expected.size(),
+                   expected.size() - received.size(), num_unexpected);
+            rc = 1;
+        }
+        size_t reported = 0;
+        std::vector<unsigned char> out(CORDIC_STREAM_MAX_FRAME);
+        for (int t = 0; t < num_threads && reported < max_report; t++) {
+            for (const mismatch_t& m : mismatches[t]) {
+                if (reported++ >= max_report)
+                    break;
+                cordic_frame_t req = to_frame(rx_log, reqs[m.req_idx]);
+                const frame_rec_t& r = resps[m.resp_idx];
+                size_t len = cordic_stream_response(&req, out.data());
+                printf("    request @%zu (cmd 0x%02x) vs response @%zu:\n", req.offset, req.cmd, r.offset);
+                print_hex("expected ", out.data(), len);
+                print_hex("received ", tx_log.data + r.offset, r.len);
+            }
+        }
+        if (num_mismatch.load())
+            rc = 1;
+    }
+
+    if (rx_log.size)
+        munmap((void*)rx_log.data, rx_log.size);
+    if (tx_log.size)
+        munmap((void*)tx_log.data, tx_log.size);
+    return rc;
+}
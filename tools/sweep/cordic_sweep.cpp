@@ -0,0 +1,430 @@
+//
+// File:        cordic_sweep.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Accuracy sweep of the fixed-point CORDIC model over the full input range
+//              [-2pi, 2pi] (theta in 4.44 fixed point). Two sample sets are evaluated:
+//                - --samples thetas stratified over the whole range (one pseudo-random theta per
+//                  equal-width cell, so the sweep is reproducible from --seed), and
+//                - every theta within --fold-width LSBs of the preprocessing fold points
+//                  +/-PI_DIV_2, +/-PI, +/-PI_MULT_3_DIV_2 and the range ends +/-PI_MULT_2.
+//              cos/sin are compared against long double sincosl() of the exact theta. Errors are
+//              in output LSBs (2^-46) and reported per quadrant of theta (mod 2pi) as max/mean/RMS
+//              plus a signed histogram, in JSON.
+//
+//              The samples are cut into fixed work units spread over a work-stealing thread pool.
+//              With --checkpoint, completed units and their statistics are saved every
+//              --checkpoint-sec seconds and on SIGINT/SIGTERM; rerunning the same command resumes.
+//
+//              Build (from tools/sweep):
+//                  g++ -std=c++14 -O2 -pthread -DCORDIC_GREF_STANDALONE -I../../testbench/uvm_tb_hvl/subscriber
+//                      cordic_sweep.cpp ../../testbench/uvm_tb_hvl/subscriber/cordic_gref.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_sincos_simd.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_crc8.cpp -o cordic_sweep
+//              Run:    ./cordic_sweep [--samples N] [--fold-width W] [--seed S] [--threads T]
+//                                     [--checkpoint FILE] [--checkpoint-sec 60] [--out report.json]
+//
+
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cordic_gref_const.h"
+#include "cordic_gref.h"
+
+static const long long  UNIT_SIZE   = 1 << 16;  // thetas per work unit
+static const int        HIST_HALF   = 64;       // signed LSB bins -64..64, outer bins are overflow
+static const int        HIST_BINS   = 2 * HIST_HALF + 1;
+static const int        NUM_QUAD    = 4;
+
+static const long long FOLD_POINTS[] = {
+    -PI_MULT_2, -PI_MULT_3_DIV_2, -PI, -PI_DIV_2, PI_DIV_2, PI, PI_MULT_3_DIV_2, PI_MULT_2
+};
+static const int NUM_FOLD = sizeof(FOLD_POINTS) / sizeof(FOLD_POINTS[0]);
+
+struct sweep_cfg_t {
+    unsigned long long  samples;
+    unsigned long long  fold_width;
+    unsigned long long  seed;
+};
+
+/* Error statistics of one output over one quadrant */
+struct err_stats_t {
+    unsigned long long  n;
+    double              max_err;        // largest |error|
+    long long           max_theta;      // theta at which it occurred
+    long double         sum_abs;
+    long double         sum_sq;
+    unsigned long long  hist[HIST_BINS];
+};
+
+struct sweep_stats_t {
+    err_stats_t cos_err[NUM_QUAD];
+    err_stats_t sin_err[NUM_QUAD];
+};
+
+/* Checkpoint file: header, statistics, then one done flag per unit */
+struct checkpoint_hdr_t {
+    char                magic[8];
+    unsigned int        version;
+    sweep_cfg_t         cfg;
+    unsigned long long  num_units;
+};
+
+static const char CKPT_MAGIC[8] = { 'C', 'S', 'W', 'E', 'E', 'P', '0', '1' };
+
+static std::atomic<bool> g_stop {false};
+
+static void on_signal(int) {
+    g_stop = true;
+}
+
+/* Splitmix64, used to place one theta per cell */
+static inline unsigned long long mix64(unsigned long long x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/* Sample space: [0, samples) stratified, then NUM_FOLD windows of 2*fold_width+1 thetas */
+struct sample_space_t {
+    sweep_cfg_t         cfg;
+    unsigned long long  num_fold_each;
+    unsigned long long  total;
+    unsigned long long  num_units;
+
+    explicit sample_space_t(const sweep_cfg_t& c) : cfg(c) {
+        num_fold_each   = 2 * cfg.fold_width + 1;
+        total           = cfg.samples + NUM_FOLD * num_fold_each;
+        num_units       = (total + UNIT_SIZE - 1) / UNIT_SIZE;
+    }
+
+    /* Returns false for fold samples that fall outside [-2pi, 2pi] */
+    bool theta(unsigned long long k, long long* t) const {
+        const unsigned long long span = 2 * (unsigned long long)PI_MULT_2 + 1;
+        if (k < cfg.samples) {
+            unsigned long long lo = (unsigned long long)((unsigned __int128)k * span / cfg.samples);
+            unsigned long long hi = (unsigned long long)((unsigned __int128)(k + 1) * span / cfg.samples);
+            unsigned long long cell = (hi > lo) ? hi - lo : 1;
+            (*t) = -PI_MULT_2 + (long long)(lo + mix64(k ^ cfg.seed) % cell);
+            return true;
+        }
+        k -= cfg.samples;
+        long long c = FOLD_POINTS[k / num_fold_each];
+        (*t) = c - (long long)cfg.fold_width + (long long)(k % num_fold_each);
+        return (*t) >= -PI_MULT_2 && (*t) <= PI_MULT_2;
+    }
+};
+
+/* Quadrant of theta mod 2pi */
+static inline int quadrant(long long theta) {
+    if (theta < 0)
+        theta += PI_MULT_2;
+    if (theta >= PI_MULT_2)
+        theta -= PI_MULT_2;
+    int q = (int)(theta / PI_DIV_2);
+    return q < NUM_QUAD ? q : NUM_QUAD - 1;
+}
+
+static inline void add_err(err_stats_t& s, double err, long long theta) {
+    double a = fabs(err);
+    s.n++;
+    s.sum_abs   += a;
+    s.sum_sq    += (long double)err * err;
+    if (a > s.max_err) {
+        s.max_err   = a;
+        s.max_theta = theta;
+    }
+    long long bin = llround(err);
+    bin = bin < -HIST_HALF ? -HIST_HALF : bin > HIST_HALF ? HIST_HALF : bin;
+    s.hist[bin + HIST_HALF]++;
+}
+
+static void merge_err(err_stats_t& d, const err_stats_t& s) {
+    if (s.max_err > d.max_err) {
+        d.max_err   = s.max_err;
+        d.max_theta = s.max_theta;
+    }
+    d.n         += s.n;
+    d.sum_abs   += s.sum_abs;
+    d.sum_sq    += s.sum_sq;
+    for (int i = 0; i < HIST_BINS; i++)
+        d.hist[i] += s.hist[i];
+}
+
+static void run_unit(const sample_space_t& space, unsigned long long unit, sweep_stats_t& st) {
+    unsigned long long k0 = unit * UNIT_SIZE;
+    unsigned long long k1 = std::min(k0 + UNIT_SIZE, space.total);
+    long long theta[8], x[8], y[8];
+    int n = 0;
+
+    for (unsigned long long k = k0; k <= k1; k++) {
+        if (k < k1 && space.theta(k, &theta[n]))
+            n++;
+        if (n == 8 || (k == k1 && n)) {
+            cordic_sincos_burst(theta, x, y, n);
+            for (int j = 0; j < n; j++) {
+                long double s, c;
+                sincosl(ldexpl((long double)theta[j], -44), &s, &c);
+                int q = quadrant(theta[j]);
+                add_err(st.cos_err[q], (double)((long double)x[j] - ldexpl(c, 46)), theta[j]);
+                add_err(st.sin_err[q], (double)((long double)y[j] - ldexpl(s, 46)), theta[j]);
+            }
+            n = 0;
+        }
+    }
+}
+
+/* Work-stealing pool: every worker owns a range of units and takes from its front; an idle
+   worker steals the back half of the largest remaining range. */
+struct unit_range_t {
+    std::mutex          mtx;
+    unsigned long long  lo, hi;
+};
+
+static bool take_unit(std::vector<unit_range_t>& ranges, size_t self, unsigned long long* unit) {
+    {
+        std::lock_guard<std::mutex> lock(ranges[self].mtx);
+        if (ranges[self].lo < ranges[self].hi) {
+            (*unit) = ranges[self].lo++;
+            return true;
+        }
+    }
+    while (true) {
+        size_t victim = self;
+        unsigned long long best = 0;
+        for (size_t i = 0; i < ranges.size(); i++) {
+            std::lock_guard<std::mutex> lock(ranges[i].mtx);
+            if (ranges[i].hi - ranges[i].lo > best) {
+                best = ranges[i].hi - ranges[i].lo;
+                victim = i;
+            }
+        }
+        if (!best)
+            return false;
+
+        unsigned long long lo, hi;
+        {
+            std::lock_guard<std::mutex> lock(ranges[victim].mtx);
+            if (ranges[victim].lo >= ranges[victim].hi)
+                continue;
+            hi = ranges[victim].hi;
+            lo = ranges[victim].lo + (hi - ranges[victim].lo) / 2;
+            ranges[victim].hi = lo;
+        }
+        if (lo == hi) {
+            // A single unit left at the victim: take it directly
+            std::lock_guard<std::mutex> lock(ranges[victim].mtx);
+            if (ranges[victim].lo < ranges[victim].hi) {
+                ranges[victim].hi = hi;
+                (*unit) = ranges[victim].lo++;
+                return true;
+            }
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(ranges[self].mtx);
+        ranges[self].lo = lo + 1;
+        ranges[self].hi = hi;
+        (*unit) = lo;
+        return true;
+    }
+}
+
+static bool save_checkpoint(const char* path, const sample_space_t& space, const sweep_stats_t& st,
+                            const std::vector<unsigned char>& done) {
+    std::string tmp = std::string(path) + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "wb");
+    if (!f) {
+        perror(tmp.c_str());
+        return false;
+    }
+    checkpoint_hdr_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, CKPT_MAGIC, sizeof(hdr.magic));
+    hdr.version     = 1;
+    hdr.cfg         = space.cfg;
+    hdr.num_units   = space.num_units;
+    bool ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1
+           && fwrite(&st, sizeof(st), 1, f) == 1
+           && fwrite(done.data(), 1, done.size(), f) == done.size();
+    ok = (fclose(f) == 0) && ok;
+    if (!ok || rename(tmp.c_str(), path)) {
+        perror(path);
+        return false;
+    }
+    return true;
+}
+
+/* Returns false if there is no checkpoint; exits if it belongs to a different sweep */
+static bool load_checkpoint(const char* path, const sample_space_t& space, sweep_stats_t& st,
+                            std::vector<unsigned char>& done) {
+    FILE* f = fopen(path, "rb");
+    if (!f)
+        return false;
+    checkpoint_hdr_t hdr;
+    bool ok = fread(&hdr, sizeof(hdr), 1, f) == 1
+           && !memcmp(hdr.magic, CKPT_MAGIC, sizeof(hdr.magic)) && hdr.version == 1
+           && !memcmp(&hdr.cfg, &space.cfg, sizeof(hdr.cfg)) && hdr.num_units == space.num_units
+           && fread(&st, sizeof(st), 1, f) == 1
+           && fread(done.data(), 1, done.size(), f) == done.size();
+    fclose(f);
+    if (!ok) {
+        fprintf(stderr, "%s is not a checkpoint of this sweep (different options?)\n", path);
+        exit(2);
+    }
+    return true;
+}
+
+static void write_err_json(FILE* f, const char* name, const err_stats_t& s, bool last) {
+    fprintf(f, "      \"%s\": {\"n\": %llu, \"max_lsb\": %.3f, \"max_theta\": %lld, "
+               "\"mean_abs_lsb\": %.4f, \"rms_lsb\": %.4f,\n",
+            name, s.n, s.max_err, s.max_theta,
+            s.n ? (double)(s.sum_abs / s.n) : 0.0, s.n ? sqrt((double)(s.sum_sq / s.n)) : 0.0);
+    fprintf(f, "        \"hist_lsb_min\": %d, \"hist\": [", -HIST_HALF);
+    for (int i = 0; i < HIST_BINS; i++)
+        fprintf(f, "%llu%s", s.hist[i], (i + 1 < HIST_BINS) ? ", " : "");
+    fprintf(f, "]}%s\n", last ? "" : ",");
+}
+
+static void write_report(FILE* f, const sample_space_t& space, const sweep_stats_t& st, bool complete) {
+    static const char* QUAD_NAMES[NUM_QUAD] = { "[0, pi/2)", "[pi/2, pi)", "[pi, 3pi/2)", "[3pi/2, 2pi)" };
+    fprintf(f, "{\n");
+    fprintf(f, "  \"samples\": %llu,\n", space.cfg.samples);
+    fprintf(f, "  \"fold_width\": %llu,\n", space.cfg.fold_width);
+    fprintf(f, "  \"seed\": %llu,\n", space.cfg.seed);
+    fprintf(f, "  \"complete\": %s,\n", complete ? "true" : "false");
+    fprintf(f, "  \"error_unit\": \"2^-46\",\n");
+    fprintf(f, "  \"quadrants\": [\n");
+    for (int q = 0; q < NUM_QUAD; q++) {
+        fprintf(f, "    {\"quadrant\": \"%s\",\n", QUAD_NAMES[q]);
+        write_err_json(f, "cos", st.cos_err[q], false);
+        write_err_json(f, "sin", st.sin_err[q], true);
+        fprintf(f, "    }%s\n", (q + 1 < NUM_QUAD) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+    sweep_cfg_t cfg = { 1ULL << 30, 1ULL << 16, 1 };
+    int num_threads = std::max(1u, std::thread::hardware_concurrency());
+    const char* ckpt_path = NULL;
+    const char* out_path = NULL;
+    double ckpt_sec = 60.0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--samples") && i + 1 < argc)
+            cfg.samples = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--fold-width") && i + 1 < argc)
+            cfg.fold_width = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            cfg.seed = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+            num_threads = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--checkpoint") && i + 1 < argc)
+            ckpt_path = argv[++i];
+        else if (!strcmp(argv[i], "--checkpoint-sec") && i + 1 < argc)
+            ckpt_sec = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--out") && i + 1 < argc)
+            out_path = argv[++i];
+        else {
+            fprintf(stderr, "Usage: %s [--samples N] [--fold-width W] [--seed S] [--threads T]\n"
+                            "          [--checkpoint FILE] [--checkpoint-sec SEC] [--out report.json]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    sample_space_t space(cfg);
+    sweep_stats_t stats;
+    memset(&stats, 0, sizeof(stats));
+    std::vector<unsigned char> done(space.num_units, 0);
+    if (ckpt_path && load_checkpoint(ckpt_path, space, stats, done))
+        fprintf(stderr, "Resuming from %s\n", ckpt_path);
+
+    std::vector<unsigned long long> todo;
+    for (unsigned long long u = 0; u < space.num_units; u++)
+        if (!done[u])
+            todo.push_back(u);
+    fprintf(stderr, "%llu thetas in %llu units, %zu to go on %d threads\n",
+            space.total, space.num_units, todo.size(), num_threads);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    // Workers own index ranges into todo
+    std::vector<unit_range_t> ranges(num_threads);
+    for (int t = 0; t < num_threads; t++) {
+        ranges[t].lo = todo.size() * t / num_threads;
+        ranges[t].hi = todo.size() * (t + 1) / num_threads;
+    }
+
+    std::mutex stats_mtx;
+    std::atomic<unsigned long long> units_done(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < num_threads; t++) {
+        workers.emplace_back([&, t] {
+            unsigned long long idx;
+            while (!g_stop && take_unit(ranges, t, &idx)) {
+                sweep_stats_t* local = new sweep_stats_t();
+                run_unit(space, todo[idx], *local);
+                {
+                    std::lock_guard<std::mutex> lock(stats_mtx);
+                    for (int q = 0; q < NUM_QUAD; q++) {
+                        merge_err(stats.cos_err[q], local->cos_err[q]);
+                        merge_err(stats.sin_err[q], local->sin_err[q]);
+                    }
+                    done[todo[idx]] = 1;
+                }
+                delete local;
+                units_done++;
+            }
+        });
+    }
+
+    // Progress and periodic checkpoints
+    typedef std::chrono::steady_clock clk;
+    clk::time_point t_start = clk::now(), t_ckpt = t_start;
+    while (units_done < todo.size() && !g_stop) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        double secs = std::chrono::duration<double>(clk::now() - t_start).count();
+        fprintf(stderr, "\r%llu/%zu units, %.1f M thetas/s   ", units_done.load(), todo.size(),
+                units_done * (double)UNIT_SIZE / secs / 1e6);
+        if (ckpt_path && std::chrono::duration<double>(clk::now() - t_ckpt).count() >= ckpt_sec) {
+            std::lock_guard<std::mutex> lock(stats_mtx);
+            save_checkpoint(ckpt_path, space, stats, done);
+            t_ckpt = clk::now();
+        }
+    }
+    for (std::thread& w : workers)
+        w.join();
+    fprintf(stderr, "\n");
+
+    bool complete = (units_done == todo.size());
+    if (ckpt_path)
+        save_checkpoint(ckpt_path, space, stats, done);
+    if (!complete)
+        fprintf(stderr, "Interrupted; rerun the same command to resume from %s\n",
+                ckpt_path ? ckpt_path : "the start (no --checkpoint given)");
+
+    FILE* f = out_path ? fopen(out_path, "w") : stdout;
+    if (!f) {
+        perror(out_path);
+        return 1;
+    }
+    write_report(f, space, stats, complete);
+    if (out_path)
+        fclose(f);
+    return complete ? 0 : 3;
+}
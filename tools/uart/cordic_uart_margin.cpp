@@ -0,0 +1,369 @@
+//
+// File:        cordic_uart_margin.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Bit-level line model of the UART link, for the baud rate error margin of uart_rx and
+//              the edge placement of uart_tx at each baud rate and oversampling factor.
+//
+//              The receiver is a cycle-accurate copy of uart_rx.sv (3-flop synchronizer, start edge
+//              detect, fractional sample tick, 3-sample majority vote, odd parity, stop bit check,
+//              where a framing error drops the message in uart_rx_msg). The far-end
+//              transmitter sends back-to-back random bytes with a rate error of --skew-ppm and
+//              independent uniform jitter of +/- --jitter-ns on every bit edge, sampled at a random
+//              phase of i_clk. Every --stop-every'th byte has a low stop bit, after a parity bit of
+//              0 and 1 in turn, followed by one idle bit as the testbench's uart_if sends it; each
+//              must give exactly one framing error and no extra byte. For each (baud, oversample)
+//              pair the tool bisects the largest rate error of either sign at which no byte is
+//              lost or corrupted and no framing error is missed or spurious. Two ends within +/-1%
+//              of nominal need a margin of at least 2%.
+//
+//              For comparison it also prints the rate error of the old integer dividers (RX ticks
+//              every int(CLK/(BAUD*16)) cycles, TX bits every int(CLK/BAUD) cycles, both rounded),
+//              and the largest distance of a uart_tx.sv bit edge from its ideal time, in % of a bit.
+//
+//              Build (from tools/uart):
+//                  g++ -std=c++14 -O2 -pthread cordic_uart_margin.cpp -o cordic_uart_margin
+//              Run:    ./cordic_uart_margin [--clk 100000000] [--baud 3000000,6000000,8000000,12000000]
+//                                           [--oversample 4,8,16] [--bytes 2000] [--jitter-ns 0]
+//                                           [--stop-every 8] [--seed S] [--threads T]
+//                      ./cordic_uart_margin --skew-ppm P [...]     (bytes in error at one rate error)
+//
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+static const int    PACKET_BITS     = 11;       // start, 8 data, odd parity, stop
+static const int    ACC_BITS        = 32;       // uart_rx SAMPLE_ACC_BITS, uart_tx BIT_ACC_BITS
+static const int    IDLE_BITS       = 4;        // line idle before the first start bit and after the last stop bit
+static const int    LEGACY_OS       = 16;       // oversampling of the old uart_rx
+static const double MAX_SKEW_PPM    = 100000;   // bisection range: +/-10%
+static const double SKEW_STEP_PPM   = 100;      // bisection resolution
+
+struct margin_cfg_t {
+    double              clk         = 100e6;
+    std::vector<double> bauds       = { 3e6, 6e6, 8e6, 12e6 };
+    std::vector<int>    oversample  = { 4, 8, 16 };
+    int                 bytes       = 2000;
+    double              jitter_ns   = 0;
+    int                 stop_every  = 8;        // every Nth byte with a low stop bit, 0 none
+    unsigned            seed        = 1;
+    int                 threads     = 0;
+    bool                fixed_skew  = false;
+    double              skew_ppm    = 0;
+};
+
+struct margin_result_t {
+    double  baud;
+    int     os;
+    double  neg_ppm;        // most negative tolerated rate error (far end slow), -1 if none
+    double  pos_ppm;        // most positive tolerated rate error (far end fast), -1 if none
+    int     errors;         // --skew-ppm: bytes lost or corrupted, framing errors missed or spurious
+};
+
+static int usage(const char* prog) {
+    fprintf(stderr, "Usage: %s [--clk HZ] [--baud B[,B...]] [--oversample N[,N...]] [--bytes N]\n"
+                    "          [--jitter-ns J] [--skew-ppm P] [--stop-every N] [--seed S] [--threads T]\n", prog);
+    return 2;
+}
+
+/* Parity bit that makes the number of ones odd (uart_tx/uart_rx PARITY_EO = 1) */
+static int odd_parity_bit(unsigned byte) {
+    return !__builtin_parity(byte);
+}
+
+/* uart_rx.sv, one i_clk edge at a time. Register names follow the RTL; every next value is
+   computed from the current ones, as with nonblocking assignments. */
+struct uart_rx_model {
+    enum state_t { RX_IDLE, RX_START, RX_DATA, RX_PARITY, RX_STOP };
+
+    unsigned long long  inc;
+    int                 os, mid;
+
+    unsigned            rx_sync         = 7;    // line idle since long before the first byte
+    bool                rx_d            = true;
+    unsigned long long  sample_acc      = 0;
+    int                 oversamp_cnt    = 0;
+    unsigned            votes           = 0;
+    int                 idx             = 0;
+    unsigned            rx_byte         = 0;
+    bool                rx_byte_valid   = false;
+    bool                rx_err          = false;
+    state_t             state           = RX_IDLE;
+
+    uart_rx_model(double clk, double baud, int oversample)
+        : inc((unsigned long long)(baud * oversample * ldexp(1.0, ACC_BITS) / clk)),
+          os(oversample), mid(oversample / 2) {}
+
+    void clock(int i_rx) {
+        int  rx          = rx_sync >> 2 & 1;
+        bool sample_tick = sample_acc >> ACC_BITS & 1;
+        int  v1 = votes >> 1 & 1, v0 = votes & 1;
+        int  bit_val     = (v1 & v0) | (v1 & rx) | (v0 & rx);
+        bool bit_done    = sample_tick && oversamp_cnt == mid;
+        bool start_edge  = rx_d && !rx;
+        bool stop_window = oversamp_cnt == mid && v0;    // last sample period of the stop bit, seen high
+
+        rx_sync         = (rx_sync << 1 | i_rx) & 7;
+        rx_d            = rx;
+        rx_err          = false;
+        rx_byte_valid   = false;
+
+        sample_acc      = (sample_acc & ((1ull << ACC_BITS) - 1)) + inc;
+        if (sample_tick) {
+            votes        = (votes << 1 | rx) & 3;
+            oversamp_cnt = oversamp_cnt == os - 1 ? 0 : oversamp_cnt + 1;
+        }
+
+        switch (state) {
+        case RX_IDLE:
+            if (start_edge) {
+                sample_acc   = 2 * inc;
+                oversamp_cnt = 0;
+                state        = RX_START;
+            }
+            break;
+        case RX_START:
+            if (bit_done)
+                state = bit_val ? RX_IDLE : RX_DATA;
+            break;
+        case RX_DATA:
+            if (bit_done) {
+                rx_byte = (bit_val << 7) | (rx_byte >> 1);
+                if (++idx == 8) {
+                    idx   = 0;
+                    state = RX_PARITY;
+                }
+            }
+            break;
+        case RX_PARITY:
+            if (bit_done) {
+                state           = RX_STOP;
+                rx_byte_valid   = odd_parity_bit(rx_byte) == bit_val;
+                rx_err          = !rx_byte_valid;
+            }
+            break;
+        case RX_STOP:
+            if (start_edge && stop_window) {
+                sample_acc   = 2 * inc;
+                oversamp_cnt = 0;
+                state        = RX_START;
+            } else if (bit_done) {
+                state  = RX_IDLE;
+                rx_err = !bit_val;
+            }
+            break;
+        }
+    }
+};
+
+/* Sends bytes from a transmitter skew_ppm fast (negative: slow) with edge jitter into uart_rx and
+   returns the number of bytes lost or corrupted plus the framing errors missed or spurious. The
+   same seed gives the same bytes, jitter and clock phase at every skew, so the error count is
+   monotonic enough to bisect. */
+static int run_line(const margin_cfg_t& cfg, double baud, int os, double skew_ppm, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<unsigned> sent(cfg.bytes);
+    for (auto& b : sent)
+        b = rng() & 0xff;
+
+    // Line levels, one per bit time: idle, frames, idle. A low stop bit goes on every stop_every'th
+    // byte, whose bit 0 is flipped where needed for a parity bit of 0 and 1 in turn.
+    std::vector<char> bits(IDLE_BITS, 1);
+    int stop_errs = 0;
+    for (size_t j = 0; j < sent.size(); j++) {
+        bool low_stop = cfg.stop_every && j % cfg.stop_every == (size_t)cfg.stop_every - 1;
+        if (low_stop && odd_parity_bit(sent[j]) != (stop_errs & 1))
+            sent[j] ^= 1;
+        bits.push_back(0);
+        for (int i = 0; i < 8; i++)
+            bits.push_back(sent[j] >> i & 1);
+        bits.push_back(odd_parity_bit(sent[j]));
+        bits.push_back(!low_stop);
+        if (low_stop) {
+            bits.push_back(1);
+            stop_errs++;
+        }
+    }
+    bits.insert(bits.end(), IDLE_BITS, 1);
+
+    // Bit k starts at k*T plus its jitter, in i_clk cycles from a random phase
+    double bit_cycles = cfg.clk / (baud * (1 + skew_ppm * 1e-6));
+    double jitter     = cfg.jitter_ns * 1e-9 * cfg.clk;
+    std::uniform_real_distribution<double> uni(-1.0, 1.0);
+    double phase      = (uni(rng) + 1) / 2;
+    std::vector<double> edge(bits.size() + 1);
+    for (size_t k = 0; k <= bits.size(); k++)
+        edge[k] = k * bit_cycles + (k ? jitter * uni(rng) : 0) - phase;
+
+    uart_rx_model rx(cfg.clk, baud, os);
+    std::vector<unsigned> got;
+    got.reserve(sent.size());
+    int framing = 0;
+    size_t k = 0;
+    for (long long n = 0; k < bits.size(); n++) {
+        while (k < bits.size() && edge[k + 1] <= n)
+            k++;
+        rx.clock(k < bits.size() ? bits[k] : 1);
+        if (rx.rx_byte_valid)
+            got.push_back(rx.rx_byte);
+        framing += rx.rx_err && rx.state == uart_rx_model::RX_IDLE;
+    }
+    for (int n = 0; n < 4 * PACKET_BITS * (int)ceil(bit_cycles); n++) {
+        rx.clock(1);
+        if (rx.rx_byte_valid)
+            got.push_back(rx.rx_byte);
+        framing += rx.rx_err && rx.state == uart_rx_model::RX_IDLE;
+    }
+
+    int errors = abs(framing - stop_errs) + abs((int)got.size() - (int)sent.size());
+    for (size_t i = 0; i < std::min(got.size(), sent.size()); i++)
+        errors += got[i] != sent[i];
+    return errors;
+}
+
+/* Largest |skew| with the given sign and no byte in error, to SKEW_STEP_PPM; -1 if even 0 fails */
+static double bisect(const margin_cfg_t& cfg, double baud, int os, int sign, unsigned seed) {
+    if (run_line(cfg, baud, os, 0, seed))
+        return -1;
+    double lo = 0, hi = MAX_SKEW_PPM;
+    if (!run_line(cfg, baud, os, sign * hi, seed))
+        return hi;
+    while (hi - lo > SKEW_STEP_PPM) {
+        double mid = (lo + hi) / 2;
+        if (run_line(cfg, baud, os, sign * mid, seed))
+            hi = mid;
+        else
+            lo = mid;
+    }
+    return lo;
+}
+
+/* Largest distance of a uart_tx.sv bit edge from ideal, in cycles. The accumulator restarts at
+   1.5*BIT_INC with the start bit, so edge n of a byte is k cycles after its start edge, k the first
+   with k*BIT_INC + BIT_INC/2 >= n*2^32. */
+static double tx_edge_error(double clk, double baud) {
+    unsigned long long inc = (unsigned long long)(baud * ldexp(1.0, ACC_BITS) / clk);
+    double err = 0;
+    for (int n = 1; n < PACKET_BITS; n++) {
+        unsigned long long target = ((unsigned long long)n << ACC_BITS) - inc / 2;
+        unsigned long long k = target / inc;
+        k += k * inc < target;
+        err = std::max(err, fabs(k - n * clk / baud));
+    }
+    return err;
+}
+
+int main(int argc, char** argv) {
+    margin_cfg_t cfg;
+    auto parse_list = [](const char* s, auto& out) {
+        out.clear();
+        for (char* end; *s; s = *end ? end + 1 : end) {
+            out.push_back(strtod(s, &end));
+            if (end == s)
+                return false;
+        }
+        return !out.empty();
+    };
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--clk") && i + 1 < argc)
+            cfg.clk = strtod(argv[++i], NULL);
+        else if (!strcmp(argv[i], "--baud") && i + 1 < argc) {
+            if (!parse_list(argv[++i], cfg.bauds))
+                return usage(argv[0]);
+        } else if (!strcmp(argv[i], "--oversample") && i + 1 < argc) {
+            if (!parse_list(argv[++i], cfg.oversample))
+                return usage(argv[0]);
+        } else if (!strcmp(argv[i], "--bytes") && i + 1 < argc)
+            cfg.bytes = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--jitter-ns") && i + 1 < argc)
+            cfg.jitter_ns = strtod(argv[++i], NULL);
+        else if (!strcmp(argv[i], "--stop-every") && i + 1 < argc)
+            cfg.stop_every = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--skew-ppm") && i + 1 < argc) {
+            cfg.fixed_skew = true;
+            cfg.skew_ppm   = strtod(argv[++i], NULL);
+        } else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            cfg.seed = strtoul(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+            cfg.threads = atoi(argv[++i]);
+        else
+            return usage(argv[0]);
+    }
+    if (cfg.clk <= 0 || cfg.bytes <= 0 || cfg.jitter_ns < 0 || cfg.stop_every < 0)
+        return usage(argv[0]);
+    for (int os : cfg.oversample)
+        if (os != 4 && os != 8 && os != 16) {
+            fprintf(stderr, "oversample must be 4, 8 or 16\n");
+            return 2;
+        }
+    if (cfg.threads <= 0)
+        cfg.threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Every pair uart_rx supports: at least one clock per sample
+    std::vector<margin_result_t> results;
+    for (double baud : cfg.bauds)
+        for (int os : cfg.oversample)
+            if (baud > 0 && baud * os <= cfg.clk)
+                results.push_back({ baud, os, 0, 0, 0 });
+    if (results.empty()) {
+        fprintf(stderr, "no baud rate and oversample pair with BAUD*OVERSAMPLE <= CLK\n");
+        return 2;
+    }
+
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < std::min<int>(cfg.threads, results.size()); t++)
+        pool.emplace_back([&]() {
+            for (size_t i; (i = next++) < results.size();) {
+                margin_result_t& r = results[i];
+                unsigned seed = cfg.seed * 1000003u + (unsigned)i;
+                if (cfg.fixed_skew) {
+                    r.errors = run_line(cfg, r.baud, r.os, cfg.skew_ppm, seed);
+                } else {
+                    r.neg_ppm = bisect(cfg, r.baud, r.os, -1, seed);
+                    r.pos_ppm = bisect(cfg, r.baud, r.os, +1, seed);
+                }
+            }
+        });
+    for (auto& t : pool)
+        t.join();
+
+    printf("clk %.0f Hz, %d bytes per run, jitter +/-%.1f ns, ", cfg.clk, cfg.bytes, cfg.jitter_ns);
+    if (cfg.stop_every)
+        printf("low stop bit on 1 byte in %d\n\n", cfg.stop_every);
+    else
+        printf("no low stop bits\n\n");
+    printf("%10s %4s  %9s  %s\n", "baud", "os", "cyc/smpl",
+           cfg.fixed_skew ? "bytes in error" : "rx margin (far end slow .. fast)");
+    for (const margin_result_t& r : results) {
+        printf("%10.0f %4d  %9.3f  ", r.baud, r.os, cfg.clk / (r.baud * r.os));
+        if (cfg.fixed_skew)
+            printf("%d at %+.0f ppm\n", r.errors, cfg.skew_ppm);
+        else if (r.neg_ppm < 0 || r.pos_ppm < 0)
+            printf("fails at 0 ppm\n");
+        else
+            printf("-%.2f%% .. +%.2f%%%s\n", r.neg_ppm * 1e-4, r.pos_ppm * 1e-4,
+                   std::min(r.neg_ppm, r.pos_ppm) < 20000 ? "  (< 2%)" : "");
+    }
+
+    printf("\n%10s  %16s  %16s  %16s\n", "baud", "old rx rate err", "old tx rate err", "tx edge err");
+    for (double baud : cfg.bauds) {
+        if (baud <= 0)
+            continue;
+        double bit_cycles = cfg.clk / baud;
+        long   rx_div = lround(cfg.clk / (baud * LEGACY_OS)), tx_div = lround(bit_cycles);
+        char   rx_err[32] = "no divider";
+        if (rx_div > 0)
+            snprintf(rx_err, sizeof(rx_err), "%+.2f%%", (bit_cycles / (rx_div * LEGACY_OS) - 1) * 100);
+        printf("%10.0f  %16s  %+15.2f%%  %14.2f%%\n", baud, rx_err, (bit_cycles / tx_div - 1) * 100,
+               tx_edge_error(cfg.clk, baud) / bit_cycles * 100);
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+//
+// File:        cordic_vecgen.cpp
+// Author:      agent
+// Date:        10/2026
+// Description: Generates, checks and dumps golden vector files (cordic_vec.h). Generated files
+//              start with directed thetas (0, the preprocessing fold points and their neighbours,
+//              +/-2pi), followed by uniformly random thetas over [-2pi, 2pi] from --seed. With
+//              --seed-bits the responses are those of the hybrid pipeline (top_module
+//              CORDIC_SEED_BITS), which the testbench only accepts with the same cordic_seed_bits.
+//
+//              Build (from tools/vecgen):
+//                  g++ -std=c++14 -O2 -DCORDIC_GREF_STANDALONE -I../../testbench/uvm_tb_hvl/subscriber
+//                      cordic_vecgen.cpp ../../testbench/uvm_tb_hvl/subscriber/cordic_vec.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_gref.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_sincos_simd.cpp
+//                      ../../testbench/uvm_tb_hvl/subscriber/cordic_crc8.cpp -o cordic_vecgen
+//              Run:    ./cordic_vecgen gen vectors.bin [--count N] [--seed S] [--seed-bits B]
+//                      ./cordic_vecgen check vectors.bin
+//                      ./cordic_vecgen dump vectors.bin [first] [count]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+#include "cordic_gref_const.h"
+#include "cordic_vec.h"
+
+static std::vector<long long> directed_thetas() {
+    const long long points[] = { 0, PI_DIV_2, PI, PI_MULT_3_DIV_2, PI_MULT_2 };
+    std::vector<long long> theta;
+    for (long long p : points)
+        for (int sign = p ? -1 : 1; sign <= 1; sign += 2)
+            for (long long d = -1; d <= 1; d++)
+                if (sign*p + d >= -PI_MULT_2 && sign*p + d <= PI_MULT_2)
+                    theta.push_back(sign*p + d);
+    return theta;
+}
+
+static int gen(const char* path, long long count, unsigned long long seed, int seed_bits) {
+    cordic_vec_writer_t* w = cordic_vec_create(path, seed, seed_bits);
+    if (!w) {
+        perror(path);
+        return 1;
+    }
+
+    std::vector<long long> theta = directed_thetas();
+    if ((long long)theta.size() > count)
+        theta.resize(count);
+    int rc = cordic_vec_append(w, theta.data(), theta.size());
+
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<long long> dist(-PI_MULT_2, PI_MULT_2);
+    const size_t chunk = 1 << 16;
+    for (long long left = count - (long long)theta.size(); !rc && left > 0; left -= chunk) {
+        theta.resize(left < (long long)chunk ? left : chunk);
+        for (long long& t : theta)
+            t = dist(rng);
+        rc = cordic_vec_append(w, theta.data(), theta.size());
+    }
+
+    if (cordic_vec_close_writer(w) || rc) {
+        perror(path);
+        return 1;
+    }
+    fprintf(stderr, "%s: %lld vectors\n", path, count);
+    return 0;
+}
+
+static int check(const char* path) {
+    cordic_vec_t* v = cordic_vec_open(path);
+    if (!v)
+        return 1;
+    long long bad = 0;
+    for (long long i = 0; i < cordic_vec_count(v); i++) {
+        const cordic_vec_rec_t* rec = cordic_vec_get(v, i);
+        cordic_vec_rec_t ref;
+        cordic_vec_make_rec(rec->theta, cordic_vec_seed_bits(v), &ref);
+        if (memcmp(rec, &ref, sizeof(ref))) {
+            if (bad++ < 10)
+                fprintf(stderr, "record %lld (theta 0x%012llx) does not match the model\n",
+                        i, rec->theta & 0xffffffffffffLL);
+        }
+    }
+    printf("%s: %lld vectors (seed_bits %d), %lld mismatches\n", path, cordic_vec_count(v),
+           cordic_vec_seed_bits(v), bad);
+    cordic_vec_close(v);
+    return bad ? 1 : 0;
+}
+
+static int dump(const char* path, long long first, long long count) {
+    cordic_vec_t* v = cordic_vec_open(path);
+    if (!v)
+        return 1;
+    for (long long i = first; i < first + count && i < cordic_vec_count(v); i++) {
+        const cordic_vec_rec_t* rec = cordic_vec_get(v, i);
+        printf("%lld theta 0x%012llx cos 0x%012llx sin 0x%012llx rx", i, rec->theta & 0xffffffffffffLL,
+               rec->cos_theta & 0xffffffffffffLL, rec->sin_theta & 0xffffffffffffLL);
+        for (unsigned char b : rec->request)
+            printf(" %02x", b);
+        printf(" tx");
+        for (unsigned char b : rec->response)
+            printf(" %02x", b);
+        printf("\n");
+    }
+    cordic_vec_close(v);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && !strcmp(argv[1], "gen")) {
+        long long count = 1 << 20;
+        unsigned long long seed = 1;
+        int seed_bits = 0;
+        for (int i = 3; i < argc; i++) {
+            if (!strcmp(argv[i], "--count") && i + 1 < argc)
+                count = atoll(argv[++i]);
+            else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+                seed = strtoull(argv[++i], NULL, 0);
+            else if (!strcmp(argv[i], "--seed-bits") && i + 1 < argc)
+                seed_bits = atoi(argv[++i]);
+            else
+                goto usage;
+        }
+        if (seed_bits < 0 || seed_bits > 44)
+            goto usage;
+        return gen(argv[2], count < 0 ? 0 : count, seed, seed_bits);
+    }
+    if (argc == 3 && !strcmp(argv[1], "check"))
+        return check(argv[2]);
+    if (argc >= 3 && argc <= 5 && !strcmp(argv[1], "dump"))
+        return dump(argv[2], argc > 3 ? atoll(argv[3]) : 0, argc > 4 ? atoll(argv[4]) : 16);
+
+usage:
+    fprintf(stderr, "Usage: %s gen FILE [--count N] [--seed S] [--seed-bits 0..44]\n"
+                    "       %s check FILE\n"
+                    "       %s dump FILE [first] [count]\n", argv[0], argv[0], argv[0]);
+    return 2;
+}